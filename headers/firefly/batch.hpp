@@ -0,0 +1,210 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "firefly/vector.hpp"
+
+namespace firefly {
+
+/**
+ * @class vector_batch
+ * @brief A growable batch of vectors of the same length, stored as a structure of arrays.
+ *
+ * Element `d` of every vector is stored contiguously in component `d`, so a kernel that walks the batch applies the
+ * same operation to consecutive memory in each component and vectorises across vectors rather than within one. Use
+ * it for large collections of short vectors, where a `std::vector<vector<T, Length>>` leaves most SIMD lanes idle.
+ *
+ * @tparam T The type of the elements.
+ * @tparam Length The number of elements of every vector.
+ */
+template <vector_type T, std::size_t Length>
+  requires(Length > 0)
+class vector_batch {
+public:
+  using value_type = vector<T, Length>;
+
+  /// @brief The number of elements of every vector.
+  static constexpr std::size_t length = Length;
+
+  /**
+   * @brief Default constructor that creates an empty batch.
+   */
+  vector_batch() = default;
+
+  /**
+   * @brief Constructor that creates a batch of zero vectors.
+   *
+   * @param size The number of vectors.
+   */
+  explicit vector_batch(std::size_t const size) {
+    resize(size);
+  }
+
+  /**
+   * @brief Constructor that copies vectors from a range.
+   *
+   * @tparam Vectors A sized range of `vector<T, Length>`.
+   * @param vectors The vectors to copy, in order.
+   */
+  template <std::ranges::sized_range Vectors>
+    requires std::is_same_v<std::ranges::range_value_t<Vectors>, value_type>
+  explicit vector_batch(Vectors const &vectors) {
+    reserve(std::ranges::size(vectors));
+    for (auto const &v : vectors) {
+      push_back(v);
+    }
+  }
+
+  /**
+   * @brief Returns the number of vectors.
+   */
+  [[nodiscard]] std::size_t size() const {
+    return _components[0].size();
+  }
+
+  /**
+   * @brief Checks whether the batch is empty.
+   */
+  [[nodiscard]] bool empty() const {
+    return size() == 0;
+  }
+
+  /**
+   * @brief Reserves storage for a number of vectors.
+   *
+   * @param capacity The expected number of vectors.
+   */
+  void reserve(std::size_t const capacity) {
+    for (auto &component : _components) {
+      component.reserve(capacity);
+    }
+  }
+
+  /**
+   * @brief Changes the number of vectors. New vectors are zero.
+   *
+   * @param size The new number of vectors.
+   */
+  void resize(std::size_t const size) {
+    for (auto &component : _components) {
+      component.resize(size, T{});
+    }
+  }
+
+  /**
+   * @brief Removes every vector.
+   */
+  void clear() {
+    for (auto &component : _components) {
+      component.clear();
+    }
+  }
+
+  /**
+   * @brief Appends a vector.
+   *
+   * @param v The vector to append.
+   */
+  void push_back(value_type const &v) {
+    for (std::size_t d = 0; d < Length; ++d) {
+      _components[d].push_back(v[d]);
+    }
+  }
+
+  /**
+   * @brief Gathers a vector out of the batch.
+   *
+   * @param index The position of the vector.
+   * @throw std::out_of_range if the position is not less than size().
+   * @return A copy of the vector.
+   */
+  [[nodiscard]] value_type get(std::size_t const index) const {
+    check_index(index);
+    value_type result;
+    for (std::size_t d = 0; d < Length; ++d) {
+      result[d] = _components[d][index];
+    }
+    return result;
+  }
+
+  /**
+   * @brief Scatters a vector into the batch.
+   *
+   * @param index The position of the vector.
+   * @param v The new value of the vector.
+   * @throw std::out_of_range if the position is not less than size().
+   */
+  void set(std::size_t const index, value_type const &v) {
+    check_index(index);
+    for (std::size_t d = 0; d < Length; ++d) {
+      _components[d][index] = v[d];
+    }
+  }
+
+  /**
+   * @brief Returns element `d` of every vector as one contiguous span.
+   *
+   * @param d The element number.
+   * @throw std::out_of_range if the element number is not less than Length.
+   * @return A span of size() elements.
+   */
+  [[nodiscard]] std::span<T> component(std::size_t const d) {
+    check_component(d);
+    return _components[d];
+  }
+
+  /**
+   * @brief Returns element `d` of every vector as one contiguous span.
+   *
+   * @param d The element number.
+   * @throw std::out_of_range if the element number is not less than Length.
+   * @return A span of size() elements.
+   */
+  [[nodiscard]] std::span<T const> component(std::size_t const d) const {
+    check_component(d);
+    return _components[d];
+  }
+
+  /**
+   * @brief Copies the batch into an array of vectors.
+   *
+   * @return The vectors in order.
+   */
+  [[nodiscard]] std::vector<value_type> to_vectors() const {
+    std::vector<value_type> result(size());
+    for (std::size_t d = 0; d < Length; ++d) {
+      for (std::size_t i = 0; i < result.size(); ++i) {
+        result[i][d] = _components[d][i];
+      }
+    }
+    return result;
+  }
+
+  /**
+   * @brief Compares two batches element-wise.
+   */
+  [[nodiscard]] bool operator==(vector_batch const &other) const = default;
+
+private:
+  std::array<std::vector<T>, Length> _components;
+
+  void check_index(std::size_t const index) const {
+    if (index >= size()) {
+      throw std::out_of_range("Index exceeds vector batch size");
+    }
+  }
+
+  static void check_component(std::size_t const d) {
+    if (d >= Length) {
+      throw std::out_of_range("Component exceeds vector Length");
+    }
+  }
+};
+
+} // namespace firefly
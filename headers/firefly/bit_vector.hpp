@@ -0,0 +1,344 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <ostream>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "firefly/detail/kernels.hpp"
+#include "firefly/vector.hpp"
+
+namespace firefly {
+
+/**
+ * @class bit_vector
+ * @brief Packed binary vector of a fixed number of bits, stored in 64-bit words.
+ *
+ * Intended for binary signatures such as sign-binarised embeddings. Set operations and Hamming distances work a word
+ * at a time with `std::popcount`; the word loops are plain indexed loops, which GCC and Clang vectorise with
+ * `vpopcntq` when AVX-512 VPOPCNTDQ is enabled and with the nibble lookup (`vpshufb`) sequence on AVX2. Bits past
+ * `Bits` in the last word are always zero.
+ *
+ * @tparam Bits The number of bits.
+ */
+template <std::size_t Bits>
+class bit_vector {
+public:
+  using word_type = std::uint64_t;
+
+  /// @brief The number of bits in a word.
+  static constexpr std::size_t word_bits = 64;
+
+  /// @brief The number of words used to store the bits.
+  static constexpr std::size_t word_count = (Bits + word_bits - 1) / word_bits;
+
+  /**
+   * @brief Default constructor that clears every bit.
+   */
+  [[nodiscard]] constexpr bit_vector() = default;
+
+  /**
+   * @brief Constructor that initializes the leading bits from an initializer list.
+   *
+   * @param list The values of the leading bits. The remaining bits are cleared.
+   * @throw std::out_of_range if the initializer list is longer than the number of bits.
+   */
+  [[nodiscard]] constexpr bit_vector(std::initializer_list<bool> const &list) {
+    if (list.size() > Bits) {
+      throw std::out_of_range("Initializer list size must match bit_vector Bits");
+    }
+    std::size_t i = 0;
+    for (bool const bit : list) {
+      set(i++, bit);
+    }
+  }
+
+  /**
+   * @brief Sign-binarises a vector: bit `i` is set when `v[i] > threshold`.
+   *
+   * @tparam T The element type of the vector, arithmetic.
+   * @param v The vector to binarise.
+   * @param threshold The value that elements must exceed to set their bit.
+   * @return The binary signature of the vector.
+   */
+  template <typename T>
+    requires std::is_arithmetic_v<T>
+  [[nodiscard]] static constexpr bit_vector from_signs(vector<T, Bits> const &v, T const threshold = T(0)) {
+    bit_vector result;
+    for (std::size_t word = 0; word < word_count; ++word) {
+      std::size_t const begin = word * word_bits;
+      std::size_t const end = std::min(Bits, begin + word_bits);
+      word_type bits = 0;
+      for (std::size_t i = begin; i < end; ++i) {
+        bits |= word_type(v[i] > threshold) << (i - begin);
+      }
+      result._words[word] = bits;
+    }
+    return result;
+  }
+
+  /**
+   * @brief Returns the number of bits.
+   */
+  [[nodiscard]] static constexpr std::size_t size() {
+    return Bits;
+  }
+
+  /**
+   * @brief Returns the packed words, least significant bit first.
+   */
+  [[nodiscard]] constexpr std::span<word_type const, word_count> words() const {
+    return _words;
+  }
+
+  /**
+   * @brief Reads a bit.
+   *
+   * @param index The position of the bit.
+   * @throw std::out_of_range if the position is not less than Bits.
+   * @return The value of the bit.
+   */
+  [[nodiscard]] constexpr bool test(std::size_t const index) const {
+    check_index(index);
+    return (_words[index / word_bits] >> (index % word_bits)) & 1u;
+  }
+
+  /**
+   * @brief Writes a bit.
+   *
+   * @param index The position of the bit.
+   * @param value The new value of the bit.
+   * @throw std::out_of_range if the position is not less than Bits.
+   */
+  constexpr void set(std::size_t const index, bool const value = true) {
+    check_index(index);
+    word_type const bit = word_type(1) << (index % word_bits);
+    auto &word = _words[index / word_bits];
+    word = value ? (word | bit) : (word & ~bit);
+  }
+
+  /**
+   * @brief Counts the set bits.
+   *
+   * @return The number of set bits.
+   */
+  [[nodiscard]] constexpr std::size_t popcount() const {
+    return detail::reduce_n(
+        _words.data(), word_count, std::size_t(0), [](word_type word) { return std::popcount(word); }, std::plus<>());
+  }
+
+  /**
+   * @brief Computes the Hamming distance, the number of positions at which the bits differ.
+   *
+   * @param other The vector to compare with.
+   * @return The number of differing bits.
+   */
+  [[nodiscard]] constexpr std::size_t hamming(bit_vector const &other) const {
+    std::size_t acc[detail::reduction_lanes] = {0, 0, 0, 0};
+    std::size_t word = 0;
+    for (; word + detail::reduction_lanes <= word_count; word += detail::reduction_lanes) {
+      for (std::size_t lane = 0; lane < detail::reduction_lanes; ++lane) {
+        acc[lane] += std::popcount(_words[word + lane] ^ other._words[word + lane]);
+      }
+    }
+    for (; word < word_count; ++word) {
+      acc[0] += std::popcount(_words[word] ^ other._words[word]);
+    }
+    return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+  }
+
+  /**
+   * @brief Computes the Jaccard similarity, the number of bits set in both vectors over the number set in either.
+   *
+   * @param other The vector to compare with.
+   * @return The similarity in [0, 1]. Two empty vectors have similarity 1.
+   */
+  [[nodiscard]] constexpr double jaccard(bit_vector const &other) const {
+    std::size_t both = 0;
+    std::size_t either = 0;
+    for (std::size_t word = 0; word < word_count; ++word) {
+      both += std::popcount(_words[word] & other._words[word]);
+      either += std::popcount(_words[word] | other._words[word]);
+    }
+    return either == 0 ? 1.0 : double(both) / double(either);
+  }
+
+  /**
+   * @brief Bitwise AND of two vectors.
+   *
+   * @param other The vector to combine with.
+   * @return A new vector with the bits set in both vectors.
+   */
+  [[nodiscard]] constexpr bit_vector operator&(bit_vector const &other) const {
+    bit_vector result;
+    detail::binary_n<word_type>(_words.data(), other._words.data(), result._words.data(), word_count,
+                                std::bit_and<>());
+    return result;
+  }
+
+  /**
+   * @brief Bitwise OR of two vectors.
+   *
+   * @param other The vector to combine with.
+   * @return A new vector with the bits set in either vector.
+   */
+  [[nodiscard]] constexpr bit_vector operator|(bit_vector const &other) const {
+    bit_vector result;
+    detail::binary_n<word_type>(_words.data(), other._words.data(), result._words.data(), word_count,
+                                std::bit_or<>());
+    return result;
+  }
+
+  /**
+   * @brief Bitwise exclusive OR of two vectors.
+   *
+   * @param other The vector to combine with.
+   * @return A new vector with the bits set in exactly one of the vectors.
+   */
+  [[nodiscard]] constexpr bit_vector operator^(bit_vector const &other) const {
+    bit_vector result;
+    detail::binary_n<word_type>(_words.data(), other._words.data(), result._words.data(), word_count,
+                                std::bit_xor<>());
+    return result;
+  }
+
+  /**
+   * @brief Bitwise NOT of the vector.
+   *
+   * @return A new vector with every bit flipped.
+   */
+  [[nodiscard]] constexpr bit_vector operator~() const {
+    bit_vector result;
+    detail::unary_n<word_type>(_words.data(), result._words.data(), word_count, std::bit_not<>());
+    result.clear_padding();
+    return result;
+  }
+
+  /**
+   * @brief Compares two vectors for equality.
+   */
+  [[nodiscard]] constexpr bool operator==(bit_vector const &other) const = default;
+
+  /**
+   * @brief Converts the vector to a string of '0' and '1' characters, first bit first.
+   *
+   * @return A string representation of the vector.
+   */
+  [[nodiscard]] std::string view() const {
+    std::string result(Bits, '0');
+    for (std::size_t i = 0; i < Bits; ++i) {
+      if (test(i)) {
+        result[i] = '1';
+      }
+    }
+    return result;
+  }
+
+  /**
+   * @brief Stream insertion operator for bit vectors.
+   *
+   * @param os The output stream.
+   * @param other The vector to be output.
+   * @return The output stream with the vector representation.
+   */
+  friend std::ostream &operator<<(std::ostream &os, bit_vector const &other) {
+    os << other.view();
+    return os;
+  }
+
+private:
+  std::array<word_type, word_count> _words{};
+
+  static constexpr void check_index(std::size_t const index) {
+    if (index >= Bits) {
+      throw std::out_of_range("Index exceeds bit_vector size");
+    }
+  }
+
+  constexpr void clear_padding() {
+    if constexpr (Bits % word_bits != 0) {
+      _words[word_count - 1] &= (word_type(1) << (Bits % word_bits)) - 1;
+    }
+  }
+};
+
+/**
+ * @brief Computes the Hamming distance from a query to every candidate.
+ *
+ * @tparam Bits The number of bits.
+ * @tparam Candidates A range of `bit_vector<Bits>`.
+ * @param query The query signature.
+ * @param candidates The candidate signatures.
+ * @return One distance per candidate, in candidate order.
+ */
+template <std::size_t Bits, std::ranges::input_range Candidates>
+  requires std::is_same_v<std::ranges::range_value_t<Candidates>, bit_vector<Bits>>
+[[nodiscard]] std::vector<std::size_t> hamming_scan(bit_vector<Bits> const &query, Candidates const &candidates) {
+  std::vector<std::size_t> distances;
+  if constexpr (std::ranges::sized_range<Candidates>) {
+    distances.reserve(std::ranges::size(candidates));
+  }
+  for (auto const &candidate : candidates) {
+    distances.push_back(query.hamming(candidate));
+  }
+  return distances;
+}
+
+/**
+ * @brief Finds the `k` candidates closest to a query in Hamming distance.
+ *
+ * Distances are bounded by Bits, so the selection is a counting pass over a histogram of distances rather than a
+ * sort: the scan computes every distance once, the histogram gives the distance cut-off of the k-th result, and a
+ * final pass collects the candidates at or below it.
+ *
+ * @tparam Bits The number of bits.
+ * @tparam Candidates A range of `bit_vector<Bits>`.
+ * @param query The query signature.
+ * @param candidates The candidate signatures.
+ * @param k The number of results.
+ * @return Up to `k` pairs of (candidate index, distance), closest first. Ties are broken by the lower index.
+ */
+template <std::size_t Bits, std::ranges::input_range Candidates>
+  requires std::is_same_v<std::ranges::range_value_t<Candidates>, bit_vector<Bits>>
+[[nodiscard]] std::vector<std::pair<std::size_t, std::size_t>> hamming_top_k(bit_vector<Bits> const &query,
+                                                                              Candidates const &candidates,
+                                                                              std::size_t k) {
+  auto const distances = hamming_scan(query, candidates);
+  k = std::min(k, distances.size());
+  if (k == 0) {
+    return {};
+  }
+
+  std::vector<std::size_t> histogram(Bits + 1, 0);
+  for (auto const distance : distances) {
+    ++histogram[distance];
+  }
+  std::size_t cutoff = 0;
+  for (std::size_t seen = 0; seen + histogram[cutoff] < k; ++cutoff) {
+    seen += histogram[cutoff];
+  }
+
+  std::vector<std::pair<std::size_t, std::size_t>> result;
+  result.reserve(k);
+  for (std::size_t index = 0; index < distances.size(); ++index) {
+    if (distances[index] <= cutoff) {
+      result.emplace_back(index, distances[index]);
+    }
+  }
+  std::stable_sort(result.begin(), result.end(), [](auto const &a, auto const &b) { return a.second < b.second; });
+  result.resize(k);
+  return result;
+}
+
+} // namespace firefly
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <type_traits>
+
+#if __has_include(<stdfloat>)
+#include <stdfloat>
+#endif
+
+#if defined(__STDCPP_FLOAT16_T__) && __has_include(<stdfloat>)
+/// @brief Defined when `std::float16_t` is available as a vector element type.
+#define FIREFLY_HAS_FLOAT16 1
+#endif
+
+#if defined(__STDCPP_BFLOAT16_T__) && __has_include(<stdfloat>)
+/// @brief Defined when `std::bfloat16_t` is available as a vector element type.
+#define FIREFLY_HAS_BFLOAT16 1
+#endif
+
+namespace firefly::detail {
+
+/**
+ * @brief Checks whether `T` is a 16-bit floating point type (`std::float16_t` or `std::bfloat16_t`).
+ *
+ * @tparam T The type to check.
+ */
+template <typename T>
+inline constexpr bool is_half_v = false;
+
+#ifdef FIREFLY_HAS_FLOAT16
+template <>
+inline constexpr bool is_half_v<std::float16_t> = true;
+#endif
+
+#ifdef FIREFLY_HAS_BFLOAT16
+template <>
+inline constexpr bool is_half_v<std::bfloat16_t> = true;
+#endif
+
+/**
+ * @brief Type in which arithmetic on elements of type `T` is evaluated.
+ *
+ * 16-bit floating point elements are only a storage format and are computed in `float`; every other type is computed
+ * in itself.
+ *
+ * @tparam T The element type.
+ */
+template <typename T>
+using compute_type_t = std::conditional_t<is_half_v<T>, float, T>;
+
+/**
+ * @brief Converts IEEE 754 binary16 bits to `float`.
+ *
+ * Normal and subnormal inputs are handled by one rebiasing multiplication, so the conversion has no data-dependent
+ * branches apart from the infinity/NaN check and vectorises well.
+ */
+[[nodiscard]] constexpr float float16_bits_to_float(std::uint16_t const bits) {
+  std::uint32_t const sign = std::uint32_t(bits & 0x8000u) << 16;
+  std::uint32_t const magnitude = std::uint32_t(bits & 0x7FFFu) << 13;
+  if (magnitude >= (0x1Fu << 23)) {
+    return std::bit_cast<float>(sign | 0x7F800000u | magnitude);
+  }
+  float const value = std::bit_cast<float>(magnitude) * 0x1p112f;
+  return std::bit_cast<float>(sign | std::bit_cast<std::uint32_t>(value));
+}
+
+/**
+ * @brief Converts a `float` to IEEE 754 binary16 bits, rounding to nearest even.
+ *
+ * Values too large for binary16 become infinity and NaN stays a (quiet) NaN.
+ */
+[[nodiscard]] constexpr std::uint16_t float_to_float16_bits(float const value) {
+  std::uint32_t bits = std::bit_cast<std::uint32_t>(value);
+  auto const sign = std::uint16_t((bits >> 16) & 0x8000u);
+  bits &= 0x7FFFFFFFu;
+
+  if (bits >= 0x47800000u) {
+    return std::uint16_t(sign | (bits > 0x7F800000u ? 0x7E00u : 0x7C00u));
+  }
+  if (bits < 0x38800000u) {
+    // Subnormal or zero: adding 0.5 aligns the binary16 subnormal step with the float ULP and lets the FPU round.
+    float const aligned = std::bit_cast<float>(bits) + 0.5f;
+    return std::uint16_t(sign | (std::bit_cast<std::uint32_t>(aligned) - 0x3F000000u));
+  }
+  std::uint32_t const odd = (bits >> 13) & 1u;
+  bits += 0xC8000FFFu + odd;
+  return std::uint16_t(sign | (bits >> 13));
+}
+
+/**
+ * @brief Converts bfloat16 bits to `float`, which is exact.
+ */
+[[nodiscard]] constexpr float bfloat16_bits_to_float(std::uint16_t const bits) {
+  return std::bit_cast<float>(std::uint32_t(bits) << 16);
+}
+
+/**
+ * @brief Converts a `float` to bfloat16 bits, rounding to nearest even. NaN stays a (quiet) NaN.
+ */
+[[nodiscard]] constexpr std::uint16_t float_to_bfloat16_bits(float const value) {
+  std::uint32_t const bits = std::bit_cast<std::uint32_t>(value);
+  if ((bits & 0x7FFFFFFFu) > 0x7F800000u) {
+    return std::uint16_t((bits >> 16) | 0x40u);
+  }
+  return std::uint16_t((bits + 0x7FFFu + ((bits >> 16) & 1u)) >> 16);
+}
+
+/**
+ * @brief Converts a 16-bit floating point value to `float`.
+ *
+ * With F16C the compiler's own `std::float16_t` conversion is used, which maps to `vcvtph2ps`; otherwise the portable
+ * bit manipulation above replaces the soft-float library call the compiler would emit. Widening bfloat16 is always a
+ * shift.
+ *
+ * @tparam H The 16-bit floating point type.
+ * @param value The value to convert.
+ * @return The value as a `float`.
+ */
+template <typename H>
+  requires is_half_v<H>
+[[nodiscard]] constexpr float half_to_float(H const value) {
+#ifdef FIREFLY_HAS_FLOAT16
+  if constexpr (std::is_same_v<H, std::float16_t>) {
+#ifdef __F16C__
+    return static_cast<float>(value);
+#else
+    return float16_bits_to_float(std::bit_cast<std::uint16_t>(value));
+#endif
+  } else
+#endif
+  {
+    return bfloat16_bits_to_float(std::bit_cast<std::uint16_t>(value));
+  }
+}
+
+/**
+ * @brief Converts a `float` to a 16-bit floating point type, rounding to nearest even.
+ *
+ * Uses the hardware conversion when F16C (for `std::float16_t`) or AVX512-BF16 (for `std::bfloat16_t`) is enabled
+ * and the portable bit manipulation otherwise.
+ *
+ * @tparam H The 16-bit floating point type.
+ * @param value The value to convert.
+ * @return The converted value.
+ */
+template <typename H>
+  requires is_half_v<H>
+[[nodiscard]] constexpr H float_to_half(float const value) {
+#ifdef FIREFLY_HAS_FLOAT16
+  if constexpr (std::is_same_v<H, std::float16_t>) {
+#ifdef __F16C__
+    return static_cast<H>(value);
+#else
+    return std::bit_cast<H>(float_to_float16_bits(value));
+#endif
+  } else
+#endif
+  {
+#ifdef __AVX512BF16__
+    return static_cast<H>(value);
+#else
+    return std::bit_cast<H>(float_to_bfloat16_bits(value));
+#endif
+  }
+}
+
+} // namespace firefly::detail
@@ -0,0 +1,363 @@
+#pragma once
+
+#include <complex>
+#include <cstddef>
+#include <type_traits>
+
+#include "firefly/detail/half.hpp"
+
+namespace firefly::detail {
+
+/**
+ * @brief Checks whether `T` is a `std::complex` specialisation.
+ *
+ * @tparam T The type to check.
+ */
+template <typename T>
+inline constexpr bool is_complex_number_v = false;
+
+template <typename T>
+inline constexpr bool is_complex_number_v<std::complex<T>> = true;
+
+/**
+ * @brief Converts a single element to another element type.
+ *
+ * Complex to complex conversions are performed component-wise, so they also work where the standard library only
+ * provides the converting constructor between floating point complex types. 16-bit floating point values are
+ * converted through `float` with half_to_float and float_to_half.
+ *
+ * @tparam To The destination element type.
+ * @tparam From The source element type.
+ * @param value The element to convert.
+ * @return The converted element.
+ */
+template <typename To, typename From>
+[[nodiscard]] constexpr To element_cast(From const &value) {
+  if constexpr (std::is_same_v<To, From>) {
+    return value;
+  } else if constexpr (is_half_v<From>) {
+    return element_cast<To>(half_to_float(value));
+  } else if constexpr (is_half_v<To>) {
+    return float_to_half<To>(element_cast<float>(value));
+  } else if constexpr (is_complex_number_v<To> && is_complex_number_v<From>) {
+    using value_type = typename To::value_type;
+    return To(static_cast<value_type>(value.real()), static_cast<value_type>(value.imag()));
+  } else if constexpr (is_complex_number_v<To>) {
+    return To(static_cast<typename To::value_type>(value));
+  } else {
+    return static_cast<To>(value);
+  }
+}
+
+/**
+ * @brief Bulk conversion of `n` elements from `in` to `out`.
+ *
+ * The loop is a plain indexed loop over contiguous storage, which GCC and Clang turn into packed conversion
+ * instructions (such as `cvtdq2ps` or `cvtps2pd`) for the target selected with `-march`. Complex to arithmetic
+ * conversions produce the squared magnitude `re² + im²`, reading the interleaved real and imaginary parts directly
+ * (`std::complex` is layout compatible with an array of two values) so the loop vectorises with de-interleaving loads.
+ *
+ * @tparam To The destination element type.
+ * @tparam From The source element type.
+ * @param in Pointer to the source elements.
+ * @param out Pointer to the destination elements.
+ * @param n The number of elements to convert.
+ */
+template <typename To, typename From>
+constexpr void convert_n(From const *in, To *out, std::size_t n) {
+  if constexpr (is_complex_number_v<From> && !is_complex_number_v<To>) {
+    if (!std::is_constant_evaluated()) {
+      auto const *parts = reinterpret_cast<typename From::value_type const *>(in);
+      for (std::size_t i = 0; i < n; ++i) {
+        auto const re = parts[2 * i];
+        auto const im = parts[2 * i + 1];
+        out[i] = static_cast<To>(re * re + im * im);
+      }
+      return;
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+      out[i] = static_cast<To>(in[i].real() * in[i].real() + in[i].imag() * in[i].imag());
+    }
+  } else {
+    for (std::size_t i = 0; i < n; ++i) {
+      out[i] = element_cast<To>(in[i]);
+    }
+  }
+}
+
+/**
+ * @brief Applies a unary operation to `n` elements, converting to the compute type in the same loop.
+ *
+ * A 16-bit floating point compute type is widened to `float` (see compute_type_t).
+ *
+ * @tparam Compute The type the operation is evaluated in.
+ * @tparam In The source element type.
+ * @tparam Out The destination element type.
+ * @tparam Op The operation type.
+ * @param in Pointer to the source elements.
+ * @param out Pointer to the destination elements. May alias `in`.
+ * @param n The number of elements.
+ * @param op The operation, invoked with one `Compute` value.
+ */
+template <typename Compute, typename In, typename Out, typename Op>
+constexpr void unary_n(In const *in, Out *out, std::size_t n, Op op) {
+  using C = compute_type_t<Compute>;
+  for (std::size_t i = 0; i < n; ++i) {
+    out[i] = element_cast<Out>(op(element_cast<C>(in[i])));
+  }
+}
+
+/**
+ * @brief Applies a binary operation to `n` pairs of elements, converting both operands to the compute type in the
+ * same loop.
+ *
+ * Fusing the conversion into the arithmetic means `vector<int> + vector<float>` converts each lane in-register
+ * instead of materialising a converted copy first. A 16-bit floating point compute type is widened to `float`.
+ *
+ * @tparam Compute The type the operation is evaluated in.
+ * @tparam A The element type of the first operand.
+ * @tparam B The element type of the second operand.
+ * @tparam Out The destination element type.
+ * @tparam Op The operation type.
+ * @param a Pointer to the first operand.
+ * @param b Pointer to the second operand.
+ * @param out Pointer to the destination elements. May alias `a` or `b`.
+ * @param n The number of elements.
+ * @param op The operation, invoked with two `Compute` values.
+ */
+template <typename Compute, typename A, typename B, typename Out, typename Op>
+constexpr void binary_n(A const *a, B const *b, Out *out, std::size_t n, Op op) {
+  using C = compute_type_t<Compute>;
+  for (std::size_t i = 0; i < n; ++i) {
+    out[i] = element_cast<Out>(op(element_cast<C>(a[i]), element_cast<C>(b[i])));
+  }
+}
+
+/**
+ * @brief Number of independent accumulators used by the reduction kernels.
+ *
+ * Splitting a reduction over several accumulators breaks the loop-carried dependency on a single register, which lets
+ * the compiler keep one accumulator per SIMD lane group and hides the latency of the combining instruction.
+ */
+inline constexpr std::size_t reduction_lanes = 4;
+
+/**
+ * @brief Reduces `n` mapped elements with a multi-accumulator loop.
+ *
+ * The elements are mapped and folded into #reduction_lanes accumulators, which are combined pairwise at the end.
+ * `init` must be the identity of `combine`.
+ *
+ * @tparam Acc The accumulator type.
+ * @tparam In The element type.
+ * @tparam Map The element mapping type.
+ * @tparam Combine The combining operation type.
+ * @param in Pointer to the elements.
+ * @param n The number of elements.
+ * @param init The identity value of the combining operation.
+ * @param map The mapping applied to each element before combining.
+ * @param combine The associative combining operation.
+ * @return The reduced value.
+ */
+template <typename Acc, typename In, typename Map, typename Combine>
+[[nodiscard]] constexpr Acc reduce_n(In const *in, std::size_t n, Acc init, Map map, Combine combine) {
+  Acc acc[reduction_lanes] = {init, init, init, init};
+
+  std::size_t const main = n - n % reduction_lanes;
+  for (std::size_t i = 0; i < main; i += reduction_lanes) {
+    for (std::size_t lane = 0; lane < reduction_lanes; ++lane) {
+      acc[lane] = combine(acc[lane], static_cast<Acc>(map(in[i + lane])));
+    }
+  }
+  for (std::size_t i = main; i < n; ++i) {
+    acc[0] = combine(acc[0], static_cast<Acc>(map(in[i])));
+  }
+
+  return combine(combine(acc[0], acc[1]), combine(acc[2], acc[3]));
+}
+
+/**
+ * @brief Reduces `n` mapped pairs of elements with a multi-accumulator loop.
+ *
+ * The two-operand counterpart of reduce_n, used for distances: `map` is applied to each pair `(a[i], b[i])` and the
+ * results are folded into #reduction_lanes accumulators.
+ *
+ * @tparam Acc The accumulator type.
+ * @tparam A The element type of the first operand.
+ * @tparam B The element type of the second operand.
+ * @tparam Map The pair mapping type.
+ * @tparam Combine The combining operation type.
+ * @param a Pointer to the first operand.
+ * @param b Pointer to the second operand.
+ * @param n The number of elements.
+ * @param init The identity value of the combining operation.
+ * @param map The mapping applied to each pair before combining.
+ * @param combine The associative combining operation.
+ * @return The reduced value.
+ */
+template <typename Acc, typename A, typename B, typename Map, typename Combine>
+[[nodiscard]] constexpr Acc reduce_n(A const *a, B const *b, std::size_t n, Acc init, Map map, Combine combine) {
+  Acc acc[reduction_lanes] = {init, init, init, init};
+
+  std::size_t const main = n - n % reduction_lanes;
+  for (std::size_t i = 0; i < main; i += reduction_lanes) {
+    for (std::size_t lane = 0; lane < reduction_lanes; ++lane) {
+      acc[lane] = combine(acc[lane], static_cast<Acc>(map(a[i + lane], b[i + lane])));
+    }
+  }
+  for (std::size_t i = main; i < n; ++i) {
+    acc[0] = combine(acc[0], static_cast<Acc>(map(a[i], b[i])));
+  }
+
+  return combine(combine(acc[0], acc[1]), combine(acc[2], acc[3]));
+}
+
+/**
+ * @brief Squared difference of two elements in the type `R`, used by the distance kernels.
+ *
+ * @tparam R The type the difference is computed in.
+ */
+template <typename R>
+struct squared_difference {
+  template <typename A, typename B>
+  constexpr R operator()(A const &a, B const &b) const {
+    R const d = element_cast<R>(a) - element_cast<R>(b);
+    return d * d;
+  }
+};
+
+/**
+ * @brief Absolute difference of two real elements in the type `R`, used by the distance kernels.
+ *
+ * @tparam R The type the difference is computed in.
+ */
+template <typename R>
+struct absolute_difference {
+  template <typename A, typename B>
+  constexpr R operator()(A const &a, B const &b) const {
+    R const x = element_cast<R>(a);
+    R const y = element_cast<R>(b);
+    return x < y ? R(y - x) : R(x - y);
+  }
+};
+
+/**
+ * @brief Number of elements between two early-abandon checks in bounded_reduce_n.
+ *
+ * Checking after every few vector blocks rather than every element keeps the inner loop branch-free so it still
+ * vectorises, while bounding the wasted work on a rejected candidate.
+ */
+inline constexpr std::size_t abandon_check_interval = 8 * reduction_lanes;
+
+/**
+ * @brief Reduces `n` mapped pairs like reduce_n, stopping early once the partial result exceeds `bound`.
+ *
+ * `combine` must be monotonic for the mapped values (such as a sum of non-negative terms or a maximum), so that a
+ * partial result that exceeds the bound proves the final result does too.
+ *
+ * @return The reduced value if it does not exceed `bound`, otherwise some partial result greater than `bound`.
+ */
+template <typename Acc, typename A, typename B, typename Map, typename Combine>
+[[nodiscard]] constexpr Acc bounded_reduce_n(A const *a, B const *b, std::size_t n, Acc init, Map map, Combine combine,
+                                             Acc bound) {
+  Acc acc[reduction_lanes] = {init, init, init, init};
+
+  std::size_t i = 0;
+  while (i + abandon_check_interval <= n) {
+    for (std::size_t const end = i + abandon_check_interval; i < end; i += reduction_lanes) {
+      for (std::size_t lane = 0; lane < reduction_lanes; ++lane) {
+        acc[lane] = combine(acc[lane], static_cast<Acc>(map(a[i + lane], b[i + lane])));
+      }
+    }
+    Acc const partial = combine(combine(acc[0], acc[1]), combine(acc[2], acc[3]));
+    if (bound < partial) {
+      return partial;
+    }
+  }
+  for (; i < n; ++i) {
+    acc[0] = combine(acc[0], static_cast<Acc>(map(a[i], b[i])));
+  }
+
+  return combine(combine(acc[0], acc[1]), combine(acc[2], acc[3]));
+}
+
+/**
+ * @brief NaN-propagating minimum used by the reduction kernels.
+ *
+ * Returns NaN if either argument is NaN, otherwise the smaller argument, so the result does not depend on the order
+ * in which lanes are combined.
+ */
+struct propagating_min {
+  template <typename T>
+  constexpr T operator()(T const &a, T const &b) const {
+    return (b < a || b != b) ? b : a;
+  }
+};
+
+/**
+ * @brief NaN-propagating maximum used by the reduction kernels.
+ *
+ * Returns NaN if either argument is NaN, otherwise the larger argument.
+ */
+struct propagating_max {
+  template <typename T>
+  constexpr T operator()(T const &a, T const &b) const {
+    return (a < b || b != b) ? b : a;
+  }
+};
+
+/**
+ * @brief Finds the index of the first minimum (or maximum) element with a multi-accumulator loop.
+ *
+ * Each lane keeps its best value and index. A NaN element always wins and the first NaN is reported, which matches a
+ * sequential scan that stops improving once it has seen a NaN. Ties are resolved towards the lowest index.
+ *
+ * @tparam IsMax Whether to search for the maximum instead of the minimum.
+ * @tparam T The element type.
+ * @param in Pointer to the elements.
+ * @param n The number of elements, at least one.
+ * @return The index of the selected element.
+ */
+template <bool IsMax, typename T>
+[[nodiscard]] constexpr std::size_t arg_extremum_n(T const *in, std::size_t n) {
+  auto const is_nan = [](T const &v) { return v != v; };
+  auto const improves = [&](T const &candidate, T const &best) {
+    if (is_nan(best)) {
+      return false;
+    }
+    if (is_nan(candidate)) {
+      return true;
+    }
+    return IsMax ? best < candidate : candidate < best;
+  };
+
+  T best[reduction_lanes] = {in[0], in[0], in[0], in[0]};
+  std::size_t index[reduction_lanes] = {0, 0, 0, 0};
+
+  std::size_t i = 0;
+  for (; i + reduction_lanes <= n; i += reduction_lanes) {
+    for (std::size_t lane = 0; lane < reduction_lanes; ++lane) {
+      if (improves(in[i + lane], best[lane])) {
+        best[lane] = in[i + lane];
+        index[lane] = i + lane;
+      }
+    }
+  }
+  for (; i < n; ++i) {
+    if (improves(in[i], best[0])) {
+      best[0] = in[i];
+      index[0] = i;
+    }
+  }
+
+  std::size_t result = 0;
+  for (std::size_t lane = 0; lane < reduction_lanes; ++lane) {
+    bool const better = improves(best[lane], in[result]);
+    bool const tie = !improves(in[result], best[lane]) && index[lane] < result;
+    if (better || tie) {
+      result = index[lane];
+    }
+  }
+  return result;
+}
+
+} // namespace firefly::detail
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace firefly::detail {
+
+/**
+ * @brief Resolves a requested thread count, where zero means one thread per hardware thread.
+ *
+ * @param requested The requested number of threads, or zero for the hardware concurrency.
+ * @param tasks The number of independent tasks available. No more threads than tasks are used.
+ * @return The number of threads to use, at least one.
+ */
+[[nodiscard]] inline std::size_t resolve_threads(std::size_t requested, std::size_t tasks) {
+  std::size_t threads = requested == 0 ? std::max<std::size_t>(1, std::thread::hardware_concurrency()) : requested;
+  return std::max<std::size_t>(1, std::min(threads, tasks));
+}
+
+/**
+ * @brief Runs `f(task)` for every task in [0, tasks), spreading contiguous task ranges over `threads` threads.
+ *
+ * The calling thread runs the first range itself. The assignment of tasks to threads only depends on `tasks` and
+ * `threads`, so callers that combine per-task results in task order get deterministic results. If a task throws,
+ * the first exception is rethrown on the calling thread after every thread has joined.
+ *
+ * @tparam F The task function type.
+ * @param tasks The number of tasks.
+ * @param threads The number of threads to use, at least one.
+ * @param f The task function, invoked with the task index.
+ */
+template <typename F>
+void parallel_for(std::size_t tasks, std::size_t threads, F const &f) {
+  threads = std::max<std::size_t>(1, std::min(threads, tasks));
+  if (threads <= 1) {
+    for (std::size_t task = 0; task < tasks; ++task) {
+      f(task);
+    }
+    return;
+  }
+
+  std::vector<std::exception_ptr> errors(threads);
+  auto const run = [&](std::size_t worker) {
+    try {
+      std::size_t const begin = tasks * worker / threads;
+      std::size_t const end = tasks * (worker + 1) / threads;
+      for (std::size_t task = begin; task < end; ++task) {
+        f(task);
+      }
+    } catch (...) {
+      errors[worker] = std::current_exception();
+    }
+  };
+
+  std::vector<std::thread> workers;
+  workers.reserve(threads - 1);
+  for (std::size_t worker = 1; worker < threads; ++worker) {
+    workers.emplace_back(run, worker);
+  }
+  run(0);
+  for (auto &worker : workers) {
+    worker.join();
+  }
+
+  for (auto const &error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
+/**
+ * @brief Splits the items [0, n) into one contiguous range per thread and runs `f(begin, end)` on each.
+ *
+ * Used by batched kernels whose per-item work is small: each thread runs a single tight loop over its range instead
+ * of one call per item.
+ *
+ * @tparam F The range function type.
+ * @param n The number of items.
+ * @param threads The requested number of threads, zero for the hardware concurrency.
+ * @param f The range function, invoked with the bounds of a range.
+ */
+template <typename F>
+void parallel_for_ranges(std::size_t n, std::size_t threads, F const &f) {
+  std::size_t const workers = resolve_threads(threads, n);
+  parallel_for(workers, workers, [&](std::size_t worker) { f(n * worker / workers, n * (worker + 1) / workers); });
+}
+
+} // namespace firefly::detail
@@ -0,0 +1,581 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <numbers>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "firefly/vector.hpp"
+
+namespace firefly {
+
+namespace detail {
+
+/// @brief Convolutions where the shorter operand has at most this many elements are computed directly.
+inline constexpr std::size_t direct_convolution_limit = 32;
+
+/**
+ * @brief Checks that `U` is `float`, `double` or a `std::complex` of either, the element types of the transforms.
+ */
+template <typename U>
+struct is_fft_element : std::false_type {};
+
+template <std::floating_point T>
+struct is_fft_element<T> : std::true_type {};
+
+template <std::floating_point T>
+struct is_fft_element<std::complex<T>> : std::true_type {};
+
+/**
+ * @brief The real type underlying an FFT element type.
+ */
+template <typename U>
+struct fft_real {
+  using type = U;
+};
+
+template <typename T>
+struct fft_real<std::complex<T>> {
+  using type = T;
+};
+
+template <typename U>
+using fft_real_t = typename fft_real<U>::type;
+
+/**
+ * @brief Complex product written out on the parts, which avoids the NaN recovery of `operator*` so that loops over it
+ * vectorise.
+ */
+template <typename T>
+[[nodiscard]] constexpr std::complex<T> multiply(std::complex<T> const a, std::complex<T> const b) {
+  return {a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real()};
+}
+
+/**
+ * @brief Returns `e^(-2πi k / n)`, computed in `double` from the reduced index.
+ */
+template <typename T>
+[[nodiscard]] std::complex<T> root_of_unity(std::size_t const k, std::size_t const n) {
+  double const angle = -2.0 * std::numbers::pi * double(k % n) / double(n);
+  return {T(std::cos(angle)), T(std::sin(angle))};
+}
+
+/**
+ * @brief Returns the smallest length of at least `n` whose only prime factors are 2, 3 and 5.
+ */
+[[nodiscard]] inline std::size_t next_fast_length(std::size_t n) {
+  for (;; ++n) {
+    std::size_t m = n;
+    for (std::size_t const p : {2, 3, 5}) {
+      while (m % p == 0) {
+        m /= p;
+      }
+    }
+    if (m == 1) {
+      return n;
+    }
+  }
+}
+
+/**
+ * @brief Returns a per-thread scratch buffer of at least `n` elements.
+ */
+template <typename T>
+[[nodiscard]] std::complex<T> *fft_scratch(std::size_t const n) {
+  thread_local std::vector<std::complex<T>> scratch;
+  if (scratch.size() < n) {
+    scratch.resize(n);
+  }
+  return scratch.data();
+}
+
+} // namespace detail
+
+/**
+ * @class fft_plan
+ * @brief A precomputed mixed-radix fast Fourier transform of a fixed length.
+ *
+ * The length is factored into radices 4, 2, 3, 5 and any remaining primes, and the transform runs one Stockham
+ * autosort stage per factor, so no bit-reversal pass is needed. Every stage keeps its twiddle factors, which are
+ * computed once per plan. Radices 2 and 4 have dedicated butterflies; other radices use a direct DFT of the radix,
+ * so lengths with large prime factors are correct but slower. Plans are immutable and can be shared between threads.
+ *
+ * The forward transform is `X[k] = Σ x[n] e^(-2πi kn/N)`, and the inverse includes the `1/N` factor.
+ *
+ * @tparam T The floating point type of the real and imaginary parts.
+ */
+template <std::floating_point T>
+class fft_plan {
+public:
+  using value_type = std::complex<T>;
+
+  /**
+   * @brief Constructor that builds the plan of a length.
+   *
+   * @param length The transform length.
+   * @throw std::invalid_argument if the length is zero.
+   */
+  explicit fft_plan(std::size_t const length) : _length(length) {
+    if (length == 0) {
+      throw std::invalid_argument("FFT length must not be zero");
+    }
+    std::size_t rest = length;
+    std::size_t stride = 1;
+    auto const add_stage = [&](std::size_t const radix) {
+      std::size_t const span = rest;
+      rest /= radix;
+      stage s{radix, rest, stride, {}, {}};
+      s.twiddles.resize(rest * (radix - 1));
+      for (std::size_t p = 0; p < rest; ++p) {
+        for (std::size_t j = 1; j < radix; ++j) {
+          s.twiddles[p * (radix - 1) + j - 1] = detail::root_of_unity<T>(p * j, span);
+        }
+      }
+      if (radix != 2 && radix != 4) {
+        s.roots.resize(radix);
+        for (std::size_t t = 0; t < radix; ++t) {
+          s.roots[t] = detail::root_of_unity<T>(t, radix);
+        }
+      }
+      _stages.push_back(std::move(s));
+      stride *= radix;
+    };
+    while (rest % 4 == 0) {
+      add_stage(4);
+    }
+    while (rest % 2 == 0) {
+      add_stage(2);
+    }
+    for (std::size_t p = 3; rest > 1; p += 2) {
+      while (rest % p == 0) {
+        add_stage(p);
+      }
+    }
+  }
+
+  /**
+   * @brief Returns a shared plan of a length, building it on first use.
+   *
+   * Plans are kept for the lifetime of the program, one per length and floating point type.
+   *
+   * @param length The transform length.
+   * @throw std::invalid_argument if the length is zero.
+   * @return The plan.
+   */
+  [[nodiscard]] static std::shared_ptr<fft_plan const> cached(std::size_t const length) {
+    static std::mutex mutex;
+    static std::unordered_map<std::size_t, std::shared_ptr<fft_plan const>> plans;
+    std::lock_guard<std::mutex> const lock(mutex);
+    auto &plan = plans[length];
+    if (!plan) {
+      plan = std::make_shared<fft_plan const>(length);
+    }
+    return plan;
+  }
+
+  /**
+   * @brief Returns the transform length.
+   */
+  [[nodiscard]] std::size_t size() const {
+    return _length;
+  }
+
+  /**
+   * @brief Computes the forward transform.
+   *
+   * @tparam In A contiguous range of `std::complex<T>`.
+   * @tparam Out A contiguous range of `std::complex<T>`.
+   * @param in The signal.
+   * @param out The range receiving the spectrum. It may alias `in`.
+   * @throw std::invalid_argument if either range does not have size() elements.
+   */
+  template <std::ranges::contiguous_range In, std::ranges::contiguous_range Out>
+    requires std::is_same_v<std::ranges::range_value_t<In>, value_type> &&
+             std::is_same_v<std::ranges::range_value_t<Out>, value_type>
+  void forward(In const &in, Out &&out) const {
+    check_sizes(std::ranges::size(in), std::ranges::size(out));
+    execute(std::ranges::data(in), std::ranges::data(out));
+  }
+
+  /**
+   * @brief Computes the inverse transform, including the `1/N` factor.
+   *
+   * @tparam In A contiguous range of `std::complex<T>`.
+   * @tparam Out A contiguous range of `std::complex<T>`.
+   * @param in The spectrum.
+   * @param out The range receiving the signal. It may alias `in`.
+   * @throw std::invalid_argument if either range does not have size() elements.
+   */
+  template <std::ranges::contiguous_range In, std::ranges::contiguous_range Out>
+    requires std::is_same_v<std::ranges::range_value_t<In>, value_type> &&
+             std::is_same_v<std::ranges::range_value_t<Out>, value_type>
+  void inverse(In const &in, Out &&out) const {
+    check_sizes(std::ranges::size(in), std::ranges::size(out));
+    value_type const *source = std::ranges::data(in);
+    value_type *target = std::ranges::data(out);
+    // ifft(x) = conj(fft(conj(x))) / N reuses the forward twiddles.
+    for (std::size_t i = 0; i < _length; ++i) {
+      target[i] = std::conj(source[i]);
+    }
+    execute(target, target);
+    T const scale = T(1) / T(_length);
+    for (std::size_t i = 0; i < _length; ++i) {
+      target[i] = value_type(target[i].real() * scale, -target[i].imag() * scale);
+    }
+  }
+
+private:
+  struct stage {
+    std::size_t radix;
+    std::size_t m;
+    std::size_t stride;
+    std::vector<value_type> twiddles;
+    std::vector<value_type> roots;
+  };
+
+  std::size_t _length;
+  std::vector<stage> _stages;
+
+  void check_sizes(std::size_t const in, std::size_t const out) const {
+    if (in != _length || out != _length) {
+      throw std::invalid_argument("FFT input and output must have the plan length");
+    }
+  }
+
+  void execute(value_type const *in, value_type *out) const {
+    value_type *x = out;
+    value_type *y = detail::fft_scratch<T>(_length);
+    if (in != out) {
+      std::copy_n(in, _length, out);
+    }
+    for (auto const &s : _stages) {
+      run(s, x, y);
+      std::swap(x, y);
+    }
+    if (x != out) {
+      std::copy_n(x, _length, out);
+    }
+  }
+
+  /**
+   * @brief Runs one decimation-in-frequency Stockham stage: `y[q + s(rp + j)] = w^(pj) Σ_k x[q + s(p + km)] ω_r^(jk)`.
+   * The innermost loop walks `q` over contiguous elements.
+   */
+  static void run(stage const &st, value_type const *x, value_type *y) {
+    std::size_t const r = st.radix;
+    std::size_t const m = st.m;
+    std::size_t const s = st.stride;
+    for (std::size_t p = 0; p < m; ++p) {
+      value_type const *w = st.twiddles.data() + p * (r - 1);
+      value_type const *in = x + s * p;
+      value_type *result = y + s * r * p;
+      if (r == 2) {
+        for (std::size_t q = 0; q < s; ++q) {
+          value_type const a0 = in[q];
+          value_type const a1 = in[q + s * m];
+          result[q] = a0 + a1;
+          result[q + s] = detail::multiply(a0 - a1, w[0]);
+        }
+      } else if (r == 4) {
+        for (std::size_t q = 0; q < s; ++q) {
+          value_type const a0 = in[q];
+          value_type const a1 = in[q + s * m];
+          value_type const a2 = in[q + 2 * s * m];
+          value_type const a3 = in[q + 3 * s * m];
+          value_type const sum02 = a0 + a2;
+          value_type const diff02 = a0 - a2;
+          value_type const sum13 = a1 + a3;
+          // -i (a1 - a3)
+          value_type const rot13(a1.imag() - a3.imag(), a3.real() - a1.real());
+          result[q] = sum02 + sum13;
+          result[q + s] = detail::multiply(diff02 + rot13, w[0]);
+          result[q + 2 * s] = detail::multiply(sum02 - sum13, w[1]);
+          result[q + 3 * s] = detail::multiply(diff02 - rot13, w[2]);
+        }
+      } else {
+        for (std::size_t q = 0; q < s; ++q) {
+          for (std::size_t j = 0; j < r; ++j) {
+            value_type sum = in[q];
+            for (std::size_t k = 1; k < r; ++k) {
+              sum += detail::multiply(in[q + k * s * m], st.roots[(j * k) % r]);
+            }
+            result[q + s * j] = j == 0 ? sum : detail::multiply(sum, w[j - 1]);
+          }
+        }
+      }
+    }
+  }
+};
+
+/**
+ * @brief Computes the forward FFT of a contiguous range of complex values, with a cached plan of its length.
+ *
+ * @tparam In A contiguous range of `std::complex<T>`.
+ * @tparam Out A contiguous range of `std::complex<T>`.
+ * @param in The signal.
+ * @param out The range receiving the spectrum. It may alias `in`.
+ * @throw std::invalid_argument if the ranges are empty or differ in size.
+ */
+template <std::ranges::contiguous_range In, std::ranges::contiguous_range Out,
+          typename C = std::ranges::range_value_t<In>>
+  requires detail::is_fft_element<C>::value && std::is_same_v<C, std::complex<detail::fft_real_t<C>>> &&
+           std::is_same_v<std::ranges::range_value_t<Out>, C>
+void fft(In const &in, Out &&out) {
+  fft_plan<detail::fft_real_t<C>>::cached(std::ranges::size(in))->forward(in, out);
+}
+
+/**
+ * @brief Computes the inverse FFT of a contiguous range of complex values, with a cached plan of its length.
+ *
+ * @tparam In A contiguous range of `std::complex<T>`.
+ * @tparam Out A contiguous range of `std::complex<T>`.
+ * @param in The spectrum.
+ * @param out The range receiving the signal. It may alias `in`.
+ * @throw std::invalid_argument if the ranges are empty or differ in size.
+ */
+template <std::ranges::contiguous_range In, std::ranges::contiguous_range Out,
+          typename C = std::ranges::range_value_t<In>>
+  requires detail::is_fft_element<C>::value && std::is_same_v<C, std::complex<detail::fft_real_t<C>>> &&
+           std::is_same_v<std::ranges::range_value_t<Out>, C>
+void ifft(In const &in, Out &&out) {
+  fft_plan<detail::fft_real_t<C>>::cached(std::ranges::size(in))->inverse(in, out);
+}
+
+/**
+ * @brief Computes the spectrum of a real or complex vector.
+ *
+ * @tparam U The element type, floating point or complex.
+ * @tparam Length The number of elements.
+ * @param v The signal.
+ * @return The complex spectrum.
+ */
+template <typename U, std::size_t Length>
+  requires detail::is_fft_element<U>::value && (Length > 0)
+[[nodiscard]] vector<std::complex<detail::fft_real_t<U>>, Length> fft(vector<U, Length> const &v) {
+  using C = std::complex<detail::fft_real_t<U>>;
+  vector<C, Length> result;
+  for (std::size_t i = 0; i < Length; ++i) {
+    result[i] = C(v[i]);
+  }
+  fft_plan<detail::fft_real_t<U>>::cached(Length)->forward(result, result);
+  return result;
+}
+
+/**
+ * @brief Computes the inverse transform of a complex spectrum vector.
+ *
+ * @tparam T The floating point type of the parts.
+ * @tparam Length The number of elements.
+ * @param v The spectrum.
+ * @return The complex signal.
+ */
+template <std::floating_point T, std::size_t Length>
+  requires(Length > 0)
+[[nodiscard]] vector<std::complex<T>, Length> ifft(vector<std::complex<T>, Length> const &v) {
+  vector<std::complex<T>, Length> result;
+  fft_plan<T>::cached(Length)->inverse(v, result);
+  return result;
+}
+
+namespace detail {
+
+/**
+ * @brief Direct full convolution, `out[k] = Σ a[i] b[k - i]`, accumulated one shifted copy of `b` at a time so that
+ * the inner loop is a contiguous multiply-add.
+ */
+template <typename U>
+void convolve_direct(U const *a, std::size_t const na, U const *b, std::size_t const nb, U *out) {
+  std::fill_n(out, na + nb - 1, U(0));
+  for (std::size_t i = 0; i < na; ++i) {
+    U const ai = a[i];
+    U *target = out + i;
+    for (std::size_t j = 0; j < nb; ++j) {
+      target[j] += ai * b[j];
+    }
+  }
+}
+
+/**
+ * @brief Full convolution through the FFT, on a padded length whose prime factors are 2, 3 and 5.
+ *
+ * Real operands are packed into one complex signal `a + ib`, so a single forward transform yields both spectra.
+ */
+template <typename U>
+void convolve_fft(U const *a, std::size_t const na, U const *b, std::size_t const nb, U *out) {
+  using T = fft_real_t<U>;
+  using C = std::complex<T>;
+  std::size_t const n = na + nb - 1;
+  std::size_t const length = next_fast_length(n);
+  auto const plan = fft_plan<T>::cached(length);
+
+  std::vector<C> x(length);
+  if constexpr (std::is_floating_point_v<U>) {
+    for (std::size_t i = 0; i < na; ++i) {
+      x[i].real(a[i]);
+    }
+    for (std::size_t i = 0; i < nb; ++i) {
+      x[i].imag(b[i]);
+    }
+    plan->forward(x, x);
+    // With Z = fft(a + ib): A[k] = (Z[k] + conj(Z[-k])) / 2 and B[k] = (Z[k] - conj(Z[-k])) / 2i, so
+    // A[k] B[k] = (Z[k]² - conj(Z[-k])²) / 4i.
+    std::vector<C> product(length);
+    for (std::size_t k = 0; k < length; ++k) {
+      C const z = x[k];
+      C const zc = std::conj(x[(length - k) % length]);
+      C const d = multiply(z, z) - multiply(zc, zc);
+      product[k] = C(d.imag() * T(0.25), -d.real() * T(0.25));
+    }
+    plan->inverse(product, product);
+    for (std::size_t i = 0; i < n; ++i) {
+      out[i] = product[i].real();
+    }
+  } else {
+    std::vector<C> y(length);
+    std::copy_n(a, na, x.begin());
+    std::copy_n(b, nb, y.begin());
+    plan->forward(x, x);
+    plan->forward(y, y);
+    for (std::size_t k = 0; k < length; ++k) {
+      x[k] = multiply(x[k], y[k]);
+    }
+    plan->inverse(x, x);
+    std::copy_n(x.begin(), n, out);
+  }
+}
+
+/**
+ * @brief Full convolution that picks the direct method for short operands and the FFT otherwise.
+ */
+template <typename U>
+void convolve_n(U const *a, std::size_t const na, U const *b, std::size_t const nb, U *out) {
+  if (std::min(na, nb) <= direct_convolution_limit) {
+    convolve_direct(a, na, b, nb, out);
+  } else {
+    convolve_fft(a, na, b, nb, out);
+  }
+}
+
+/**
+ * @brief Full cross-correlation, computed as the convolution of `a` with the reversed conjugate of `b`.
+ */
+template <typename U>
+void correlate_n(U const *a, std::size_t const na, U const *b, std::size_t const nb, U *out) {
+  std::vector<U> reversed(nb);
+  for (std::size_t i = 0; i < nb; ++i) {
+    if constexpr (std::is_floating_point_v<U>) {
+      reversed[i] = b[nb - 1 - i];
+    } else {
+      reversed[i] = std::conj(b[nb - 1 - i]);
+    }
+  }
+  convolve_n(a, na, reversed.data(), nb, out);
+}
+
+/**
+ * @brief Checks the sizes of a convolution or correlation and returns the size of the full result.
+ *
+ * @throw std::invalid_argument if an operand is empty or `out` is too small.
+ */
+inline std::size_t full_size(std::size_t const na, std::size_t const nb, std::size_t const out) {
+  if (na == 0 || nb == 0 || out < na + nb - 1) {
+    throw std::invalid_argument("Operands must not be empty and the output must hold the full result");
+  }
+  return na + nb - 1;
+}
+
+} // namespace detail
+
+/**
+ * @brief Computes the full linear convolution of two contiguous ranges, `out[k] = Σ a[i] b[k - i]`.
+ *
+ * When the shorter operand has at most 32 elements the sum is computed directly; otherwise both operands are
+ * transformed with a cached FFT plan of a padded length.
+ *
+ * @tparam A A contiguous range of `float`, `double` or a `std::complex` of either.
+ * @tparam B A contiguous range of the same type.
+ * @tparam Out A contiguous range of the same type.
+ * @param a The first operand.
+ * @param b The second operand.
+ * @param out The range receiving the `size(a) + size(b) - 1` values of the convolution.
+ * @throw std::invalid_argument if an operand is empty or `out` is too small.
+ */
+template <std::ranges::contiguous_range A, std::ranges::contiguous_range B, std::ranges::contiguous_range Out,
+          typename U = std::ranges::range_value_t<A>>
+  requires detail::is_fft_element<U>::value && std::is_same_v<std::ranges::range_value_t<B>, U> &&
+           std::is_same_v<std::ranges::range_value_t<Out>, U>
+void convolve(A const &a, B const &b, Out &&out) {
+  (void)detail::full_size(std::ranges::size(a), std::ranges::size(b), std::ranges::size(out));
+  detail::convolve_n(std::ranges::data(a), std::ranges::size(a), std::ranges::data(b), std::ranges::size(b),
+                     std::ranges::data(out));
+}
+
+/**
+ * @brief Computes the full cross-correlation of two contiguous ranges, `out[k + size(b) - 1] = Σ a[n + k] conj(b[n])`
+ * for the lags `k` from `1 - size(b)` to `size(a) - 1`.
+ *
+ * @tparam A A contiguous range of `float`, `double` or a `std::complex` of either.
+ * @tparam B A contiguous range of the same type.
+ * @tparam Out A contiguous range of the same type.
+ * @param a The first operand.
+ * @param b The second operand.
+ * @param out The range receiving the `size(a) + size(b) - 1` values of the correlation.
+ * @throw std::invalid_argument if an operand is empty or `out` is too small.
+ */
+template <std::ranges::contiguous_range A, std::ranges::contiguous_range B, std::ranges::contiguous_range Out,
+          typename U = std::ranges::range_value_t<A>>
+  requires detail::is_fft_element<U>::value && std::is_same_v<std::ranges::range_value_t<B>, U> &&
+           std::is_same_v<std::ranges::range_value_t<Out>, U>
+void correlate(A const &a, B const &b, Out &&out) {
+  (void)detail::full_size(std::ranges::size(a), std::ranges::size(b), std::ranges::size(out));
+  detail::correlate_n(std::ranges::data(a), std::ranges::size(a), std::ranges::data(b), std::ranges::size(b),
+                      std::ranges::data(out));
+}
+
+/**
+ * @brief Computes the full linear convolution of two vectors.
+ *
+ * @tparam U The element type, floating point or complex.
+ * @tparam N The length of the first vector.
+ * @tparam M The length of the second vector.
+ * @param a The first operand.
+ * @param b The second operand.
+ * @return The `N + M - 1` values of the convolution.
+ */
+template <typename U, std::size_t N, std::size_t M>
+  requires detail::is_fft_element<U>::value && (N > 0) && (M > 0)
+[[nodiscard]] vector<U, N + M - 1> convolve(vector<U, N> const &a, vector<U, M> const &b) {
+  vector<U, N + M - 1> result;
+  detail::convolve_n(a.data(), N, b.data(), M, result.data());
+  return result;
+}
+
+/**
+ * @brief Computes the full cross-correlation of two vectors, as in the range overload.
+ *
+ * @tparam U The element type, floating point or complex.
+ * @tparam N The length of the first vector.
+ * @tparam M The length of the second vector.
+ * @param a The first operand.
+ * @param b The second operand.
+ * @return The `N + M - 1` values of the correlation, for the lags `1 - M` to `N - 1`.
+ */
+template <typename U, std::size_t N, std::size_t M>
+  requires detail::is_fft_element<U>::value && (N > 0) && (M > 0)
+[[nodiscard]] vector<U, N + M - 1> correlate(vector<U, N> const &a, vector<U, M> const &b) {
+  vector<U, N + M - 1> result;
+  detail::correlate_n(a.data(), N, b.data(), M, result.data());
+  return result;
+}
+
+} // namespace firefly
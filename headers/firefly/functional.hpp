@@ -0,0 +1,275 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "firefly/detail/kernels.hpp"
+#include "firefly/math.hpp"
+#include "firefly/vector.hpp"
+
+namespace firefly {
+
+namespace detail {
+
+/// @brief Maps every type of a pack to `T`, used to repeat a type once per pack element.
+template <typename T, typename>
+using repeat_t = T;
+
+} // namespace detail
+
+/**
+ * @brief Variadic form of firefly::common_type, folding the promotion rules over every type in the pack.
+ *
+ * @tparam T First type
+ * @tparam Ts Remaining types
+ */
+template <typename T, typename... Ts>
+struct common_type_of {
+  /// @brief The resulting type when only one type is left.
+  using type = T;
+};
+
+/**
+ * @brief Recursive case of common_type_of, promoting the first two types and folding the rest.
+ *
+ * @tparam T1 First type
+ * @tparam T2 Second type
+ * @tparam Ts Remaining types
+ */
+template <typename T1, typename T2, typename... Ts>
+struct common_type_of<T1, T2, Ts...> : common_type_of<common_type_t<T1, T2>, Ts...> {};
+
+/**
+ * @brief Helper alias template for common_type_of.
+ *
+ * @tparam Ts Types to promote
+ */
+template <typename... Ts>
+using common_type_of_t = typename common_type_of<Ts...>::type;
+
+/**
+ * @brief Element-wise primitive operations for use with firefly::map and firefly::zip_with.
+ *
+ * Each operation is a stateless (or trivially stateful) function object whose call operator is small enough to be
+ * inlined into the element loop, so chains built with ops::compose vectorise as a single loop.
+ */
+namespace ops {
+
+/// @brief Element-wise sum.
+struct plus {
+  template <typename T>
+  constexpr auto operator()(T const &a, T const &b) const {
+    return a + b;
+  }
+};
+
+/// @brief Element-wise difference.
+struct minus {
+  template <typename T>
+  constexpr auto operator()(T const &a, T const &b) const {
+    return a - b;
+  }
+};
+
+/// @brief Element-wise (Hadamard) product.
+struct multiplies {
+  template <typename T>
+  constexpr auto operator()(T const &a, T const &b) const {
+    return a * b;
+  }
+};
+
+/// @brief Element-wise quotient.
+struct divides {
+  template <typename T>
+  constexpr auto operator()(T const &a, T const &b) const {
+    return a / b;
+  }
+};
+
+/// @brief Element-wise negation.
+struct negate {
+  template <typename T>
+  constexpr auto operator()(T const &a) const {
+    return -a;
+  }
+};
+
+/// @brief Element-wise absolute value. Complex elements yield their modulus.
+struct abs {
+  template <typename T>
+  constexpr auto operator()(T const &a) const {
+    if constexpr (is_complex_v<T>) {
+      return std::abs(a);
+    } else if constexpr (std::is_unsigned_v<T>) {
+      return a;
+    } else {
+      return a < T(0) ? T(-a) : a;
+    }
+  }
+};
+
+/// @brief Element-wise square root.
+struct sqrt {
+  template <typename T>
+  constexpr auto operator()(T const &a) const {
+    if constexpr (is_complex_v<T>) {
+      return std::sqrt(a);
+    } else {
+      return math::sqrt(a);
+    }
+  }
+};
+
+/// @brief Element-wise natural exponential.
+struct exp {
+  template <typename T>
+  auto operator()(T const &a) const {
+    return std::exp(a);
+  }
+};
+
+/// @brief Element-wise minimum, returning the first argument when the arguments compare equal.
+struct min {
+  template <typename T>
+  constexpr auto operator()(T const &a, T const &b) const {
+    return b < a ? b : a;
+  }
+};
+
+/// @brief Element-wise maximum, returning the first argument when the arguments compare equal.
+struct max {
+  template <typename T>
+  constexpr auto operator()(T const &a, T const &b) const {
+    return a < b ? b : a;
+  }
+};
+
+/**
+ * @brief Element-wise clamp to the closed interval [lo, hi].
+ *
+ * @tparam T The type of the bounds.
+ */
+template <typename T>
+struct clamp {
+  /// @brief Lower bound of the interval.
+  T lo;
+  /// @brief Upper bound of the interval.
+  T hi;
+
+  template <typename U>
+  constexpr auto operator()(U const &a) const {
+    using R = common_type_t<U, T>;
+    return std::clamp(R(a), R(lo), R(hi));
+  }
+};
+
+/**
+ * @brief Function object that applies a chain of operations, the right-most first.
+ *
+ * `compose(f, g, h)(args...)` evaluates `f(g(h(args...)))` without materialising any intermediate vector.
+ *
+ * @tparam Fs The operation types.
+ */
+template <typename... Fs>
+struct composed {
+  /// @brief The composed operations, in call order from outermost to innermost.
+  std::tuple<Fs...> fs;
+
+  template <typename... Args>
+  constexpr auto operator()(Args const &...args) const {
+    return apply<0>(args...);
+  }
+
+private:
+  template <std::size_t I, typename... Args>
+  constexpr auto apply(Args const &...args) const {
+    if constexpr (I + 1 == sizeof...(Fs)) {
+      return std::get<I>(fs)(args...);
+    } else {
+      return std::get<I>(fs)(apply<I + 1>(args...));
+    }
+  }
+};
+
+/**
+ * @brief Composes element-wise operations into a single operation.
+ *
+ * @tparam Fs The operation types.
+ * @param fs The operations, outermost first.
+ * @return A function object that evaluates the chain for one element.
+ */
+template <typename... Fs>
+[[nodiscard]] constexpr auto compose(Fs... fs) {
+  static_assert(sizeof...(Fs) > 0, "At least one operation is required.");
+  return composed<Fs...>{std::tuple<Fs...>(std::move(fs)...)};
+}
+
+} // namespace ops
+
+/**
+ * @brief Applies an operation element-wise over one or more vectors.
+ *
+ * Every element is first promoted to the common type of all the vectors (using firefly::common_type), so the rules
+ * match the built-in operators. The result element type is whatever the operation returns for promoted arguments.
+ * The whole operation, including the promotion, runs in one loop over the storage.
+ *
+ * @tparam F The operation type.
+ * @tparam T The element type of the first vector.
+ * @tparam Length The number of elements in each vector.
+ * @tparam Ts The element types of the remaining vectors.
+ * @param f The operation, invoked with one promoted element from each vector.
+ * @param v The first vector.
+ * @param vs The remaining vectors.
+ * @return A new vector holding the result of the operation for each element.
+ */
+template <typename F, vector_type T, std::size_t Length, vector_type... Ts>
+[[nodiscard]] constexpr auto map(F const &f, firefly::vector<T, Length> const &v,
+                                 firefly::vector<Ts, Length> const &...vs) {
+  using R = common_type_of_t<T, Ts...>;
+  using Out = std::remove_cvref_t<std::invoke_result_t<F const &, R, detail::repeat_t<R, Ts>...>>;
+  static_assert(vector_type<Out>, "The operation must return an arithmetic or complex type.");
+
+  firefly::vector<Out, Length> result;
+  if constexpr (sizeof...(Ts) == 0) {
+    detail::unary_n<R>(v.data(), result.data(), Length, f);
+  } else if constexpr (sizeof...(Ts) == 1) {
+    detail::binary_n<R>(v.data(), vs.data()..., result.data(), Length, f);
+  } else {
+    for (std::size_t i = 0; i < Length; ++i) {
+      result[i] = f(detail::element_cast<R>(v[i]), detail::element_cast<R>(vs[i])...);
+    }
+  }
+  return result;
+}
+
+/**
+ * @brief Combines two or more vectors element-wise with an operation.
+ *
+ * This is firefly::map restricted to at least two inputs, for readability at call sites such as
+ * `zip_with(ops::compose(ops::clamp<double>{lo, hi}, ops::abs{}, ops::multiplies{}), a, b)`.
+ *
+ * @tparam F The operation type.
+ * @tparam T The element type of the first vector.
+ * @tparam U The element type of the second vector.
+ * @tparam Length The number of elements in each vector.
+ * @tparam Ts The element types of the remaining vectors.
+ * @param f The operation, invoked with one promoted element from each vector.
+ * @param a The first vector.
+ * @param b The second vector.
+ * @param rest The remaining vectors.
+ * @return A new vector holding the result of the operation for each element.
+ */
+template <typename F, vector_type T, vector_type U, std::size_t Length, vector_type... Ts>
+[[nodiscard]] constexpr auto zip_with(F const &f, firefly::vector<T, Length> const &a,
+                                      firefly::vector<U, Length> const &b, firefly::vector<Ts, Length> const &...rest) {
+  return map(f, a, b, rest...);
+}
+
+} // namespace firefly
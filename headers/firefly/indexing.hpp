@@ -0,0 +1,220 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+
+#include "firefly/detail/kernels.hpp"
+#include "firefly/vector.hpp"
+
+namespace firefly {
+
+/**
+ * @brief Number of elements from which gather and scatter switch to the prefetching path.
+ *
+ * Short index lists are handled by a plain loop that the compiler can turn into hardware gather instructions
+ * (e.g. `vpgatherdd` with AVX2). Long index lists usually walk a buffer that does not fit in cache, where software
+ * prefetching a few elements ahead hides more latency than a gather instruction can.
+ */
+inline constexpr std::size_t gather_prefetch_threshold = 256;
+
+namespace detail {
+
+/// @brief How many elements ahead of the current one the prefetching path requests.
+inline constexpr std::size_t prefetch_distance = 16;
+
+/**
+ * @brief Issues a read or write prefetch hint for `address`, if the compiler supports it.
+ *
+ * @tparam Write Whether the address is about to be written.
+ * @param address The address to prefetch.
+ */
+template <bool Write>
+constexpr void prefetch(void const *address) {
+#if defined(__GNUC__) || defined(__clang__)
+  if (!std::is_constant_evaluated()) {
+    __builtin_prefetch(address, Write ? 1 : 0);
+  }
+#else
+  (void)address;
+#endif
+}
+
+/**
+ * @brief Validates that every index lies in [0, size).
+ *
+ * @throws std::out_of_range if any index is negative or not less than `size`.
+ */
+template <typename I, std::size_t Length>
+constexpr void check_indices(firefly::vector<I, Length> const &indices, std::size_t size) {
+  if constexpr (Length > 0) {
+    if constexpr (std::is_signed_v<I>) {
+      if (indices.min() < 0) {
+        throw std::out_of_range("Index must not be negative");
+      }
+    }
+    if (static_cast<std::size_t>(indices.max()) >= size) {
+      throw std::out_of_range("Index exceeds buffer size");
+    }
+  }
+}
+
+} // namespace detail
+
+/**
+ * @brief Builds a vector from the elements of a buffer at the given indices.
+ *
+ * `result[i] = buffer[indices[i]]`. The indices are validated once up front, so the copy loop itself has no branches.
+ *
+ * @tparam Buffer A contiguous range of arithmetic or complex elements.
+ * @tparam I The integral index type.
+ * @tparam Length The number of elements to gather.
+ * @param buffer The buffer to read from.
+ * @param indices The positions in the buffer to read.
+ * @throws std::out_of_range if an index is outside the buffer.
+ * @return A new vector holding the gathered elements.
+ */
+template <std::ranges::contiguous_range Buffer, std::integral I, std::size_t Length>
+  requires vector_type<std::ranges::range_value_t<Buffer>>
+[[nodiscard]] constexpr auto gather(Buffer const &buffer, firefly::vector<I, Length> const &indices) {
+  using T = std::ranges::range_value_t<Buffer>;
+  detail::check_indices(indices, std::ranges::size(buffer));
+
+  auto const *source = std::ranges::data(buffer);
+  firefly::vector<T, Length> result;
+  if constexpr (Length < gather_prefetch_threshold) {
+    for (std::size_t i = 0; i < Length; ++i) {
+      result[i] = source[indices[i]];
+    }
+  } else {
+    for (std::size_t i = 0; i < Length; ++i) {
+      if (i + detail::prefetch_distance < Length) {
+        detail::prefetch<false>(source + indices[i + detail::prefetch_distance]);
+      }
+      result[i] = source[indices[i]];
+    }
+  }
+  return result;
+}
+
+/**
+ * @brief Writes the elements of a vector into a buffer at the given indices.
+ *
+ * `buffer[indices[i]] = vector[i]`, converting to the buffer's element type. When an index repeats, the element with
+ * the highest position in the vector wins.
+ *
+ * @tparam T The type of elements in the vector.
+ * @tparam I The integral index type.
+ * @tparam Length The number of elements to scatter.
+ * @tparam Buffer A contiguous range of arithmetic or complex elements.
+ * @param vector The elements to write.
+ * @param indices The positions in the buffer to write.
+ * @param buffer The buffer to write to.
+ * @throws std::out_of_range if an index is outside the buffer. Nothing is written in that case.
+ */
+template <vector_type T, std::integral I, std::size_t Length, std::ranges::contiguous_range Buffer>
+  requires vector_type<std::ranges::range_value_t<Buffer>>
+constexpr void scatter(firefly::vector<T, Length> const &vector, firefly::vector<I, Length> const &indices,
+                       Buffer &&buffer) {
+  using B = std::ranges::range_value_t<Buffer>;
+  detail::check_indices(indices, std::ranges::size(buffer));
+
+  auto *target = std::ranges::data(buffer);
+  for (std::size_t i = 0; i < Length; ++i) {
+    if constexpr (Length >= gather_prefetch_threshold) {
+      if (i + detail::prefetch_distance < Length) {
+        detail::prefetch<true>(target + indices[i + detail::prefetch_distance]);
+      }
+    }
+    target[indices[i]] = detail::element_cast<B>(vector[i]);
+  }
+}
+
+/**
+ * @brief Accumulates the elements of a vector into a buffer at the given indices.
+ *
+ * `buffer[indices[i]] += vector[i]`. Repeated indices accumulate every contribution, in order of position.
+ *
+ * @tparam T The type of elements in the vector.
+ * @tparam I The integral index type.
+ * @tparam Length The number of elements to scatter.
+ * @tparam Buffer A contiguous range of arithmetic or complex elements.
+ * @param vector The elements to accumulate.
+ * @param indices The positions in the buffer to update.
+ * @param buffer The buffer to update.
+ * @throws std::out_of_range if an index is outside the buffer. Nothing is written in that case.
+ */
+template <vector_type T, std::integral I, std::size_t Length, std::ranges::contiguous_range Buffer>
+  requires vector_type<std::ranges::range_value_t<Buffer>>
+constexpr void scatter_add(firefly::vector<T, Length> const &vector, firefly::vector<I, Length> const &indices,
+                           Buffer &&buffer) {
+  using B = std::ranges::range_value_t<Buffer>;
+  using R = common_type_t<B, T>;
+  detail::check_indices(indices, std::ranges::size(buffer));
+
+  auto *target = std::ranges::data(buffer);
+  for (std::size_t i = 0; i < Length; ++i) {
+    if constexpr (Length >= gather_prefetch_threshold) {
+      if (i + detail::prefetch_distance < Length) {
+        detail::prefetch<true>(target + indices[i + detail::prefetch_distance]);
+      }
+    }
+    auto &slot = target[indices[i]];
+    slot = detail::element_cast<B>(detail::element_cast<R>(slot) + detail::element_cast<R>(vector[i]));
+  }
+}
+
+/**
+ * @brief Reorders the elements of a vector, `result[i] = vector[permutation[i]]`.
+ *
+ * The permutation does not have to be a bijection; repeated positions duplicate elements.
+ *
+ * @tparam T The type of elements in the vector.
+ * @tparam I The integral index type.
+ * @tparam Length The number of elements.
+ * @param vector The vector to reorder.
+ * @param permutation The source position of every element of the result.
+ * @throws std::out_of_range if a position is outside the vector.
+ * @return A new vector holding the reordered elements.
+ */
+template <vector_type T, std::integral I, std::size_t Length>
+[[nodiscard]] constexpr auto permute(firefly::vector<T, Length> const &vector,
+                                     firefly::vector<I, Length> const &permutation) {
+  detail::check_indices(permutation, Length);
+
+  firefly::vector<T, Length> result;
+  for (std::size_t i = 0; i < Length; ++i) {
+    result[i] = vector[permutation[i]];
+  }
+  return result;
+}
+
+/**
+ * @brief Computes the inverse of a permutation, so that `permute(permute(v, p), inverse_permutation(p)) == v`.
+ *
+ * @tparam I The integral index type.
+ * @tparam Length The number of elements.
+ * @param permutation A bijection of [0, Length).
+ * @throws std::out_of_range if a position is outside [0, Length).
+ * @throws std::invalid_argument if a position repeats.
+ * @return The inverse permutation.
+ */
+template <std::integral I, std::size_t Length>
+[[nodiscard]] constexpr auto inverse_permutation(firefly::vector<I, Length> const &permutation) {
+  detail::check_indices(permutation, Length);
+
+  firefly::vector<I, Length> inverse;
+  mask<Length> seen;
+  for (std::size_t i = 0; i < Length; ++i) {
+    if (seen[permutation[i]]) {
+      throw std::invalid_argument("Permutation must not repeat positions");
+    }
+    seen[permutation[i]] = true;
+    inverse[permutation[i]] = static_cast<I>(i);
+  }
+  return inverse;
+}
+
+} // namespace firefly
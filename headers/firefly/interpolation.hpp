@@ -0,0 +1,424 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "firefly/detail/parallel.hpp"
+#include "firefly/math.hpp"
+#include "firefly/vector.hpp"
+
+namespace firefly {
+
+namespace detail {
+
+/// @brief Number of pairs whose slerp weights are computed together before the vectors are combined.
+inline constexpr std::size_t slerp_chunk = 256;
+
+/// @brief Angle below which slerp falls back to lerp, as the arc is indistinguishable from the chord.
+inline constexpr double slerp_min_angle = 1e-4;
+
+/**
+ * @brief Element type of the firefly::vector values of the range `R`.
+ */
+template <typename R>
+using batch_scalar_t = typename std::ranges::range_value_t<R>::value_type;
+
+/**
+ * @brief Checks that `R` is a contiguous range of floating point firefly::vector of type `V`.
+ */
+template <typename R, typename V>
+concept vector_range_of = std::ranges::contiguous_range<R> && std::is_same_v<std::ranges::range_value_t<R>, V> &&
+                          is_vector_v<V> && std::floating_point<typename V::value_type>;
+
+/**
+ * @brief Checks the sizes of the ranges of a batched interpolation.
+ *
+ * @throw std::invalid_argument if `b` or `out` is smaller than `a`.
+ */
+inline std::size_t interpolation_size(std::size_t a, std::size_t b, std::size_t out) {
+  if (b < a || out < a) {
+    throw std::invalid_argument("Second and output ranges must be at least as large as the first range");
+  }
+  return a;
+}
+
+/**
+ * @brief Computes `out[i] = a[i] + t_i (b[i] - a[i])` for `i` in `[begin, end)`.
+ *
+ * The update is one subtraction and one multiply-add per element, which the compiler contracts into an FMA when the
+ * target supports it. The result is written element by element after reading both inputs, so `out` may alias `a` or
+ * `b`.
+ */
+template <typename V, typename TAt>
+void lerp_n(V const *a, V const *b, V *out, std::size_t begin, std::size_t end, TAt t_at) {
+  using T = typename V::value_type;
+  for (std::size_t i = begin; i < end; ++i) {
+    T const t = t_at(i);
+    for (std::size_t d = 0; d < vector_length_v<V>; ++d) {
+      out[i][d] = a[i][d] + t * (b[i][d] - a[i][d]);
+    }
+  }
+}
+
+/**
+ * @brief Linear interpolation followed by normalisation. Results of zero length are left as the zero vector.
+ */
+template <typename V, typename TAt>
+void nlerp_n(V const *a, V const *b, V *out, std::size_t begin, std::size_t end, TAt t_at) {
+  using T = typename V::value_type;
+  for (std::size_t i = begin; i < end; ++i) {
+    T const t = t_at(i);
+    T squared = T(0);
+    for (std::size_t d = 0; d < vector_length_v<V>; ++d) {
+      T const value = a[i][d] + t * (b[i][d] - a[i][d]);
+      out[i][d] = value;
+      squared += value * value;
+    }
+    T const scale = squared > T(0) ? T(1) / std::sqrt(squared) : T(0);
+    for (std::size_t d = 0; d < vector_length_v<V>; ++d) {
+      out[i][d] *= scale;
+    }
+  }
+}
+
+/**
+ * @brief Spherical linear interpolation of the pairs `[begin, end)`.
+ *
+ * Works a chunk at a time: the angle of every pair is found first, then the weights `sin((1 - t)θ) / sin θ` and
+ * `sin(tθ) / sin θ` are computed with the vectorised math::sincos kernel, and a final loop combines the vectors.
+ */
+template <typename V, typename TAt>
+void slerp_n(V const *a, V const *b, V *out, std::size_t begin, std::size_t end, TAt t_at) {
+  using T = typename V::value_type;
+  T theta[slerp_chunk];
+  T weight_a[slerp_chunk];
+  T weight_b[slerp_chunk];
+  for (std::size_t chunk = begin; chunk < end; chunk += slerp_chunk) {
+    std::size_t const count = std::min(slerp_chunk, end - chunk);
+    for (std::size_t i = 0; i < count; ++i) {
+      V const &x = a[chunk + i];
+      V const &y = b[chunk + i];
+      T dot = T(0), xx = T(0), yy = T(0);
+      for (std::size_t d = 0; d < vector_length_v<V>; ++d) {
+        dot += x[d] * y[d];
+        xx += x[d] * x[d];
+        yy += y[d] * y[d];
+      }
+      T const denominator = std::sqrt(xx * yy);
+      T const cosine = denominator > T(0) ? std::clamp(dot / denominator, T(-1), T(1)) : T(1);
+      theta[i] = std::acos(cosine);
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+      T const t = t_at(chunk + i);
+      T sin_theta, sin_a, sin_b, unused;
+      math::detail::sincos_kernel(theta[i], sin_theta, unused);
+      math::detail::sincos_kernel((T(1) - t) * theta[i], sin_a, unused);
+      math::detail::sincos_kernel(t * theta[i], sin_b, unused);
+      bool const chord = sin_theta < T(slerp_min_angle);
+      T const inverse = chord ? T(1) : T(1) / sin_theta;
+      weight_a[i] = chord ? T(1) - t : sin_a * inverse;
+      weight_b[i] = chord ? t : sin_b * inverse;
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+      for (std::size_t d = 0; d < vector_length_v<V>; ++d) {
+        out[chunk + i][d] = weight_a[i] * a[chunk + i][d] + weight_b[i] * b[chunk + i][d];
+      }
+    }
+  }
+}
+
+/**
+ * @brief Runs an interpolation kernel over a batch with a shared parameter.
+ */
+template <typename Kernel, typename As, typename Bs, typename Out, typename T>
+void interpolate(Kernel kernel, As const &as, Bs const &bs, T const t, Out &out, std::size_t threads) {
+  std::size_t const n = interpolation_size(std::ranges::size(as), std::ranges::size(bs), std::ranges::size(out));
+  auto const *a = std::ranges::data(as);
+  auto const *b = std::ranges::data(bs);
+  auto *target = std::ranges::data(out);
+  parallel_for_ranges(n, threads, [&](std::size_t begin, std::size_t end) {
+    kernel(a, b, target, begin, end, [t](std::size_t) { return t; });
+  });
+}
+
+/**
+ * @brief Runs an interpolation kernel over a batch with one parameter per pair.
+ *
+ * @throw std::invalid_argument if the parameter range is smaller than the first range.
+ */
+template <typename Kernel, typename As, typename Bs, typename Ts, typename Out>
+void interpolate_each(Kernel kernel, As const &as, Bs const &bs, Ts const &ts, Out &out, std::size_t threads) {
+  std::size_t const n = interpolation_size(std::ranges::size(as), std::ranges::size(bs), std::ranges::size(out));
+  if (std::ranges::size(ts) < n) {
+    throw std::invalid_argument("Parameter range must be at least as large as the first range");
+  }
+  auto const *a = std::ranges::data(as);
+  auto const *b = std::ranges::data(bs);
+  auto const *t = std::ranges::data(ts);
+  auto *target = std::ranges::data(out);
+  parallel_for_ranges(n, threads, [&](std::size_t begin, std::size_t end) {
+    kernel(a, b, target, begin, end, [t](std::size_t i) { return t[i]; });
+  });
+}
+
+} // namespace detail
+
+/**
+ * @brief Linearly interpolates every pair of a batch with a shared parameter, `out[i] = a[i] + t (b[i] - a[i])`.
+ *
+ * @tparam As A contiguous range of `vector<T, Length>` with a floating point `T`.
+ * @tparam Bs A contiguous range of the same vector type.
+ * @tparam Out A contiguous range of the same vector type.
+ * @param as The vectors at `t = 0`.
+ * @param bs The vectors at `t = 1`.
+ * @param t The interpolation parameter.
+ * @param out The range receiving the results. It may alias `as` or `bs`.
+ * @param threads The number of threads, zero for the hardware concurrency.
+ * @throw std::invalid_argument if `bs` or `out` is smaller than `as`.
+ */
+template <std::ranges::contiguous_range As, typename Bs, typename Out, typename V = std::ranges::range_value_t<As>>
+  requires detail::vector_range_of<As, V> && detail::vector_range_of<Bs, V> && detail::vector_range_of<Out, V>
+void lerp(As const &as, Bs const &bs, detail::batch_scalar_t<As> const t, Out &&out, std::size_t const threads = 1) {
+  detail::interpolate([](auto... args) { detail::lerp_n(args...); }, as, bs, t, out, threads);
+}
+
+/**
+ * @brief Linearly interpolates every pair of a batch with its own parameter, `out[i] = a[i] + t[i] (b[i] - a[i])`.
+ *
+ * @tparam As A contiguous range of `vector<T, Length>` with a floating point `T`.
+ * @tparam Bs A contiguous range of the same vector type.
+ * @tparam Ts A contiguous range of `T`.
+ * @tparam Out A contiguous range of the same vector type.
+ * @param as The vectors at `t = 0`.
+ * @param bs The vectors at `t = 1`.
+ * @param ts The interpolation parameter of each pair.
+ * @param out The range receiving the results. It may alias `as` or `bs`.
+ * @param threads The number of threads, zero for the hardware concurrency.
+ * @throw std::invalid_argument if `bs`, `ts` or `out` is smaller than `as`.
+ */
+template <std::ranges::contiguous_range As, typename Bs, std::ranges::contiguous_range Ts, typename Out,
+          typename V = std::ranges::range_value_t<As>>
+  requires detail::vector_range_of<As, V> && detail::vector_range_of<Bs, V> && detail::vector_range_of<Out, V> &&
+           std::is_same_v<std::ranges::range_value_t<Ts>, detail::batch_scalar_t<As>>
+void lerp(As const &as, Bs const &bs, Ts const &ts, Out &&out, std::size_t const threads = 1) {
+  detail::interpolate_each([](auto... args) { detail::lerp_n(args...); }, as, bs, ts, out, threads);
+}
+
+/**
+ * @brief Normalised linear interpolation of every pair of a batch with a shared parameter.
+ *
+ * A cheap approximation of slerp for directions: the result has unit length and moves along the same arc, but not at
+ * constant angular velocity. Results of zero length stay zero.
+ *
+ * @tparam As A contiguous range of `vector<T, Length>` with a floating point `T`.
+ * @tparam Bs A contiguous range of the same vector type.
+ * @tparam Out A contiguous range of the same vector type.
+ * @param as The vectors at `t = 0`.
+ * @param bs The vectors at `t = 1`.
+ * @param t The interpolation parameter.
+ * @param out The range receiving the results. It may alias `as` or `bs`.
+ * @param threads The number of threads, zero for the hardware concurrency.
+ * @throw std::invalid_argument if `bs` or `out` is smaller than `as`.
+ */
+template <std::ranges::contiguous_range As, typename Bs, typename Out, typename V = std::ranges::range_value_t<As>>
+  requires detail::vector_range_of<As, V> && detail::vector_range_of<Bs, V> && detail::vector_range_of<Out, V>
+void nlerp(As const &as, Bs const &bs, detail::batch_scalar_t<As> const t, Out &&out, std::size_t const threads = 1) {
+  detail::interpolate([](auto... args) { detail::nlerp_n(args...); }, as, bs, t, out, threads);
+}
+
+/**
+ * @brief Normalised linear interpolation of every pair of a batch with its own parameter.
+ *
+ * @tparam As A contiguous range of `vector<T, Length>` with a floating point `T`.
+ * @tparam Bs A contiguous range of the same vector type.
+ * @tparam Ts A contiguous range of `T`.
+ * @tparam Out A contiguous range of the same vector type.
+ * @param as The vectors at `t = 0`.
+ * @param bs The vectors at `t = 1`.
+ * @param ts The interpolation parameter of each pair.
+ * @param out The range receiving the results. It may alias `as` or `bs`.
+ * @param threads The number of threads, zero for the hardware concurrency.
+ * @throw std::invalid_argument if `bs`, `ts` or `out` is smaller than `as`.
+ */
+template <std::ranges::contiguous_range As, typename Bs, std::ranges::contiguous_range Ts, typename Out,
+          typename V = std::ranges::range_value_t<As>>
+  requires detail::vector_range_of<As, V> && detail::vector_range_of<Bs, V> && detail::vector_range_of<Out, V> &&
+           std::is_same_v<std::ranges::range_value_t<Ts>, detail::batch_scalar_t<As>>
+void nlerp(As const &as, Bs const &bs, Ts const &ts, Out &&out, std::size_t const threads = 1) {
+  detail::interpolate_each([](auto... args) { detail::nlerp_n(args...); }, as, bs, ts, out, threads);
+}
+
+/**
+ * @brief Spherical linear interpolation of every pair of a batch with a shared parameter.
+ *
+ * Moves along the great arc between the two vectors at constant angular velocity, so unit inputs give unit results.
+ * Pairs closer than a small angle fall back to lerp. Exactly opposite vectors have no unique arc and also fall back to
+ * lerp.
+ *
+ * @tparam As A contiguous range of `vector<T, Length>` with a floating point `T`.
+ * @tparam Bs A contiguous range of the same vector type.
+ * @tparam Out A contiguous range of the same vector type.
+ * @param as The vectors at `t = 0`.
+ * @param bs The vectors at `t = 1`.
+ * @param t The interpolation parameter.
+ * @param out The range receiving the results. It may alias `as` or `bs`.
+ * @param threads The number of threads, zero for the hardware concurrency.
+ * @throw std::invalid_argument if `bs` or `out` is smaller than `as`.
+ */
+template <std::ranges::contiguous_range As, typename Bs, typename Out, typename V = std::ranges::range_value_t<As>>
+  requires detail::vector_range_of<As, V> && detail::vector_range_of<Bs, V> && detail::vector_range_of<Out, V>
+void slerp(As const &as, Bs const &bs, detail::batch_scalar_t<As> const t, Out &&out, std::size_t const threads = 1) {
+  detail::interpolate([](auto... args) { detail::slerp_n(args...); }, as, bs, t, out, threads);
+}
+
+/**
+ * @brief Spherical linear interpolation of every pair of a batch with its own parameter.
+ *
+ * @tparam As A contiguous range of `vector<T, Length>` with a floating point `T`.
+ * @tparam Bs A contiguous range of the same vector type.
+ * @tparam Ts A contiguous range of `T`.
+ * @tparam Out A contiguous range of the same vector type.
+ * @param as The vectors at `t = 0`.
+ * @param bs The vectors at `t = 1`.
+ * @param ts The interpolation parameter of each pair.
+ * @param out The range receiving the results. It may alias `as` or `bs`.
+ * @param threads The number of threads, zero for the hardware concurrency.
+ * @throw std::invalid_argument if `bs`, `ts` or `out` is smaller than `as`.
+ */
+template <std::ranges::contiguous_range As, typename Bs, std::ranges::contiguous_range Ts, typename Out,
+          typename V = std::ranges::range_value_t<As>>
+  requires detail::vector_range_of<As, V> && detail::vector_range_of<Bs, V> && detail::vector_range_of<Out, V> &&
+           std::is_same_v<std::ranges::range_value_t<Ts>, detail::batch_scalar_t<As>>
+void slerp(As const &as, Bs const &bs, Ts const &ts, Out &&out, std::size_t const threads = 1) {
+  detail::interpolate_each([](auto... args) { detail::slerp_n(args...); }, as, bs, ts, out, threads);
+}
+
+/**
+ * @class keyframe_track
+ * @brief A sequence of keyframes, vectors at increasing times, sampled by linear interpolation.
+ *
+ * Single samples binary-search for their segment. Runs of samples at increasing times search once for the first
+ * sample and then advance through the segments, so streaming a whole animation costs one search.
+ *
+ * @tparam T The floating point type of the times and vector elements.
+ * @tparam Length The number of elements of the vectors.
+ */
+template <std::floating_point T, std::size_t Length>
+class keyframe_track {
+public:
+  using value_type = vector<T, Length>;
+
+  /**
+   * @brief Constructor from keyframe times and values.
+   *
+   * @param times The time of each keyframe, strictly increasing.
+   * @param values The value of each keyframe.
+   * @throw std::invalid_argument if there are no keyframes, the sizes differ or the times are not strictly increasing.
+   */
+  [[nodiscard]] keyframe_track(std::vector<T> times, std::vector<value_type> values)
+      : _times(std::move(times)), _values(std::move(values)) {
+    if (_times.empty() || _times.size() != _values.size()) {
+      throw std::invalid_argument("Keyframe track needs the same non-zero number of times and values");
+    }
+    _inverse_spans.resize(_times.size() - 1);
+    for (std::size_t i = 0; i + 1 < _times.size(); ++i) {
+      if (!(_times[i] < _times[i + 1])) {
+        throw std::invalid_argument("Keyframe times must be strictly increasing");
+      }
+      _inverse_spans[i] = T(1) / (_times[i + 1] - _times[i]);
+    }
+  }
+
+  /**
+   * @brief Returns the number of keyframes.
+   */
+  [[nodiscard]] std::size_t size() const {
+    return _times.size();
+  }
+
+  /**
+   * @brief Returns the keyframe times.
+   */
+  [[nodiscard]] std::span<T const> times() const {
+    return _times;
+  }
+
+  /**
+   * @brief Returns the keyframe values.
+   */
+  [[nodiscard]] std::span<value_type const> values() const {
+    return _values;
+  }
+
+  /**
+   * @brief Samples the track at a time.
+   *
+   * @param time The sample time. Times outside the track are clamped to the first or last keyframe.
+   * @return The interpolated value.
+   */
+  [[nodiscard]] value_type sample(T const time) const {
+    return evaluate(segment(time), time);
+  }
+
+  /**
+   * @brief Samples the track at the evenly spaced times `start + i * step`, one per element of `out`.
+   *
+   * @tparam Out A contiguous range of `vector<T, Length>`.
+   * @param start The time of the first sample.
+   * @param step The time between samples, non-negative.
+   * @param out The range receiving the samples.
+   * @throw std::invalid_argument if `step` is negative.
+   */
+  template <std::ranges::contiguous_range Out>
+    requires std::is_same_v<std::ranges::range_value_t<Out>, value_type>
+  void sample(T const start, T const step, Out &&out) const {
+    if (step < T(0)) {
+      throw std::invalid_argument("Sampling step must not be negative");
+    }
+    std::size_t const n = std::ranges::size(out);
+    auto *target = std::ranges::data(out);
+    std::size_t current = segment(start);
+    for (std::size_t i = 0; i < n; ++i) {
+      T const time = start + T(i) * step;
+      while (current + 2 < _times.size() && _times[current + 1] <= time) {
+        ++current;
+      }
+      target[i] = evaluate(current, time);
+    }
+  }
+
+private:
+  std::vector<T> _times;
+  std::vector<value_type> _values;
+  std::vector<T> _inverse_spans;
+
+  std::size_t segment(T const time) const {
+    if (_times.size() < 2) {
+      return 0;
+    }
+    auto const upper = std::upper_bound(_times.begin() + 1, _times.end() - 1, time);
+    return std::size_t(upper - _times.begin()) - 1;
+  }
+
+  value_type evaluate(std::size_t const index, T const time) const {
+    if (_times.size() < 2) {
+      return _values[0];
+    }
+    T const u = std::clamp((time - _times[index]) * _inverse_spans[index], T(0), T(1));
+    value_type result;
+    for (std::size_t d = 0; d < Length; ++d) {
+      result[d] = _values[index][d] + u * (_values[index + 1][d] - _values[index][d]);
+    }
+    return result;
+  }
+};
+
+} // namespace firefly
@@ -0,0 +1,448 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "firefly/detail/parallel.hpp"
+#include "firefly/linalg.hpp"
+#include "firefly/vector.hpp"
+
+namespace firefly {
+
+namespace detail {
+
+/// @brief Number of points assigned together, so that every centroid is loaded once per tile of points.
+inline constexpr std::size_t kmeans_tile = 64;
+
+} // namespace detail
+
+/**
+ * @class kmeans
+ * @brief Clusters vectors into `k` groups with Lloyd's algorithm, k-means++ seeding and mini-batch updates.
+ *
+ * Distances to the centroids are computed as `|x|² - 2x·c + |c|²`, with the centroid norms computed once per iteration,
+ * so each point–centroid pair costs one dot product. Points are assigned a tile at a time with the centroids in the
+ * outer loop, so each centroid is read once per tile while the tile of points stays in cache. Every thread accumulates
+ * the sums and counts of its own range of points, and the partial accumulators are combined in thread order, so results
+ * only depend on the seed and the number of threads. The seeding draws directly from the bits of `std::mt19937_64`
+ * rather than through the standard distributions, so it is the same with every standard library.
+ *
+ * With pruning enabled, fit() keeps Hamerly's bounds for every point: an upper bound on the distance to its centroid
+ * and a lower bound on the distance to every other centroid. Points whose bounds show that the assignment cannot
+ * change skip the distance computations; up to rounding, the assignments are the same as without pruning.
+ *
+ * @tparam T The floating point type of the elements.
+ * @tparam Length The number of elements of the vectors.
+ */
+template <std::floating_point T, std::size_t Length>
+class kmeans {
+public:
+  using value_type = vector<T, Length>;
+
+  /**
+   * @brief Constructor that sets the number of clusters and the seed of the k-means++ sampling.
+   *
+   * @param clusters The number of clusters.
+   * @param seed The seed of the random number generator.
+   * @throw std::invalid_argument if the number of clusters is zero.
+   */
+  explicit kmeans(std::size_t const clusters, std::uint64_t const seed = 0) : _clusters(clusters), _random(seed) {
+    if (clusters == 0) {
+      throw std::invalid_argument("Number of clusters must not be zero");
+    }
+  }
+
+  /**
+   * @brief Seeds the centroids with k-means++ and runs Lloyd iterations until no assignment changes.
+   *
+   * @tparam Points A contiguous range of `vector<T, Length>`.
+   * @param points The points to cluster.
+   * @param max_iterations The maximum number of assignment passes.
+   * @param threads The number of threads, zero for the hardware concurrency.
+   * @param prune Whether to skip distance computations with Hamerly's bounds.
+   * @throw std::invalid_argument if there are fewer points than clusters.
+   */
+  template <std::ranges::contiguous_range Points>
+    requires std::is_same_v<std::ranges::range_value_t<Points>, value_type>
+  void fit(Points const &points, std::size_t const max_iterations = 100, std::size_t const threads = 1,
+           bool const prune = true) {
+    value_type const *x = std::ranges::data(points);
+    std::size_t const n = std::ranges::size(points);
+    seed(x, n, threads);
+
+    _labels.assign(n, 0);
+    std::vector<T> upper(n, T(0));
+    std::vector<T> lower(n, T(0));
+    std::vector<T> shift(_clusters, T(0));
+    std::vector<T> separation(_clusters, T(0));
+    T max_shift = T(0);
+
+    _iterations = 0;
+    while (_iterations < max_iterations) {
+      update_norms();
+      if (prune && _iterations > 0) {
+        update_separation(separation);
+      }
+      bool const full = !prune || _iterations == 0;
+      accumulator const totals = combine(n, threads, [&](std::size_t begin, std::size_t end, accumulator &acc) {
+        std::size_t previous[detail::kmeans_tile];
+        for (std::size_t first = begin; first < end; first += detail::kmeans_tile) {
+          std::size_t const count = std::min(detail::kmeans_tile, end - first);
+          std::copy_n(_labels.data() + first, count, previous);
+          if (full) {
+            assign(x + first, count, _labels.data() + first, upper.data() + first, lower.data() + first);
+          } else {
+            for (std::size_t i = first; i < first + count; ++i) {
+              std::size_t const label = _labels[i];
+              upper[i] += shift[label];
+              lower[i] -= max_shift;
+              T const bound = std::max(lower[i], separation[label]);
+              if (upper[i] > bound) {
+                upper[i] = std::sqrt(distance(x[i], label));
+                if (upper[i] > bound) {
+                  assign(x + i, 1, _labels.data() + i, upper.data() + i, lower.data() + i);
+                }
+              }
+            }
+          }
+          for (std::size_t j = 0; j < count; ++j) {
+            acc.changed += _labels[first + j] != previous[j];
+            acc.add(x[first + j], _labels[first + j]);
+          }
+        }
+      });
+      ++_iterations;
+
+      max_shift = T(0);
+      for (std::size_t c = 0; c < _clusters; ++c) {
+        value_type const previous = _centroids[c];
+        if (totals.counts[c] > 0) {
+          T const inverse = T(1) / T(totals.counts[c]);
+          for (std::size_t d = 0; d < Length; ++d) {
+            _centroids[c][d] = totals.sums[c * Length + d] * inverse;
+          }
+        }
+        shift[c] = std::sqrt(squared_difference(previous, _centroids[c]));
+        max_shift = std::max(max_shift, shift[c]);
+        _counts[c] = totals.counts[c];
+      }
+      if (_iterations > 1 && totals.changed == 0) {
+        break;
+      }
+    }
+    update_norms();
+    _inertia = inertia(x, n, threads);
+  }
+
+  /**
+   * @brief Updates the centroids with one mini-batch of points.
+   *
+   * The points are assigned in parallel, then every centroid moves towards its points with a per-centroid learning
+   * rate of one over the number of points it has seen, as in Sculley's mini-batch k-means. The first batch seeds the
+   * centroids with k-means++ when the model has not been fitted yet.
+   *
+   * @tparam Points A contiguous range of `vector<T, Length>`.
+   * @param batch The points of the mini-batch.
+   * @param threads The number of threads, zero for the hardware concurrency.
+   * @throw std::invalid_argument if the model is not seeded yet and the batch has fewer points than clusters.
+   */
+  template <std::ranges::contiguous_range Points>
+    requires std::is_same_v<std::ranges::range_value_t<Points>, value_type>
+  void partial_fit(Points const &batch, std::size_t const threads = 1) {
+    value_type const *x = std::ranges::data(batch);
+    std::size_t const n = std::ranges::size(batch);
+    if (_centroids.empty()) {
+      seed(x, n, threads);
+    }
+    std::vector<std::size_t> labels(n);
+    predict(batch, labels, threads);
+    for (std::size_t i = 0; i < n; ++i) {
+      std::size_t const c = labels[i];
+      T const rate = T(1) / T(++_counts[c]);
+      for (std::size_t d = 0; d < Length; ++d) {
+        _centroids[c][d] += rate * (x[i][d] - _centroids[c][d]);
+      }
+    }
+    update_norms();
+  }
+
+  /**
+   * @brief Assigns every point to its nearest centroid.
+   *
+   * @tparam Points A contiguous range of `vector<T, Length>`.
+   * @tparam Labels A contiguous range of `std::size_t`.
+   * @param points The points to assign.
+   * @param labels The range receiving the cluster of every point.
+   * @param threads The number of threads, zero for the hardware concurrency.
+   * @throw std::logic_error if the model has no centroids yet.
+   * @throw std::invalid_argument if `labels` is smaller than `points`.
+   */
+  template <std::ranges::contiguous_range Points, std::ranges::contiguous_range Labels>
+    requires std::is_same_v<std::ranges::range_value_t<Points>, value_type> &&
+             std::is_same_v<std::ranges::range_value_t<Labels>, std::size_t>
+  void predict(Points const &points, Labels &&labels, std::size_t const threads = 1) const {
+    if (_centroids.empty()) {
+      throw std::logic_error("Cannot assign points before the centroids are seeded");
+    }
+    std::size_t const n = std::ranges::size(points);
+    if (std::ranges::size(labels) < n) {
+      throw std::invalid_argument("Label range must be at least as large as the point range");
+    }
+    value_type const *x = std::ranges::data(points);
+    std::size_t *target = std::ranges::data(labels);
+    detail::parallel_for_ranges(n, threads, [&](std::size_t begin, std::size_t end) {
+      T upper[detail::kmeans_tile];
+      T lower[detail::kmeans_tile];
+      for (std::size_t first = begin; first < end; first += detail::kmeans_tile) {
+        assign(x + first, std::min(detail::kmeans_tile, end - first), target + first, upper, lower);
+      }
+    });
+  }
+
+  /**
+   * @brief Returns the number of clusters.
+   */
+  [[nodiscard]] std::size_t clusters() const {
+    return _clusters;
+  }
+
+  /**
+   * @brief Returns the centroids, empty before the model is seeded.
+   */
+  [[nodiscard]] std::span<value_type const> centroids() const {
+    return _centroids;
+  }
+
+  /**
+   * @brief Returns the cluster of every point of the last call to fit().
+   */
+  [[nodiscard]] std::span<std::size_t const> labels() const {
+    return _labels;
+  }
+
+  /**
+   * @brief Returns the sum of squared distances of the points of the last call to fit() to their centroids.
+   */
+  [[nodiscard]] T inertia() const {
+    return _inertia;
+  }
+
+  /**
+   * @brief Returns the number of assignment passes of the last call to fit().
+   */
+  [[nodiscard]] std::size_t iterations() const {
+    return _iterations;
+  }
+
+private:
+  /**
+   * @brief Per-thread sums and counts of the points of every cluster.
+   */
+  struct accumulator {
+    std::vector<T> sums;
+    std::vector<std::size_t> counts;
+    std::size_t changed = 0;
+
+    explicit accumulator(std::size_t const clusters) : sums(clusters * Length, T(0)), counts(clusters, 0) {}
+
+    void add(value_type const &x, std::size_t const c) {
+      T *sum = sums.data() + c * Length;
+      for (std::size_t d = 0; d < Length; ++d) {
+        sum[d] += x[d];
+      }
+      ++counts[c];
+    }
+
+    void merge(accumulator const &other) {
+      for (std::size_t i = 0; i < sums.size(); ++i) {
+        sums[i] += other.sums[i];
+      }
+      for (std::size_t c = 0; c < counts.size(); ++c) {
+        counts[c] += other.counts[c];
+      }
+      changed += other.changed;
+    }
+  };
+
+  std::size_t _clusters;
+  std::mt19937_64 _random;
+  std::vector<value_type> _centroids;
+  std::vector<T> _norms;
+  std::vector<std::size_t> _counts;
+  std::vector<std::size_t> _labels;
+  T _inertia = T(0);
+  std::size_t _iterations = 0;
+
+  static T squared_difference(value_type const &a, value_type const &b) {
+    T sum = T(0);
+    for (std::size_t d = 0; d < Length; ++d) {
+      T const diff = a[d] - b[d];
+      sum += diff * diff;
+    }
+    return sum;
+  }
+
+  /**
+   * @brief Runs `f(begin, end, accumulator)` over one range of points per thread, each with its own accumulator, and
+   * combines the accumulators in thread order.
+   */
+  template <typename F>
+  accumulator combine(std::size_t const n, std::size_t const threads, F const &f) const {
+    std::size_t const workers = detail::resolve_threads(threads, n);
+    std::vector<accumulator> partial(workers, accumulator(_clusters));
+    detail::parallel_for(workers, workers, [&](std::size_t worker) {
+      f(n * worker / workers, n * (worker + 1) / workers, partial[worker]);
+    });
+    for (std::size_t worker = 1; worker < workers; ++worker) {
+      partial[0].merge(partial[worker]);
+    }
+    return std::move(partial[0]);
+  }
+
+  void update_norms() {
+    _norms.resize(_clusters);
+    for (std::size_t c = 0; c < _clusters; ++c) {
+      _norms[c] = detail::dot_n(_centroids[c].data(), _centroids[c].data(), Length);
+    }
+  }
+
+  /**
+   * @brief Computes half the distance from every centroid to its nearest other centroid.
+   */
+  void update_separation(std::vector<T> &separation) const {
+    std::fill(separation.begin(), separation.end(), std::numeric_limits<T>::infinity());
+    for (std::size_t a = 0; a < _clusters; ++a) {
+      for (std::size_t b = a + 1; b < _clusters; ++b) {
+        T const half = T(0.5) * std::sqrt(squared_difference(_centroids[a], _centroids[b]));
+        separation[a] = std::min(separation[a], half);
+        separation[b] = std::min(separation[b], half);
+      }
+    }
+  }
+
+  /**
+   * @brief Squared distance between a point and a centroid with the norm trick, clamped at zero.
+   */
+  T distance(value_type const &x, std::size_t const c) const {
+    T const dot = detail::dot_n(x.data(), _centroids[c].data(), Length);
+    return std::max(detail::dot_n(x.data(), x.data(), Length) - T(2) * dot + _norms[c], T(0));
+  }
+
+  /**
+   * @brief Finds the nearest centroid of `count <= kmeans_tile` consecutive points, with the distances to the nearest
+   * and the second nearest centroid.
+   *
+   * The centroids are the outer loop: each one is dotted with every point of the tile before the next is loaded.
+   */
+  void assign(value_type const *x, std::size_t const count, std::size_t *labels, T *upper, T *lower) const {
+    T best[detail::kmeans_tile];
+    T second[detail::kmeans_tile];
+    std::fill_n(best, count, std::numeric_limits<T>::infinity());
+    std::fill_n(second, count, std::numeric_limits<T>::infinity());
+    std::fill_n(labels, count, std::size_t(0));
+    for (std::size_t c = 0; c < _clusters; ++c) {
+      T const *centroid = _centroids[c].data();
+      for (std::size_t p = 0; p < count; ++p) {
+        T const d = _norms[c] - T(2) * detail::dot_n(x[p].data(), centroid, Length);
+        if (d < best[p]) {
+          second[p] = best[p];
+          best[p] = d;
+          labels[p] = c;
+        } else if (d < second[p]) {
+          second[p] = d;
+        }
+      }
+    }
+    for (std::size_t p = 0; p < count; ++p) {
+      T const norm = detail::dot_n(x[p].data(), x[p].data(), Length);
+      upper[p] = std::sqrt(std::max(best[p] + norm, T(0)));
+      lower[p] = std::sqrt(std::max(second[p] + norm, T(0)));
+    }
+  }
+
+  /**
+   * @brief Draws a uniform index in `[0, n)` by rejecting the engine outputs below `2^64 mod n` and reducing the rest
+   * modulo `n`.
+   *
+   * The standard distributions are not specified bit for bit, so they would make the seeding depend on the standard
+   * library. The output of `std::mt19937_64` is fixed by the standard, and so is everything derived from it here.
+   */
+  std::size_t draw_index(std::size_t const n) {
+    std::uint64_t const threshold = (std::uint64_t(0) - std::uint64_t(n)) % std::uint64_t(n);
+    std::uint64_t bits = _random();
+    while (bits < threshold) {
+      bits = _random();
+    }
+    return std::size_t(bits % std::uint64_t(n));
+  }
+
+  /**
+   * @brief Draws a uniform double in `[0, 1)` from the top 53 bits of one engine output.
+   */
+  double draw_unit() {
+    return double(_random() >> 11) * 0x1p-53;
+  }
+
+  /**
+   * @brief Picks the initial centroids with k-means++: every new centroid is drawn with probability proportional to
+   * the squared distance to the nearest centroid already chosen.
+   */
+  void seed(value_type const *x, std::size_t const n, std::size_t const threads) {
+    if (n < _clusters) {
+      throw std::invalid_argument("Need at least as many points as clusters");
+    }
+    _centroids.assign(1, x[draw_index(n)]);
+    _counts.assign(_clusters, 0);
+    std::vector<T> nearest(n, std::numeric_limits<T>::infinity());
+    while (_centroids.size() < _clusters) {
+      value_type const &latest = _centroids.back();
+      detail::parallel_for_ranges(n, threads, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+          nearest[i] = std::min(nearest[i], squared_difference(x[i], latest));
+        }
+      });
+      double total = 0;
+      for (T const d : nearest) {
+        total += double(d);
+      }
+      std::size_t chosen = 0;
+      if (total > 0) {
+        double target = draw_unit() * total;
+        for (chosen = 0; chosen + 1 < n && target >= double(nearest[chosen]); ++chosen) {
+          target -= double(nearest[chosen]);
+        }
+      } else {
+        chosen = draw_index(n);
+      }
+      _centroids.push_back(x[chosen]);
+    }
+    update_norms();
+  }
+
+  T inertia(value_type const *x, std::size_t const n, std::size_t const threads) const {
+    std::size_t const workers = detail::resolve_threads(threads, n);
+    std::vector<T> partial(workers, T(0));
+    detail::parallel_for(workers, workers, [&](std::size_t worker) {
+      for (std::size_t i = n * worker / workers; i < n * (worker + 1) / workers; ++i) {
+        partial[worker] += squared_difference(x[i], _centroids[_labels[i]]);
+      }
+    });
+    T total = T(0);
+    for (T const value : partial) {
+      total += value;
+    }
+    return total;
+  }
+};
+
+} // namespace firefly
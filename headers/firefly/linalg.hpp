@@ -0,0 +1,240 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "firefly/detail/kernels.hpp"
+#include "firefly/detail/parallel.hpp"
+#include "firefly/vector.hpp"
+
+namespace firefly {
+
+/**
+ * @brief Variants of the Gram–Schmidt process used by orthonormalize() and qr().
+ */
+enum class gram_schmidt {
+  /// @brief Modified Gram–Schmidt: every new basis vector is projected out of the remaining vectors right away.
+  modified,
+  /// @brief Block Gram–Schmidt: blocks of vectors are projected against the finished basis with one block of dot
+  /// products, and orthonormalised among themselves with modified Gram–Schmidt.
+  blocked,
+};
+
+namespace detail {
+
+/// @brief Number of vectors orthonormalised together by block Gram–Schmidt.
+inline constexpr std::size_t gram_schmidt_block = 16;
+
+/// @brief Number of basis vectors whose dot products with a vector are computed while it stays in cache.
+inline constexpr std::size_t gram_schmidt_tile = 8;
+
+/**
+ * @brief Dot product of two arrays of `n` elements, with the multi-accumulator loop of reduce_n.
+ */
+template <typename T>
+[[nodiscard]] T dot_n(T const *a, T const *b, std::size_t const n) {
+  return reduce_n(a, b, n, T(0), [](T const x, T const y) { return x * y; }, std::plus<>());
+}
+
+/**
+ * @brief Computes `y -= alpha * x` over `n` elements.
+ */
+template <typename T>
+void subtract_scaled_n(T const alpha, T const *x, T *y, std::size_t const n) {
+  for (std::size_t i = 0; i < n; ++i) {
+    y[i] -= alpha * x[i];
+  }
+}
+
+/**
+ * @brief Bookkeeping shared by the Gram–Schmidt variants: the vectors being orthonormalised, the R factor and the
+ * norms of the input vectors.
+ */
+template <typename T, std::size_t Length>
+struct gram_schmidt_state {
+  vector<T, Length> *v;
+  std::size_t count;
+  std::vector<T> r;
+  std::vector<T> input_norm;
+
+  gram_schmidt_state(vector<T, Length> *vectors, std::size_t const n)
+      : v(vectors), count(n), r(n * n, T(0)), input_norm(n) {
+    for (std::size_t j = 0; j < n; ++j) {
+      input_norm[j] = std::sqrt(dot_n(v[j].data(), v[j].data(), Length));
+    }
+  }
+
+  T &coefficient(std::size_t const row, std::size_t const col) {
+    return r[row * count + col];
+  }
+
+  /**
+   * @brief Projects the basis vectors `[first, last)` out of vector `j` one at a time, adding the coefficients to R.
+   */
+  void project_sequential(std::size_t const first, std::size_t const last, std::size_t const j) {
+    for (std::size_t i = first; i < last; ++i) {
+      T const c = dot_n(v[i].data(), v[j].data(), Length);
+      subtract_scaled_n(c, v[i].data(), v[j].data(), Length);
+      coefficient(i, j) += c;
+    }
+  }
+
+  /**
+   * @brief Normalises vector `j` into the basis and stores its norm on the diagonal of R.
+   *
+   * @throw std::logic_error if nothing is left of the vector, relative to its input norm.
+   */
+  void normalize(std::size_t const j) {
+    T const norm = std::sqrt(dot_n(v[j].data(), v[j].data(), Length));
+    T const tolerance = T(8 * Length) * std::numeric_limits<T>::epsilon() * input_norm[j];
+    if (!(norm > tolerance)) {
+      throw std::logic_error("Cannot orthonormalize linearly dependent vectors");
+    }
+    coefficient(j, j) = norm;
+    T const scale = T(1) / norm;
+    for (std::size_t d = 0; d < Length; ++d) {
+      v[j][d] *= scale;
+    }
+  }
+};
+
+/**
+ * @brief Right-looking modified Gram–Schmidt: once vector `j` is in the basis, it is projected out of every remaining
+ * vector, which runs in parallel over the remaining vectors.
+ */
+template <typename T, std::size_t Length>
+void modified_gram_schmidt(gram_schmidt_state<T, Length> &state, bool const reorthogonalize,
+                           std::size_t const threads) {
+  for (std::size_t j = 0; j < state.count; ++j) {
+    if (reorthogonalize) {
+      state.project_sequential(0, j, j);
+    }
+    state.normalize(j);
+    std::size_t const rest = state.count - j - 1;
+    parallel_for_ranges(rest, threads, [&](std::size_t begin, std::size_t end) {
+      for (std::size_t c = j + 1 + begin; c < j + 1 + end; ++c) {
+        T const r = dot_n(state.v[j].data(), state.v[c].data(), Length);
+        subtract_scaled_n(r, state.v[j].data(), state.v[c].data(), Length);
+        state.coefficient(j, c) += r;
+      }
+    });
+  }
+}
+
+/**
+ * @brief Block Gram–Schmidt. Each block is first projected against the finished basis with classical Gram–Schmidt,
+ * all dot products of a tile of basis vectors being computed before any vector is updated, then orthonormalised
+ * internally with modified Gram–Schmidt. With reorthogonalisation every projection runs twice, which keeps the basis
+ * orthogonal to working precision.
+ */
+template <typename T, std::size_t Length>
+void blocked_gram_schmidt(gram_schmidt_state<T, Length> &state, bool const reorthogonalize, std::size_t const threads) {
+  std::size_t const passes = reorthogonalize ? 2 : 1;
+  for (std::size_t j0 = 0; j0 < state.count; j0 += gram_schmidt_block) {
+    std::size_t const j1 = std::min(j0 + gram_schmidt_block, state.count);
+
+    for (std::size_t pass = 0; pass < passes && j0 > 0; ++pass) {
+      parallel_for_ranges(j1 - j0, threads, [&](std::size_t begin, std::size_t end) {
+        std::size_t const width = end - begin;
+        std::vector<T> coefficients(width * j0);
+        // Every tile of basis vectors is reused for all the vectors of this thread while it is in cache.
+        for (std::size_t i0 = 0; i0 < j0; i0 += gram_schmidt_tile) {
+          std::size_t const i1 = std::min(i0 + gram_schmidt_tile, j0);
+          for (std::size_t c = 0; c < width; ++c) {
+            for (std::size_t i = i0; i < i1; ++i) {
+              coefficients[c * j0 + i] = dot_n(state.v[i].data(), state.v[j0 + begin + c].data(), Length);
+            }
+          }
+        }
+        for (std::size_t i0 = 0; i0 < j0; i0 += gram_schmidt_tile) {
+          std::size_t const i1 = std::min(i0 + gram_schmidt_tile, j0);
+          for (std::size_t c = 0; c < width; ++c) {
+            for (std::size_t i = i0; i < i1; ++i) {
+              subtract_scaled_n(coefficients[c * j0 + i], state.v[i].data(), state.v[j0 + begin + c].data(), Length);
+              state.coefficient(i, j0 + begin + c) += coefficients[c * j0 + i];
+            }
+          }
+        }
+      });
+    }
+
+    for (std::size_t j = j0; j < j1; ++j) {
+      for (std::size_t pass = 0; pass < passes; ++pass) {
+        state.project_sequential(j0, j, j);
+      }
+      state.normalize(j);
+    }
+  }
+}
+
+} // namespace detail
+
+/**
+ * @brief Orthonormalises a set of vectors in place and returns the R factor.
+ *
+ * On return, `vectors` holds an orthonormal basis `Q` spanning the same nested subspaces as the input, and the input
+ * is `A = QR` with `R` upper triangular with a positive diagonal. Classical Gram–Schmidt loses orthogonality quickly;
+ * modified Gram–Schmidt is stable up to the conditioning of the input, and reorthogonalisation makes both variants
+ * orthogonal to working precision at twice the cost.
+ *
+ * @tparam Vectors A contiguous range of `vector<T, Length>` with a floating point `T`.
+ * @param vectors The vectors to orthonormalise, the columns of `A`.
+ * @param method The Gram–Schmidt variant.
+ * @param reorthogonalize Whether every projection is repeated once.
+ * @param threads The number of threads, zero for the hardware concurrency.
+ * @throw std::invalid_argument if there are more vectors than their Length.
+ * @throw std::logic_error if the vectors are linearly dependent to working precision.
+ * @return The `k × k` R factor in row-major order, where `k` is the number of vectors.
+ */
+template <std::ranges::contiguous_range Vectors, typename V = std::ranges::range_value_t<Vectors>,
+          typename T = typename V::value_type>
+  requires detail::is_vector_v<V> && std::floating_point<T>
+std::vector<T> orthonormalize(Vectors &&vectors, gram_schmidt const method = gram_schmidt::blocked,
+                              bool const reorthogonalize = true, std::size_t const threads = 1) {
+  constexpr std::size_t Length = detail::vector_length_v<V>;
+  std::size_t const count = std::ranges::size(vectors);
+  if (count > Length) {
+    throw std::invalid_argument("Cannot orthonormalize more vectors than their Length");
+  }
+  detail::gram_schmidt_state<T, Length> state(std::ranges::data(vectors), count);
+  if (method == gram_schmidt::modified) {
+    detail::modified_gram_schmidt(state, reorthogonalize, threads);
+  } else {
+    detail::blocked_gram_schmidt(state, reorthogonalize, threads);
+  }
+  return std::move(state.r);
+}
+
+/**
+ * @brief Computes the thin QR decomposition of a set of vectors with Gram–Schmidt.
+ *
+ * @tparam Vectors A sized range of `vector<T, Length>` with a floating point `T`.
+ * @param vectors The columns of `A`.
+ * @param method The Gram–Schmidt variant.
+ * @param reorthogonalize Whether every projection is repeated once.
+ * @param threads The number of threads, zero for the hardware concurrency.
+ * @throw std::invalid_argument if there are more vectors than their Length.
+ * @throw std::logic_error if the vectors are linearly dependent to working precision.
+ * @return A pair of the orthonormal vectors `Q` and the `k × k` R factor in row-major order.
+ */
+template <std::ranges::sized_range Vectors, typename V = std::ranges::range_value_t<Vectors>,
+          typename T = typename V::value_type>
+  requires detail::is_vector_v<V> && std::floating_point<T>
+[[nodiscard]] std::pair<std::vector<V>, std::vector<T>> qr(Vectors const &vectors,
+                                                           gram_schmidt const method = gram_schmidt::blocked,
+                                                           bool const reorthogonalize = true,
+                                                           std::size_t const threads = 1) {
+  std::vector<V> q(std::ranges::begin(vectors), std::ranges::end(vectors));
+  std::vector<T> r = orthonormalize(q, method, reorthogonalize, threads);
+  return {std::move(q), std::move(r)};
+}
+
+} // namespace firefly
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "firefly/detail/kernels.hpp"
+
+namespace firefly {
+
+/**
+ * @class mask
+ * @brief Element-wise boolean result of comparing vectors, used to select or update elements without branches.
+ *
+ * A mask is produced by the comparison members of firefly::vector (`lt`, `gt`, `approx_eq`, ...) and consumed by
+ * firefly::select and firefly::where.
+ *
+ * @tparam Length The number of elements in the mask.
+ */
+template <std::size_t Length>
+class mask : private std::array<bool, Length> {
+
+public:
+  using value_type = bool;
+  using std::array<bool, Length>::begin;
+  using std::array<bool, Length>::end;
+  using std::array<bool, Length>::cbegin;
+  using std::array<bool, Length>::cend;
+  using std::array<bool, Length>::size;
+  using std::array<bool, Length>::data;
+  using std::array<bool, Length>::operator[];
+
+  /**
+   * @brief Default constructor that clears every element of the mask.
+   */
+  [[nodiscard]] constexpr mask() : std::array<bool, Length>() {
+    std::fill(begin(), end(), false);
+  }
+
+  /**
+   * @brief Constructor that sets every element of the mask to the given value.
+   *
+   * @param value The value used for every element.
+   */
+  [[nodiscard]] constexpr explicit mask(bool const value) : std::array<bool, Length>() {
+    std::fill(begin(), end(), value);
+  }
+
+  /**
+   * @brief Constructor that initializes the mask using an initializer list.
+   *
+   * @param list An initializer list containing the elements of the mask.
+   * @throw std::out_of_range if the initializer list size exceeds the mask Length.
+   */
+  [[nodiscard]] constexpr mask(std::initializer_list<bool> const &list) : std::array<bool, Length>() {
+    if (list.size() > Length) {
+      throw std::out_of_range("Initializer list size must match mask Length");
+    }
+    std::fill(begin(), end(), false);
+    std::copy(list.begin(), list.end(), begin());
+  }
+
+  /**
+   * @brief Checks whether at least one element of the mask is set.
+   *
+   * @return `true` if any element is set, otherwise `false`.
+   */
+  [[nodiscard]] constexpr bool any() const {
+    return detail::reduce_n(data(), Length, false, std::identity(), std::logical_or<>());
+  }
+
+  /**
+   * @brief Checks whether every element of the mask is set.
+   *
+   * @return `true` if all elements are set, otherwise `false`. An empty mask returns `true`.
+   */
+  [[nodiscard]] constexpr bool all() const {
+    return detail::reduce_n(data(), Length, true, std::identity(), std::logical_and<>());
+  }
+
+  /**
+   * @brief Checks whether no element of the mask is set.
+   *
+   * @return `true` if no element is set, otherwise `false`.
+   */
+  [[nodiscard]] constexpr bool none() const {
+    return !any();
+  }
+
+  /**
+   * @brief Counts the set elements of the mask.
+   *
+   * @return The number of set elements.
+   */
+  [[nodiscard]] constexpr std::size_t count() const {
+    return detail::reduce_n(data(), Length, std::size_t(0), std::identity(), std::plus<>());
+  }
+
+  /**
+   * @brief Element-wise logical AND of two masks.
+   *
+   * @param other The mask to combine with.
+   * @return A new mask set where both masks are set.
+   */
+  [[nodiscard]] constexpr mask operator&(mask const &other) const {
+    mask result;
+    detail::binary_n<bool>(data(), other.data(), result.data(), Length, std::logical_and<>());
+    return result;
+  }
+
+  /**
+   * @brief Element-wise logical OR of two masks.
+   *
+   * @param other The mask to combine with.
+   * @return A new mask set where either mask is set.
+   */
+  [[nodiscard]] constexpr mask operator|(mask const &other) const {
+    mask result;
+    detail::binary_n<bool>(data(), other.data(), result.data(), Length, std::logical_or<>());
+    return result;
+  }
+
+  /**
+   * @brief Element-wise exclusive OR of two masks.
+   *
+   * @param other The mask to combine with.
+   * @return A new mask set where exactly one of the masks is set.
+   */
+  [[nodiscard]] constexpr mask operator^(mask const &other) const {
+    mask result;
+    detail::binary_n<bool>(data(), other.data(), result.data(), Length, std::not_equal_to<>());
+    return result;
+  }
+
+  /**
+   * @brief Element-wise logical NOT of the mask.
+   *
+   * @return A new mask set where this mask is clear.
+   */
+  [[nodiscard]] constexpr mask operator~() const {
+    mask result;
+    detail::unary_n<bool>(data(), result.data(), Length, std::logical_not<>());
+    return result;
+  }
+
+  /**
+   * @brief Compares two masks for equality.
+   *
+   * @param other The mask to compare with.
+   * @return `true` if every element matches, otherwise `false`.
+   */
+  [[nodiscard]] constexpr bool operator==(mask const &other) const {
+    return std::equal(cbegin(), cend(), other.cbegin());
+  }
+
+  /**
+   * @brief Converts the mask to a string representation in the format "[1, 0, ..., 1]".
+   *
+   * @return A string representation of the mask.
+   */
+  [[nodiscard]] std::string view() const {
+    std::stringstream ss;
+    ss << "[";
+    for (std::size_t i = 0; i < Length; ++i) {
+      ss << (i == 0 ? "" : ", ") << (*this)[i];
+    }
+    ss << "]";
+    return ss.str();
+  }
+
+  /**
+   * @brief Stream insertion operator for masks.
+   *
+   * @param os The output stream.
+   * @param other The mask to be output.
+   * @return The output stream with the mask representation.
+   */
+  friend std::ostream &operator<<(std::ostream &os, mask const &other) {
+    os << other.view();
+    return os;
+  }
+};
+
+} // namespace firefly
@@ -0,0 +1,543 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace firefly::math {
+
+/**
+ * @brief Floating point type used to evaluate a maths function for the argument type `T`.
+ *
+ * Integral arguments are promoted to `double`, mirroring the integral overloads of the `<cmath>` functions.
+ *
+ * @tparam T The argument type.
+ */
+template <typename T>
+using float_type_t = std::conditional_t<std::is_integral_v<T>, double, T>;
+
+namespace detail {
+
+/**
+ * @brief Working precision used by the compile-time implementations.
+ *
+ * `float` arguments are evaluated in `double` so that rounding the result back to `float` is correctly rounded in
+ * practically every case.
+ *
+ * @tparam T The floating point argument type.
+ */
+template <typename T>
+using working_type_t = std::conditional_t<std::is_same_v<T, long double>, long double, double>;
+
+template <typename T>
+constexpr bool is_nan(T x) {
+  return x != x;
+}
+
+template <typename T>
+constexpr bool is_inf(T x) {
+  return x == std::numeric_limits<T>::infinity() || x == -std::numeric_limits<T>::infinity();
+}
+
+/**
+ * @brief Square root using Newton-Raphson iteration on the range-reduced argument.
+ *
+ * The argument is scaled by powers of four into [0.25, 4) so that the iteration starting at 1 converges in a handful
+ * of steps, and the result is scaled back by the matching power of two.
+ */
+template <typename T>
+constexpr T sqrt(T x) {
+  if (is_nan(x) || x < 0) {
+    return std::numeric_limits<T>::quiet_NaN();
+  }
+  if (x == 0 || is_inf(x)) {
+    return x;
+  }
+
+  T scale = 1;
+  while (x >= 4) {
+    x /= 4;
+    scale *= 2;
+  }
+  while (x < T(0.25)) {
+    x *= 4;
+    scale /= 2;
+  }
+
+  T guess = 1;
+  for (int i = 0; i < 64; ++i) {
+    T next = (guess + x / guess) / 2;
+    if (next == guess) {
+      break;
+    }
+    guess = next;
+  }
+  return guess * scale;
+}
+
+/**
+ * @brief Computes `x mod y` exactly for a positive `y`, keeping the sign of `x`, by binary long division: every
+ * subtraction of `y * 2^k` from a remainder below `2 * y * 2^k` is exact.
+ */
+template <typename T>
+constexpr T exact_fmod(T x, T y) {
+  T a = x < 0 ? -x : x;
+  T d = y;
+  while (d <= a / 2) {
+    d *= 2;
+  }
+  for (; d >= y; d /= 2) {
+    if (a >= d) {
+      a -= d;
+    }
+  }
+  return x < 0 ? -a : a;
+}
+
+/**
+ * @brief Reduces `x` to `r` in [-pi/4, pi/4] and returns the quadrant `q` such that `x = q * pi/2 + r`.
+ *
+ * pi/2 is split into a high and a low part (Cody-Waite) so that the reduction stays accurate for moderate arguments.
+ * Arguments whose quadrant does not fit in 62 bits are first folded modulo `4 * pio2_hi`, which keeps the quadrant
+ * cast defined; the result is meaningless at that magnitude anyway.
+ */
+template <typename T>
+constexpr std::int64_t reduce_half_pi(T x, T &r) {
+  constexpr T pio2_hi = 1.57079632673412561417e+00;
+  constexpr T pio2_lo = 6.07710050650619224932e-11;
+  constexpr T two_over_pi = 6.36619772367581382433e-01;
+
+  T n = x * two_over_pi;
+  if (n >= T(0x1p62) || n <= -T(0x1p62)) {
+    x = exact_fmod(x, 4 * pio2_hi);
+    n = x * two_over_pi;
+  }
+  auto q = static_cast<std::int64_t>(n < 0 ? n - T(0.5) : n + T(0.5));
+  r = (x - T(q) * pio2_hi) - T(q) * pio2_lo;
+  return q;
+}
+
+template <typename T>
+constexpr T sin_kernel(T r) {
+  T r2 = r * r;
+  T term = r;
+  T sum = r;
+  for (int n = 1; n < 32; ++n) {
+    term *= -r2 / T((2 * n) * (2 * n + 1));
+    T next = sum + term;
+    if (next == sum) {
+      break;
+    }
+    sum = next;
+  }
+  return sum;
+}
+
+template <typename T>
+constexpr T cos_kernel(T r) {
+  T r2 = r * r;
+  T term = 1;
+  T sum = 1;
+  for (int n = 1; n < 32; ++n) {
+    term *= -r2 / T((2 * n - 1) * (2 * n));
+    T next = sum + term;
+    if (next == sum) {
+      break;
+    }
+    sum = next;
+  }
+  return sum;
+}
+
+template <typename T>
+constexpr T sin(T x) {
+  if (is_nan(x) || is_inf(x)) {
+    return std::numeric_limits<T>::quiet_NaN();
+  }
+
+  T r = 0;
+  switch (reduce_half_pi(x, r) & 3) {
+  case 0:
+    return sin_kernel(r);
+  case 1:
+    return cos_kernel(r);
+  case 2:
+    return -sin_kernel(r);
+  default:
+    return -cos_kernel(r);
+  }
+}
+
+template <typename T>
+constexpr T cos(T x) {
+  if (is_nan(x) || is_inf(x)) {
+    return std::numeric_limits<T>::quiet_NaN();
+  }
+
+  T r = 0;
+  switch (reduce_half_pi(x, r) & 3) {
+  case 0:
+    return cos_kernel(r);
+  case 1:
+    return -sin_kernel(r);
+  case 2:
+    return -cos_kernel(r);
+  default:
+    return sin_kernel(r);
+  }
+}
+
+/**
+ * @brief Arc tangent using argument reduction followed by the Maclaurin series.
+ *
+ * Arguments above 1 use `atan(x) = pi/2 - atan(1/x)` and arguments above tan(pi/12) use
+ * `atan(x) = pi/6 + atan((sqrt(3) x - 1) / (sqrt(3) + x))`, which keeps the series argument below 0.27.
+ */
+template <typename T>
+constexpr T atan(T x) {
+  if (is_nan(x)) {
+    return x;
+  }
+  if (x < 0) {
+    return -atan(-x);
+  }
+  if (is_inf(x)) {
+    return std::numbers::pi_v<T> / 2;
+  }
+  if (x > 1) {
+    return std::numbers::pi_v<T> / 2 - atan(1 / x);
+  }
+
+  constexpr T tan_pi_12 = 2.67949192431122706473e-01;
+  T offset = 0;
+  if (x > tan_pi_12) {
+    offset = std::numbers::pi_v<T> / 6;
+    x = (std::numbers::sqrt3_v<T> * x - 1) / (std::numbers::sqrt3_v<T> + x);
+  }
+
+  T x2 = x * x;
+  T power = x;
+  T sum = x;
+  for (int n = 1; n < 64; ++n) {
+    power *= -x2;
+    T next = sum + power / T(2 * n + 1);
+    if (next == sum) {
+      break;
+    }
+    sum = next;
+  }
+  return offset + sum;
+}
+
+template <typename T>
+constexpr T asin(T x) {
+  if (is_nan(x) || x < -1 || x > 1) {
+    return std::numeric_limits<T>::quiet_NaN();
+  }
+  if (x == 1 || x == -1) {
+    return x * std::numbers::pi_v<T> / 2;
+  }
+  return atan(x / sqrt((1 - x) * (1 + x)));
+}
+
+template <typename T>
+constexpr T acos(T x) {
+  if (is_nan(x) || x < -1 || x > 1) {
+    return std::numeric_limits<T>::quiet_NaN();
+  }
+  if (x == -1) {
+    return std::numbers::pi_v<T>;
+  }
+  return 2 * atan(sqrt((1 - x) / (1 + x)));
+}
+
+/**
+ * @brief Branch-free sine and cosine for `float` and `double`, written so that loops calling it vectorise.
+ *
+ * The argument is reduced by pi/2 with a three-part Cody-Waite split, rounding the quotient with the 1.5·2^p
+ * magic-number trick instead of a library call. Both Taylor polynomials are evaluated on the reduced argument and the
+ * quadrant picks and negates them with selects rather than a switch. Accuracy is within a few ULP for |x| up to about
+ * 1e5 and degrades gracefully beyond; NaN and infinite arguments give NaN.
+ */
+template <typename T>
+constexpr void sincos_kernel(T x, T &sine, T &cosine) {
+  constexpr bool is_float = std::is_same_v<T, float>;
+  constexpr T two_over_pi = T(6.36619772367581382433e-01);
+  constexpr T pio2_1 = is_float ? T(1.5703125) : T(1.57079625129699707031e+00);
+  constexpr T pio2_2 = is_float ? T(4.837512969970703125e-4) : T(7.54978941586159635336e-08);
+  constexpr T pio2_3 = is_float ? T(7.54978995489188216e-8) : T(5.39030285815811905290e-15);
+  constexpr T magic = is_float ? T(12582912.0) : T(6755399441055744.0);
+  constexpr T quadrant_limit = T(1 << 30);
+
+  T const n = (x * two_over_pi + magic) - magic;
+  auto const q = static_cast<std::int32_t>(n > -quadrant_limit && n < quadrant_limit ? n : T(0));
+  T const r = ((x - n * pio2_1) - n * pio2_2) - n * pio2_3;
+  T const r2 = r * r;
+
+  T s;
+  T c;
+  if constexpr (is_float) {
+    s = r + r * r2 * (T(-1.0 / 6) + r2 * (T(1.0 / 120) + r2 * (T(-1.0 / 5040) + r2 * T(1.0 / 362880))));
+    c = T(1) +
+        r2 * (T(-0.5) + r2 * (T(1.0 / 24) + r2 * (T(-1.0 / 720) + r2 * (T(1.0 / 40320) + r2 * T(-1.0 / 3628800)))));
+  } else {
+    T const ps = T(-1.0 / 6) +
+                 r2 * (T(1.0 / 120) +
+                       r2 * (T(-1.0 / 5040) +
+                             r2 * (T(1.0 / 362880) +
+                                   r2 * (T(-1.0 / 39916800) +
+                                         r2 * (T(1.0 / 6227020800) +
+                                               r2 * (T(-1.0 / 1307674368000) + r2 * T(1.0 / 355687428096000)))))));
+    T const pc = T(1.0 / 24) +
+                 r2 * (T(-1.0 / 720) +
+                       r2 * (T(1.0 / 40320) +
+                             r2 * (T(-1.0 / 3628800) +
+                                   r2 * (T(1.0 / 479001600) +
+                                         r2 * (T(-1.0 / 87178291200) + r2 * T(1.0 / 20922789888000))))));
+    s = r + r * r2 * ps;
+    c = T(1) - T(0.5) * r2 + r2 * r2 * pc;
+  }
+
+  T const swapped_sine = (q & 1) ? c : s;
+  T const swapped_cosine = (q & 1) ? s : c;
+  sine = (q & 2) ? -swapped_sine : swapped_sine;
+  cosine = ((q + 1) & 2) ? -swapped_cosine : swapped_cosine;
+}
+
+/**
+ * @brief Branch-free arc cosine for `float` and `double`, written so that loops calling it vectorise.
+ *
+ * Uses `acos(x) = pi/2 - asin(x)` for |x| <= 1/2 and `acos(|x|) = 2 asin(sqrt((1 - |x|) / 2))` above, with the asin
+ * polynomial of Cephes (float) or the rational approximation of fdlibm (double). Both branches are evaluated and the
+ * result is selected, so there are no data-dependent jumps. Arguments outside [-1, 1] give NaN.
+ */
+template <typename T>
+constexpr T acos_kernel(T x) {
+  constexpr T pi = std::numbers::pi_v<T>;
+  T const sign = x < T(0) ? T(-1) : T(1);
+  T const a = std::fabs(x);
+  bool const large = a > T(0.5);
+  T const half = (T(1) - a) * T(0.5);
+  T const root = std::is_constant_evaluated() ? sqrt(half) : std::sqrt(half);
+  T const z = large ? half : a * a;
+  T const s = large ? root : a;
+
+  T ratio;
+  if constexpr (std::is_same_v<T, float>) {
+    ratio = z * (T(1.6666752422e-1) +
+                 z * (T(7.4953002686e-2) +
+                      z * (T(4.5470025998e-2) + z * (T(2.4181311049e-2) + z * T(4.2163199048e-2)))));
+  } else {
+    T const p = z * (T(1.66666666666666657415e-01) +
+                     z * (T(-3.25565818622400915405e-01) +
+                          z * (T(2.01212532134862925881e-01) +
+                               z * (T(-4.00555345006794114027e-02) +
+                                    z * (T(7.91534994289814532176e-04) + z * T(3.47933107596021167570e-05))))));
+    T const q = T(1) + z * (T(-2.40339491173441421878e+00) +
+                            z * (T(2.02094576023350569471e+00) +
+                                 z * (T(-6.88283971605453293030e-01) + z * T(7.70381505559019352791e-02))));
+    ratio = p / q;
+  }
+  T const asin_s = s + s * ratio;
+
+  T const small_result = pi / T(2) - sign * asin_s;
+  T const large_result = (x < T(0) ? pi : T(0)) + sign * (T(2) * asin_s);
+  return large ? large_result : small_result;
+}
+
+} // namespace detail
+
+/**
+ * @brief Computes the square root of a number, usable in constant expressions.
+ *
+ * During constant evaluation the result is computed with a portable Newton-Raphson implementation, otherwise the
+ * call is forwarded to `std::sqrt`.
+ *
+ * @tparam T Arithmetic type of the argument. Integral types are promoted to `double`.
+ * @param x The value whose square root is computed.
+ * @return The square root of `x`, or NaN when `x` is negative.
+ */
+template <typename T>
+  requires std::is_arithmetic_v<T>
+[[nodiscard]] constexpr auto sqrt(T x) {
+  using F = float_type_t<T>;
+  if (std::is_constant_evaluated()) {
+    return static_cast<F>(detail::sqrt(static_cast<detail::working_type_t<F>>(x)));
+  }
+  return static_cast<F>(std::sqrt(static_cast<F>(x)));
+}
+
+/**
+ * @brief Computes the sine of an angle in radians, usable in constant expressions.
+ *
+ * During constant evaluation the result is computed with range reduction and a Taylor series, otherwise the call is
+ * forwarded to `std::sin`.
+ *
+ * @tparam T Arithmetic type of the argument. Integral types are promoted to `double`.
+ * @param x The angle in radians.
+ * @return The sine of `x`.
+ */
+template <typename T>
+  requires std::is_arithmetic_v<T>
+[[nodiscard]] constexpr auto sin(T x) {
+  using F = float_type_t<T>;
+  if (std::is_constant_evaluated()) {
+    return static_cast<F>(detail::sin(static_cast<detail::working_type_t<F>>(x)));
+  }
+  return static_cast<F>(std::sin(static_cast<F>(x)));
+}
+
+/**
+ * @brief Computes the cosine of an angle in radians, usable in constant expressions.
+ *
+ * During constant evaluation the result is computed with range reduction and a Taylor series, otherwise the call is
+ * forwarded to `std::cos`.
+ *
+ * @tparam T Arithmetic type of the argument. Integral types are promoted to `double`.
+ * @param x The angle in radians.
+ * @return The cosine of `x`.
+ */
+template <typename T>
+  requires std::is_arithmetic_v<T>
+[[nodiscard]] constexpr auto cos(T x) {
+  using F = float_type_t<T>;
+  if (std::is_constant_evaluated()) {
+    return static_cast<F>(detail::cos(static_cast<detail::working_type_t<F>>(x)));
+  }
+  return static_cast<F>(std::cos(static_cast<F>(x)));
+}
+
+/**
+ * @brief Computes the sine and cosine of an angle in radians together, usable in constant expressions.
+ *
+ * Both values share one range reduction, which makes this cheaper than calling `sin` and `cos` separately.
+ *
+ * @tparam T Floating point type of the argument, `float` or `double`.
+ * @param x The angle in radians.
+ * @return The pair (sin x, cos x).
+ */
+template <typename T>
+  requires std::is_same_v<T, float> || std::is_same_v<T, double>
+[[nodiscard]] constexpr std::pair<T, T> sincos(T x) {
+  T sine = 0;
+  T cosine = 0;
+  detail::sincos_kernel(x, sine, cosine);
+  return {sine, cosine};
+}
+
+/**
+ * @brief Computes the sine and cosine of every angle of a contiguous range.
+ *
+ * The loop is a straight-line polynomial evaluation without library calls, so the compiler vectorises it to the full
+ * SIMD width.
+ *
+ * @tparam Angles A contiguous range of `float` or `double`.
+ * @tparam Sines A contiguous range of the same type.
+ * @tparam Cosines A contiguous range of the same type.
+ * @param angles The angles in radians.
+ * @param sines The range receiving the sines.
+ * @param cosines The range receiving the cosines.
+ * @throw std::invalid_argument if `sines` or `cosines` is smaller than `angles`.
+ */
+template <std::ranges::contiguous_range Angles, std::ranges::contiguous_range Sines,
+          std::ranges::contiguous_range Cosines, typename T = std::ranges::range_value_t<Angles>>
+  requires(std::is_same_v<T, float> || std::is_same_v<T, double>) &&
+          std::is_same_v<std::ranges::range_value_t<Sines>, T> && std::is_same_v<std::ranges::range_value_t<Cosines>, T>
+void sincos(Angles const &angles, Sines &&sines, Cosines &&cosines) {
+  std::size_t const n = std::ranges::size(angles);
+  if (std::ranges::size(sines) < n || std::ranges::size(cosines) < n) {
+    throw std::invalid_argument("Output ranges must be at least as large as the angle range");
+  }
+  T const *in = std::ranges::data(angles);
+  T *sine = std::ranges::data(sines);
+  T *cosine = std::ranges::data(cosines);
+  for (std::size_t i = 0; i < n; ++i) {
+    detail::sincos_kernel(in[i], sine[i], cosine[i]);
+  }
+}
+
+/**
+ * @brief Computes the arc tangent of a number, usable in constant expressions.
+ *
+ * @tparam T Arithmetic type of the argument. Integral types are promoted to `double`.
+ * @param x The value whose arc tangent is computed.
+ * @return The arc tangent of `x` in the range [-pi/2, pi/2].
+ */
+template <typename T>
+  requires std::is_arithmetic_v<T>
+[[nodiscard]] constexpr auto atan(T x) {
+  using F = float_type_t<T>;
+  if (std::is_constant_evaluated()) {
+    return static_cast<F>(detail::atan(static_cast<detail::working_type_t<F>>(x)));
+  }
+  return static_cast<F>(std::atan(static_cast<F>(x)));
+}
+
+/**
+ * @brief Computes the arc sine of a number, usable in constant expressions.
+ *
+ * @tparam T Arithmetic type of the argument. Integral types are promoted to `double`.
+ * @param x The value whose arc sine is computed, in the range [-1, 1].
+ * @return The arc sine of `x` in the range [-pi/2, pi/2], or NaN when `x` is out of range.
+ */
+template <typename T>
+  requires std::is_arithmetic_v<T>
+[[nodiscard]] constexpr auto asin(T x) {
+  using F = float_type_t<T>;
+  if (std::is_constant_evaluated()) {
+    return static_cast<F>(detail::asin(static_cast<detail::working_type_t<F>>(x)));
+  }
+  return static_cast<F>(std::asin(static_cast<F>(x)));
+}
+
+/**
+ * @brief Computes the arc cosine of a number, usable in constant expressions.
+ *
+ * @tparam T Arithmetic type of the argument. Integral types are promoted to `double`.
+ * @param x The value whose arc cosine is computed, in the range [-1, 1].
+ * @return The arc cosine of `x` in the range [0, pi], or NaN when `x` is out of range.
+ */
+template <typename T>
+  requires std::is_arithmetic_v<T>
+[[nodiscard]] constexpr auto acos(T x) {
+  using F = float_type_t<T>;
+  if (std::is_constant_evaluated()) {
+    return static_cast<F>(detail::acos(static_cast<detail::working_type_t<F>>(x)));
+  }
+  return static_cast<F>(std::acos(static_cast<F>(x)));
+}
+
+/**
+ * @brief Computes the arc cosine of every value of a contiguous range.
+ *
+ * Uses a branch-free polynomial kernel instead of calling `std::acos`, so the compiler can vectorise the loop. The
+ * result is within a few ulp of `std::acos`.
+ *
+ * @tparam Values A contiguous range of `float` or `double`.
+ * @tparam Out A contiguous range of the same type.
+ * @param values The values, in [-1, 1].
+ * @param out The range receiving the angles in [0, pi]. It may alias `values`.
+ * @throw std::invalid_argument if `out` is smaller than `values`.
+ */
+template <std::ranges::contiguous_range Values, std::ranges::contiguous_range Out,
+          typename T = std::ranges::range_value_t<Values>>
+  requires(std::is_same_v<T, float> || std::is_same_v<T, double>) && std::is_same_v<std::ranges::range_value_t<Out>, T>
+void acos(Values const &values, Out &&out) {
+  std::size_t const n = std::ranges::size(values);
+  if (std::ranges::size(out) < n) {
+    throw std::invalid_argument("Output range must be at least as large as the input range");
+  }
+  T const *in = std::ranges::data(values);
+  T *result = std::ranges::data(out);
+  for (std::size_t i = 0; i < n; ++i) {
+    result[i] = detail::acos_kernel(in[i]);
+  }
+}
+
+} // namespace firefly::math
@@ -0,0 +1,524 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iomanip>
+#include <ostream>
+#include <ranges>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "firefly/detail/kernels.hpp"
+#include "firefly/detail/parallel.hpp"
+#include "firefly/vector.hpp"
+
+namespace firefly {
+
+/**
+ * @brief Storage order of the elements of a firefly::matrix.
+ */
+enum class layout {
+  /// @brief Elements of a row are contiguous.
+  row_major,
+  /// @brief Elements of a column are contiguous.
+  column_major,
+};
+
+/**
+ * @brief Number of multiply-adds from which matrix products switch to the cache-blocked kernel.
+ *
+ * Below this size every operand fits in the L1 cache and the plain register-blocked loops are fastest.
+ */
+inline constexpr std::size_t gemm_blocking_threshold = std::size_t(32) * 32 * 32;
+
+namespace detail {
+
+/// @brief Rows of the result computed together by the register-blocked matrix product kernel.
+inline constexpr std::size_t gemm_register_rows = 4;
+
+/// @brief Edge of the square tiles used by the cache-blocked matrix product kernel.
+inline constexpr std::size_t gemm_tile = 64;
+
+/**
+ * @brief Accumulates `c[i][j] += Σ a[i][k] * b[k][j]` over the given ranges for row-major operands.
+ *
+ * Rows of the result are processed #gemm_register_rows at a time, so every row of `b` that is loaded is used for
+ * several rows of `c`. The innermost loop runs along a contiguous row of `b` and `c` and vectorises.
+ */
+template <typename C, typename A, typename B>
+constexpr void gemm_block(A const *a, B const *b, C *c, std::size_t inner, std::size_t cols, std::size_t row_begin,
+                          std::size_t row_end, std::size_t k_begin, std::size_t k_end, std::size_t col_begin,
+                          std::size_t col_end) {
+  std::size_t i = row_begin;
+  for (; i + gemm_register_rows <= row_end; i += gemm_register_rows) {
+    for (std::size_t k = k_begin; k < k_end; ++k) {
+      C a_ik[gemm_register_rows];
+      for (std::size_t r = 0; r < gemm_register_rows; ++r) {
+        a_ik[r] = element_cast<C>(a[(i + r) * inner + k]);
+      }
+      B const *b_row = b + k * cols;
+      for (std::size_t j = col_begin; j < col_end; ++j) {
+        C const b_kj = element_cast<C>(b_row[j]);
+        for (std::size_t r = 0; r < gemm_register_rows; ++r) {
+          c[(i + r) * cols + j] += a_ik[r] * b_kj;
+        }
+      }
+    }
+  }
+  for (; i < row_end; ++i) {
+    for (std::size_t k = k_begin; k < k_end; ++k) {
+      C const a_ik = element_cast<C>(a[i * inner + k]);
+      for (std::size_t j = col_begin; j < col_end; ++j) {
+        c[i * cols + j] += a_ik * element_cast<C>(b[k * cols + j]);
+      }
+    }
+  }
+}
+
+} // namespace detail
+
+/**
+ * @class matrix
+ * @brief Represents a fixed-size matrix with row-major or column-major storage.
+ *
+ * Element types and promotion follow firefly::vector: mixing element types in an operation produces a matrix or vector
+ * of `common_type_t` of the operands, and 16-bit floating point elements are computed in `float`.
+ *
+ * @tparam T The type of the elements.
+ * @tparam Rows The number of rows.
+ * @tparam Cols The number of columns.
+ * @tparam Layout The storage order of the elements.
+ */
+template <vector_type T, std::size_t Rows, std::size_t Cols, layout Layout = layout::row_major>
+class matrix {
+public:
+  using value_type = T;
+
+  /// @brief The number of rows.
+  static constexpr std::size_t rows = Rows;
+  /// @brief The number of columns.
+  static constexpr std::size_t cols = Cols;
+  /// @brief The storage order of the elements.
+  static constexpr layout storage = Layout;
+
+  /**
+   * @brief Default constructor that initialises all elements to zero.
+   */
+  [[nodiscard]] constexpr matrix() {
+    _data.fill(T{});
+  }
+
+  /**
+   * @brief Constructor that sets every element to the given value.
+   *
+   * @param value The value used for every element.
+   */
+  [[nodiscard]] constexpr explicit matrix(T const value) {
+    _data.fill(value);
+  }
+
+  /**
+   * @brief Constructor that initialises the matrix row by row, independently of the storage order.
+   *
+   * Missing rows and trailing elements of short rows are set to zero.
+   *
+   * @param list The rows of the matrix.
+   * @throw std::out_of_range if there are more rows than Rows or a row has more elements than Cols.
+   */
+  [[nodiscard]] constexpr matrix(std::initializer_list<std::initializer_list<T>> const &list) {
+    if (list.size() > Rows) {
+      throw std::out_of_range("Initializer list size must match matrix Rows");
+    }
+    _data.fill(T{});
+    std::size_t r = 0;
+    for (auto const &row : list) {
+      if (row.size() > Cols) {
+        throw std::out_of_range("Initializer list size must match matrix Cols");
+      }
+      std::size_t c = 0;
+      for (auto const &value : row) {
+        (*this)(r, c++) = value;
+      }
+      ++r;
+    }
+  }
+
+  /**
+   * @brief Creates an identity matrix.
+   *
+   * @return A square matrix with ones on the diagonal and zeros elsewhere.
+   */
+  [[nodiscard]] static constexpr matrix identity()
+    requires(Rows == Cols)
+  {
+    matrix result;
+    for (std::size_t i = 0; i < Rows; ++i) {
+      result(i, i) = T(1);
+    }
+    return result;
+  }
+
+  /**
+   * @brief Accesses an element without bounds checking.
+   *
+   * @param row The row of the element.
+   * @param col The column of the element.
+   * @return A reference to the element.
+   */
+  [[nodiscard]] constexpr T &operator()(std::size_t const row, std::size_t const col) {
+    return _data[offset(row, col)];
+  }
+
+  /**
+   * @brief Accesses an element without bounds checking.
+   *
+   * @param row The row of the element.
+   * @param col The column of the element.
+   * @return A const reference to the element.
+   */
+  [[nodiscard]] constexpr T const &operator()(std::size_t const row, std::size_t const col) const {
+    return _data[offset(row, col)];
+  }
+
+  /**
+   * @brief Accesses an element with bounds checking.
+   *
+   * @param row The row of the element.
+   * @param col The column of the element.
+   * @throw std::out_of_range if the row or column is outside the matrix.
+   * @return A const reference to the element.
+   */
+  [[nodiscard]] constexpr T const &at(std::size_t const row, std::size_t const col) const {
+    if (row >= Rows || col >= Cols) {
+      throw std::out_of_range("Index exceeds matrix dimensions");
+    }
+    return (*this)(row, col);
+  }
+
+  /**
+   * @brief Returns a pointer to the elements, in storage order.
+   */
+  [[nodiscard]] constexpr T *data() {
+    return _data.data();
+  }
+
+  /**
+   * @brief Returns a pointer to the elements, in storage order.
+   */
+  [[nodiscard]] constexpr T const *data() const {
+    return _data.data();
+  }
+
+  /**
+   * @brief Copies a row into a vector.
+   *
+   * @param row The row number.
+   * @return The row as a vector of Cols elements.
+   */
+  [[nodiscard]] constexpr vector<T, Cols> row(std::size_t const row) const {
+    vector<T, Cols> result;
+    for (std::size_t c = 0; c < Cols; ++c) {
+      result[c] = (*this)(row, c);
+    }
+    return result;
+  }
+
+  /**
+   * @brief Copies a column into a vector.
+   *
+   * @param col The column number.
+   * @return The column as a vector of Rows elements.
+   */
+  [[nodiscard]] constexpr vector<T, Rows> col(std::size_t const col) const {
+    vector<T, Rows> result;
+    for (std::size_t r = 0; r < Rows; ++r) {
+      result[r] = (*this)(r, col);
+    }
+    return result;
+  }
+
+  /**
+   * @brief Computes the transpose of the matrix.
+   *
+   * @return A new Cols × Rows matrix with the same storage order.
+   */
+  [[nodiscard]] constexpr matrix<T, Cols, Rows, Layout> transpose() const {
+    matrix<T, Cols, Rows, Layout> result;
+    for (std::size_t r = 0; r < Rows; ++r) {
+      for (std::size_t c = 0; c < Cols; ++c) {
+        result(c, r) = (*this)(r, c);
+      }
+    }
+    return result;
+  }
+
+  /**
+   * @brief Copies the matrix into another storage order.
+   *
+   * @tparam To The storage order of the result.
+   * @return A matrix with the same elements stored in the requested order.
+   */
+  template <layout To>
+  [[nodiscard]] constexpr matrix<T, Rows, Cols, To> as_layout() const {
+    if constexpr (To == Layout) {
+      return *this;
+    } else {
+      matrix<T, Rows, Cols, To> result;
+      for (std::size_t r = 0; r < Rows; ++r) {
+        for (std::size_t c = 0; c < Cols; ++c) {
+          result(r, c) = (*this)(r, c);
+        }
+      }
+      return result;
+    }
+  }
+
+  /**
+   * @brief Adds two matrices element-wise.
+   *
+   * @tparam U The type of elements in the other matrix.
+   * @param other The matrix to add.
+   * @return A new matrix holding the element-wise sum.
+   */
+  template <vector_type U>
+  [[nodiscard]] constexpr auto operator+(matrix<U, Rows, Cols, Layout> const &other) const {
+    using R = common_type_t<T, U>;
+    matrix<R, Rows, Cols, Layout> result;
+    detail::binary_n<R>(data(), other.data(), result.data(), Rows * Cols, std::plus<>());
+    return result;
+  }
+
+  /**
+   * @brief Subtracts two matrices element-wise.
+   *
+   * @tparam U The type of elements in the other matrix.
+   * @param other The matrix to subtract.
+   * @return A new matrix holding the element-wise difference.
+   */
+  template <vector_type U>
+  [[nodiscard]] constexpr auto operator-(matrix<U, Rows, Cols, Layout> const &other) const {
+    using R = common_type_t<T, U>;
+    matrix<R, Rows, Cols, Layout> result;
+    detail::binary_n<R>(data(), other.data(), result.data(), Rows * Cols, std::minus<>());
+    return result;
+  }
+
+  /**
+   * @brief Multiplies every element by a scalar.
+   *
+   * @tparam U The type of the scalar.
+   * @param scalar The scalar to multiply by.
+   * @return A new matrix holding the scaled elements.
+   */
+  template <vector_type U>
+  [[nodiscard]] constexpr auto operator*(U const scalar) const {
+    using R = common_type_t<T, U>;
+    using C = detail::compute_type_t<R>;
+    matrix<R, Rows, Cols, Layout> result;
+    detail::unary_n<C>(data(), result.data(), Rows * Cols,
+                       [scalar = detail::element_cast<C>(scalar)](C const &el) { return el * scalar; });
+    return result;
+  }
+
+  /**
+   * @brief Computes the matrix–vector product.
+   *
+   * Row-major matrices take one dot product per row; column-major matrices accumulate scaled columns, so in both
+   * cases the inner loop runs over contiguous storage. The loop bounds are compile-time constants, which lets the
+   * compiler fully unroll small products such as 4 × 4 and keep the matrix in registers.
+   *
+   * @tparam U The type of elements in the vector.
+   * @param v The vector to transform.
+   * @return A new vector of Rows elements, of type `common_type_t<T, U>`.
+   */
+  template <vector_type U>
+  [[nodiscard]] constexpr auto operator*(vector<U, Cols> const &v) const {
+    using R = common_type_t<T, U>;
+    using C = detail::compute_type_t<R>;
+    vector<R, Rows> result;
+    if constexpr (Layout == layout::row_major) {
+      for (std::size_t r = 0; r < Rows; ++r) {
+        C acc(0);
+        for (std::size_t c = 0; c < Cols; ++c) {
+          acc += detail::element_cast<C>(_data[r * Cols + c]) * detail::element_cast<C>(v[c]);
+        }
+        result[r] = detail::element_cast<R>(acc);
+      }
+    } else {
+      std::array<C, Rows> acc{};
+      for (std::size_t c = 0; c < Cols; ++c) {
+        C const scale = detail::element_cast<C>(v[c]);
+        for (std::size_t r = 0; r < Rows; ++r) {
+          acc[r] += detail::element_cast<C>(_data[c * Rows + r]) * scale;
+        }
+      }
+      detail::convert_n(acc.data(), result.data(), Rows);
+    }
+    return result;
+  }
+
+  /**
+   * @brief Computes the matrix–matrix product.
+   *
+   * Operands are brought into row-major order and multiplied with a register-blocked kernel that computes several
+   * result rows per pass. Products of at least #gemm_blocking_threshold multiply-adds are additionally split into
+   * square tiles that fit in the L1 cache.
+   *
+   * @tparam U The type of elements in the other matrix.
+   * @tparam K The number of columns of the other matrix.
+   * @tparam OtherLayout The storage order of the other matrix.
+   * @param other The right-hand matrix.
+   * @return A new Rows × K matrix with the storage order of this matrix.
+   */
+  template <vector_type U, std::size_t K, layout OtherLayout>
+  [[nodiscard]] constexpr auto operator*(matrix<U, Cols, K, OtherLayout> const &other) const {
+    using R = common_type_t<T, U>;
+    using C = detail::compute_type_t<R>;
+
+    auto const a = as_layout<layout::row_major>();
+    auto const b = other.template as_layout<layout::row_major>();
+    matrix<C, Rows, K, layout::row_major> product;
+
+    if constexpr (Rows * Cols * K < gemm_blocking_threshold) {
+      detail::gemm_block(a.data(), b.data(), product.data(), Cols, K, 0, Rows, 0, Cols, 0, K);
+    } else {
+      constexpr std::size_t tile = detail::gemm_tile;
+      for (std::size_t i = 0; i < Rows; i += tile) {
+        for (std::size_t k = 0; k < Cols; k += tile) {
+          for (std::size_t j = 0; j < K; j += tile) {
+            detail::gemm_block(a.data(), b.data(), product.data(), Cols, K, i, std::min(i + tile, Rows), k,
+                               std::min(k + tile, Cols), j, std::min(j + tile, K));
+          }
+        }
+      }
+    }
+
+    matrix<R, Rows, K, layout::row_major> result;
+    detail::convert_n(product.data(), result.data(), Rows * K);
+    return result.template as_layout<Layout>();
+  }
+
+  /**
+   * @brief Compares two matrices element-wise, independently of their storage order.
+   *
+   * @tparam OtherLayout The storage order of the other matrix.
+   * @param other The matrix to compare with.
+   * @return `true` if every element matches, otherwise `false`.
+   */
+  template <layout OtherLayout>
+  [[nodiscard]] constexpr bool operator==(matrix<T, Rows, Cols, OtherLayout> const &other) const {
+    for (std::size_t r = 0; r < Rows; ++r) {
+      for (std::size_t c = 0; c < Cols; ++c) {
+        if ((*this)(r, c) != other(r, c)) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief Converts the matrix to a string representation in the format "[[a, b], [c, d]]".
+   *
+   * @param precision The precision used for floating point values.
+   * @return A string representation of the matrix.
+   */
+  [[nodiscard]] std::string view(int precision = 20) const {
+    std::stringstream ss;
+    ss << std::setprecision(precision) << "[";
+    for (std::size_t r = 0; r < Rows; ++r) {
+      ss << (r == 0 ? "[" : ", [");
+      for (std::size_t c = 0; c < Cols; ++c) {
+        ss << (c == 0 ? "" : ", ") << (*this)(r, c);
+      }
+      ss << "]";
+    }
+    ss << "]";
+    return ss.str();
+  }
+
+  /**
+   * @brief Stream insertion operator for matrices.
+   *
+   * @param os The output stream.
+   * @param other The matrix to be output.
+   * @return The output stream with the matrix representation.
+   */
+  friend std::ostream &operator<<(std::ostream &os, matrix const &other) {
+    os << other.view();
+    return os;
+  }
+
+private:
+  std::array<T, Rows * Cols> _data;
+
+  static constexpr std::size_t offset(std::size_t const row, std::size_t const col) {
+    if constexpr (Layout == layout::row_major) {
+      return row * Cols + col;
+    } else {
+      return col * Rows + row;
+    }
+  }
+};
+
+/**
+ * @brief Multiplies every element of a matrix by a scalar, with the scalar on the left.
+ *
+ * @tparam U The type of the scalar.
+ * @tparam T The type of the matrix elements.
+ * @tparam Rows The number of rows.
+ * @tparam Cols The number of columns.
+ * @tparam Layout The storage order.
+ * @param scalar The scalar to multiply by.
+ * @param m The matrix.
+ * @return A new matrix holding the scaled elements.
+ */
+template <vector_type U, vector_type T, std::size_t Rows, std::size_t Cols, layout Layout>
+[[nodiscard]] constexpr auto operator*(U const scalar, matrix<T, Rows, Cols, Layout> const &m) {
+  return m * scalar;
+}
+
+/**
+ * @brief Applies one matrix to every vector of a batch, `out[i] = m * in[i]`.
+ *
+ * The matrix is the same for every vector, so the compiler keeps it in registers for small sizes and each product is
+ * a fully unrolled sequence of multiply-adds. Large batches can be split over several threads.
+ *
+ * @tparam T The type of the matrix elements.
+ * @tparam Rows The number of rows.
+ * @tparam Cols The number of columns.
+ * @tparam Layout The storage order.
+ * @tparam In A contiguous range of `vector<U, Cols>`.
+ * @tparam Out A contiguous range of `vector<common_type_t<T, U>, Rows>`.
+ * @param m The matrix to apply.
+ * @param in The vectors to transform.
+ * @param out The range receiving the transformed vectors. It may alias `in` when Rows equals Cols.
+ * @param threads The number of threads, zero for the hardware concurrency.
+ * @throw std::invalid_argument if `out` is smaller than `in`.
+ */
+template <vector_type T, std::size_t Rows, std::size_t Cols, layout Layout, std::ranges::contiguous_range In,
+          std::ranges::contiguous_range Out>
+  requires std::is_same_v<std::ranges::range_value_t<In>,
+                          vector<typename std::ranges::range_value_t<In>::value_type, Cols>> &&
+           std::is_same_v<std::ranges::range_value_t<Out>,
+                          vector<common_type_t<T, typename std::ranges::range_value_t<In>::value_type>, Rows>>
+void transform(matrix<T, Rows, Cols, Layout> const &m, In const &in, Out &&out, std::size_t const threads = 1) {
+  std::size_t const n = std::ranges::size(in);
+  if (std::ranges::size(out) < n) {
+    throw std::invalid_argument("Output range must be at least as large as the input range");
+  }
+  auto const *source = std::ranges::data(in);
+  auto *target = std::ranges::data(out);
+  detail::parallel_for_ranges(n, threads, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+      target[i] = m * source[i];
+    }
+  });
+}
+
+} // namespace firefly
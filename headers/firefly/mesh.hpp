@@ -0,0 +1,377 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "firefly/detail/parallel.hpp"
+#include "firefly/vector.hpp"
+
+namespace firefly {
+
+namespace detail {
+
+/// @brief Number of faces whose corners are gathered together before their cross products are computed.
+inline constexpr std::size_t face_chunk = 256;
+
+/**
+ * @brief Checks that `R` is a contiguous range of `vector<T, 3>`.
+ */
+template <typename R, typename T>
+concept vertex_range_of =
+    std::ranges::contiguous_range<R> && std::is_same_v<std::ranges::range_value_t<R>, vector<T, 3>>;
+
+/**
+ * @brief Checks that `R` is a contiguous range of unsigned vertex indices.
+ */
+template <typename R>
+concept index_range = std::ranges::contiguous_range<R> && std::unsigned_integral<std::ranges::range_value_t<R>>;
+
+/**
+ * @brief Checks the index buffer of a triangle mesh and returns the number of faces.
+ *
+ * @throw std::invalid_argument if the number of indices is not a multiple of three.
+ */
+inline std::size_t face_count(std::size_t const indices) {
+  if (indices % 3 != 0) {
+    throw std::invalid_argument("Index buffer size must be a multiple of 3");
+  }
+  return indices / 3;
+}
+
+/**
+ * @brief Checks that an output range has room for one value per face or vertex.
+ *
+ * @throw std::invalid_argument if the output range is smaller than `required`.
+ */
+inline void check_output(std::size_t const size, std::size_t const required) {
+  if (size < required) {
+    throw std::invalid_argument("Output range must hold one value per face or vertex");
+  }
+}
+
+/**
+ * @brief Gathers the corners of a chunk of faces and computes `(v1 - v0) × (v2 - v0)` for each of them.
+ *
+ * The corners are gathered into per-coordinate edge arrays first, so the cross products run as a contiguous,
+ * vectorisable loop. The length of each result is twice the face area.
+ *
+ * @throw std::out_of_range if an index is not less than `vertex_count`.
+ */
+template <typename T, typename I>
+void face_cross_n(vector<T, 3> const *vertices, std::size_t const vertex_count, I const *indices,
+                  std::size_t const first, std::size_t const count, T *nx, T *ny, T *nz) {
+  T ux[face_chunk], uy[face_chunk], uz[face_chunk];
+  T vx[face_chunk], vy[face_chunk], vz[face_chunk];
+  for (std::size_t i = 0; i < count; ++i) {
+    I const *face = indices + 3 * (first + i);
+    if (face[0] >= vertex_count || face[1] >= vertex_count || face[2] >= vertex_count) {
+      throw std::out_of_range("Vertex index exceeds vertex buffer size");
+    }
+    vector<T, 3> const &a = vertices[face[0]];
+    vector<T, 3> const &b = vertices[face[1]];
+    vector<T, 3> const &c = vertices[face[2]];
+    ux[i] = b[0] - a[0];
+    uy[i] = b[1] - a[1];
+    uz[i] = b[2] - a[2];
+    vx[i] = c[0] - a[0];
+    vy[i] = c[1] - a[1];
+    vz[i] = c[2] - a[2];
+  }
+  for (std::size_t i = 0; i < count; ++i) {
+    nx[i] = uy[i] * vz[i] - uz[i] * vy[i];
+    ny[i] = uz[i] * vx[i] - ux[i] * vz[i];
+    nz[i] = ux[i] * vy[i] - uy[i] * vx[i];
+  }
+}
+
+/**
+ * @brief Runs `f(first, count, nx, ny, nz)` on the face cross products of every chunk of faces, one contiguous range
+ * of faces per thread.
+ */
+template <typename T, typename I, typename F>
+void for_each_face_chunk(vector<T, 3> const *vertices, std::size_t const vertex_count, I const *indices,
+                         std::size_t const faces, std::size_t const threads, F const &f) {
+  parallel_for_ranges(faces, threads, [&](std::size_t begin, std::size_t end) {
+    T nx[face_chunk], ny[face_chunk], nz[face_chunk];
+    for (std::size_t first = begin; first < end; first += face_chunk) {
+      std::size_t const count = std::min(face_chunk, end - first);
+      face_cross_n(vertices, vertex_count, indices, first, count, nx, ny, nz);
+      f(first, count, nx, ny, nz);
+    }
+  });
+}
+
+/**
+ * @brief Normalises a chunk of cross products into `out`. Zero cross products give zero normals.
+ */
+template <typename T>
+void normalize_n(T const *nx, T const *ny, T const *nz, std::size_t const count, vector<T, 3> *out) {
+  for (std::size_t i = 0; i < count; ++i) {
+    T const length = std::sqrt(nx[i] * nx[i] + ny[i] * ny[i] + nz[i] * nz[i]);
+    T const scale = length > T(0) ? T(1) / length : T(0);
+    out[i][0] = nx[i] * scale;
+    out[i][1] = ny[i] * scale;
+    out[i][2] = nz[i] * scale;
+  }
+}
+
+/**
+ * @brief Writes half the length of a chunk of cross products, the face areas, into `out`.
+ */
+template <typename T>
+void half_length_n(T const *nx, T const *ny, T const *nz, std::size_t const count, T *out) {
+  for (std::size_t i = 0; i < count; ++i) {
+    out[i] = T(0.5) * std::sqrt(nx[i] * nx[i] + ny[i] * ny[i] + nz[i] * nz[i]);
+  }
+}
+
+} // namespace detail
+
+/**
+ * @brief Computes the unit normal of every face of a triangle mesh.
+ *
+ * Face `f` is the triangle `(vertices[indices[3f]], vertices[indices[3f + 1]], vertices[indices[3f + 2]])`, and its
+ * normal follows the right-hand rule on that winding. Degenerate faces get the zero vector.
+ *
+ * @tparam T The floating point type of the coordinates.
+ * @tparam Vertices A contiguous range of `vector<T, 3>`.
+ * @tparam Indices A contiguous range of unsigned integers.
+ * @tparam Normals A contiguous range of `vector<T, 3>`.
+ * @param vertices The vertex buffer.
+ * @param indices The index buffer, three indices per face.
+ * @param normals The range receiving one normal per face.
+ * @param threads The number of threads, zero for the hardware concurrency.
+ * @throw std::invalid_argument if the index buffer size is not a multiple of 3, or `normals` is too small.
+ * @throw std::out_of_range if an index is not less than the number of vertices.
+ */
+template <std::ranges::contiguous_range Vertices, typename Indices, typename Normals,
+          typename T = typename std::ranges::range_value_t<Vertices>::value_type>
+  requires std::floating_point<T> && detail::vertex_range_of<Vertices, T> && detail::index_range<Indices> &&
+           detail::vertex_range_of<Normals, T>
+void face_normals(Vertices const &vertices, Indices const &indices, Normals &&normals, std::size_t const threads = 1) {
+  std::size_t const faces = detail::face_count(std::ranges::size(indices));
+  detail::check_output(std::ranges::size(normals), faces);
+  auto *target = std::ranges::data(normals);
+  detail::for_each_face_chunk(std::ranges::data(vertices), std::ranges::size(vertices), std::ranges::data(indices),
+                              faces, threads, [&](std::size_t first, std::size_t count, T *nx, T *ny, T *nz) {
+                                detail::normalize_n(nx, ny, nz, count, target + first);
+                              });
+}
+
+/**
+ * @brief Computes the unit normal and the area of every face of a triangle mesh in a single pass.
+ *
+ * @tparam T The floating point type of the coordinates.
+ * @tparam Vertices A contiguous range of `vector<T, 3>`.
+ * @tparam Indices A contiguous range of unsigned integers.
+ * @tparam Normals A contiguous range of `vector<T, 3>`.
+ * @tparam Areas A contiguous range of `T`.
+ * @param vertices The vertex buffer.
+ * @param indices The index buffer, three indices per face.
+ * @param normals The range receiving one normal per face, as in face_normals().
+ * @param areas The range receiving one area per face.
+ * @param threads The number of threads, zero for the hardware concurrency.
+ * @throw std::invalid_argument if the index buffer size is not a multiple of 3, or an output range is too small.
+ * @throw std::out_of_range if an index is not less than the number of vertices.
+ */
+template <std::ranges::contiguous_range Vertices, typename Indices, typename Normals,
+          std::ranges::contiguous_range Areas,
+          typename T = typename std::ranges::range_value_t<Vertices>::value_type>
+  requires std::floating_point<T> && detail::vertex_range_of<Vertices, T> && detail::index_range<Indices> &&
+           detail::vertex_range_of<Normals, T> && std::is_same_v<std::ranges::range_value_t<Areas>, T>
+void face_normals(Vertices const &vertices, Indices const &indices, Normals &&normals, Areas &&areas,
+                  std::size_t const threads = 1) {
+  std::size_t const faces = detail::face_count(std::ranges::size(indices));
+  detail::check_output(std::ranges::size(normals), faces);
+  detail::check_output(std::ranges::size(areas), faces);
+  auto *normal_target = std::ranges::data(normals);
+  T *area_target = std::ranges::data(areas);
+  detail::for_each_face_chunk(std::ranges::data(vertices), std::ranges::size(vertices), std::ranges::data(indices),
+                              faces, threads, [&](std::size_t first, std::size_t count, T *nx, T *ny, T *nz) {
+                                detail::half_length_n(nx, ny, nz, count, area_target + first);
+                                detail::normalize_n(nx, ny, nz, count, normal_target + first);
+                              });
+}
+
+/**
+ * @brief Computes the area of every face of a triangle mesh.
+ *
+ * @tparam T The floating point type of the coordinates.
+ * @tparam Vertices A contiguous range of `vector<T, 3>`.
+ * @tparam Indices A contiguous range of unsigned integers.
+ * @tparam Areas A contiguous range of `T`.
+ * @param vertices The vertex buffer.
+ * @param indices The index buffer, three indices per face.
+ * @param areas The range receiving one area per face.
+ * @param threads The number of threads, zero for the hardware concurrency.
+ * @throw std::invalid_argument if the index buffer size is not a multiple of 3, or `areas` is too small.
+ * @throw std::out_of_range if an index is not less than the number of vertices.
+ */
+template <std::ranges::contiguous_range Vertices, typename Indices, std::ranges::contiguous_range Areas,
+          typename T = typename std::ranges::range_value_t<Vertices>::value_type>
+  requires std::floating_point<T> && detail::vertex_range_of<Vertices, T> && detail::index_range<Indices> &&
+           std::is_same_v<std::ranges::range_value_t<Areas>, T>
+void face_areas(Vertices const &vertices, Indices const &indices, Areas &&areas, std::size_t const threads = 1) {
+  std::size_t const faces = detail::face_count(std::ranges::size(indices));
+  detail::check_output(std::ranges::size(areas), faces);
+  T *target = std::ranges::data(areas);
+  detail::for_each_face_chunk(std::ranges::data(vertices), std::ranges::size(vertices), std::ranges::data(indices),
+                              faces, threads, [&](std::size_t first, std::size_t count, T *nx, T *ny, T *nz) {
+                                detail::half_length_n(nx, ny, nz, count, target + first);
+                              });
+}
+
+/**
+ * @brief Computes the total surface area of a triangle mesh.
+ *
+ * Every thread sums the areas of its own range of faces, and the partial sums are added in thread order, so the
+ * result only depends on the mesh and the number of threads.
+ *
+ * @tparam T The floating point type of the coordinates.
+ * @tparam Vertices A contiguous range of `vector<T, 3>`.
+ * @tparam Indices A contiguous range of unsigned integers.
+ * @param vertices The vertex buffer.
+ * @param indices The index buffer, three indices per face.
+ * @param threads The number of threads, zero for the hardware concurrency.
+ * @throw std::invalid_argument if the index buffer size is not a multiple of 3.
+ * @throw std::out_of_range if an index is not less than the number of vertices.
+ * @return The sum of the face areas.
+ */
+template <std::ranges::contiguous_range Vertices, typename Indices,
+          typename T = typename std::ranges::range_value_t<Vertices>::value_type>
+  requires std::floating_point<T> && detail::vertex_range_of<Vertices, T> && detail::index_range<Indices>
+[[nodiscard]] T surface_area(Vertices const &vertices, Indices const &indices, std::size_t const threads = 1) {
+  std::size_t const faces = detail::face_count(std::ranges::size(indices));
+  std::size_t const workers = detail::resolve_threads(threads, faces);
+  std::vector<T> partial(workers, T(0));
+  detail::parallel_for(workers, workers, [&](std::size_t worker) {
+    std::size_t const begin = faces * worker / workers;
+    std::size_t const end = faces * (worker + 1) / workers;
+    T areas[detail::face_chunk];
+    detail::for_each_face_chunk(std::ranges::data(vertices), std::ranges::size(vertices),
+                                std::ranges::data(indices) + 3 * begin, end - begin, 1,
+                                [&](std::size_t, std::size_t count, T *nx, T *ny, T *nz) {
+                                  detail::half_length_n(nx, ny, nz, count, areas);
+                                  T sum = T(0);
+                                  for (std::size_t i = 0; i < count; ++i) {
+                                    sum += areas[i];
+                                  }
+                                  partial[worker] += sum;
+                                });
+  });
+  T total = T(0);
+  for (T const value : partial) {
+    total += value;
+  }
+  return total;
+}
+
+/**
+ * @brief Computes area-weighted vertex normals of a triangle mesh.
+ *
+ * The normal of a vertex is the normalised sum of the normals of its faces, each weighted by the face area. The face
+ * cross products, whose lengths are already twice the areas, are computed in parallel, added to their three vertices
+ * in face order, and normalised in parallel. Vertices without faces, or whose faces cancel out, get the zero vector.
+ *
+ * @tparam T The floating point type of the coordinates.
+ * @tparam Vertices A contiguous range of `vector<T, 3>`.
+ * @tparam Indices A contiguous range of unsigned integers.
+ * @tparam Normals A contiguous range of `vector<T, 3>`.
+ * @param vertices The vertex buffer.
+ * @param indices The index buffer, three indices per face.
+ * @param normals The range receiving one normal per vertex.
+ * @param threads The number of threads, zero for the hardware concurrency.
+ * @throw std::invalid_argument if the index buffer size is not a multiple of 3, or `normals` is too small.
+ * @throw std::out_of_range if an index is not less than the number of vertices.
+ */
+template <std::ranges::contiguous_range Vertices, typename Indices, typename Normals,
+          typename T = typename std::ranges::range_value_t<Vertices>::value_type>
+  requires std::floating_point<T> && detail::vertex_range_of<Vertices, T> && detail::index_range<Indices> &&
+           detail::vertex_range_of<Normals, T>
+void vertex_normals(Vertices const &vertices, Indices const &indices, Normals &&normals,
+                    std::size_t const threads = 1) {
+  std::size_t const faces = detail::face_count(std::ranges::size(indices));
+  std::size_t const vertex_count = std::ranges::size(vertices);
+  detail::check_output(std::ranges::size(normals), vertex_count);
+  auto const *index = std::ranges::data(indices);
+  auto *target = std::ranges::data(normals);
+
+  std::vector<vector<T, 3>> crosses(faces);
+  detail::for_each_face_chunk(std::ranges::data(vertices), vertex_count, index, faces, threads,
+                              [&](std::size_t first, std::size_t count, T *nx, T *ny, T *nz) {
+                                for (std::size_t i = 0; i < count; ++i) {
+                                  crosses[first + i] = vector<T, 3>{nx[i], ny[i], nz[i]};
+                                }
+                              });
+
+  std::fill_n(target, vertex_count, vector<T, 3>{});
+  for (std::size_t f = 0; f < faces; ++f) {
+    for (std::size_t corner = 0; corner < 3; ++corner) {
+      vector<T, 3> &sum = target[index[3 * f + corner]];
+      sum[0] += crosses[f][0];
+      sum[1] += crosses[f][1];
+      sum[2] += crosses[f][2];
+    }
+  }
+
+  detail::parallel_for_ranges(vertex_count, threads, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t v = begin; v < end; ++v) {
+      vector<T, 3> &n = target[v];
+      T const length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+      T const scale = length > T(0) ? T(1) / length : T(0);
+      n[0] *= scale;
+      n[1] *= scale;
+      n[2] *= scale;
+    }
+  });
+}
+
+/**
+ * @brief Computes the centroid of every face of a triangle mesh.
+ *
+ * @tparam T The floating point type of the coordinates.
+ * @tparam Vertices A contiguous range of `vector<T, 3>`.
+ * @tparam Indices A contiguous range of unsigned integers.
+ * @tparam Centroids A contiguous range of `vector<T, 3>`.
+ * @param vertices The vertex buffer.
+ * @param indices The index buffer, three indices per face.
+ * @param centroids The range receiving one centroid per face.
+ * @param threads The number of threads, zero for the hardware concurrency.
+ * @throw std::invalid_argument if the index buffer size is not a multiple of 3, or `centroids` is too small.
+ * @throw std::out_of_range if an index is not less than the number of vertices.
+ */
+template <std::ranges::contiguous_range Vertices, typename Indices, typename Centroids,
+          typename T = typename std::ranges::range_value_t<Vertices>::value_type>
+  requires std::floating_point<T> && detail::vertex_range_of<Vertices, T> && detail::index_range<Indices> &&
+           detail::vertex_range_of<Centroids, T>
+void face_centroids(Vertices const &vertices, Indices const &indices, Centroids &&centroids,
+                    std::size_t const threads = 1) {
+  std::size_t const faces = detail::face_count(std::ranges::size(indices));
+  std::size_t const vertex_count = std::ranges::size(vertices);
+  detail::check_output(std::ranges::size(centroids), faces);
+  auto const *source = std::ranges::data(vertices);
+  auto const *index = std::ranges::data(indices);
+  auto *target = std::ranges::data(centroids);
+  detail::parallel_for_ranges(faces, threads, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t f = begin; f < end; ++f) {
+      auto const *face = index + 3 * f;
+      if (face[0] >= vertex_count || face[1] >= vertex_count || face[2] >= vertex_count) {
+        throw std::out_of_range("Vertex index exceeds vertex buffer size");
+      }
+      vector<T, 3> const &a = source[face[0]];
+      vector<T, 3> const &b = source[face[1]];
+      vector<T, 3> const &c = source[face[2]];
+      for (std::size_t d = 0; d < 3; ++d) {
+        target[f][d] = (a[d] + b[d] + c[d]) / T(3);
+      }
+    }
+  });
+}
+
+} // namespace firefly
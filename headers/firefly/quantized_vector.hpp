@@ -0,0 +1,447 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "firefly/detail/kernels.hpp"
+#include "firefly/math.hpp"
+#include "firefly/vector.hpp"
+
+namespace firefly {
+
+namespace detail {
+
+/**
+ * @brief Rounds `value` to the nearest int8 code, clamping to [-128, 127].
+ */
+[[nodiscard]] constexpr std::int8_t quantize_code(float const value) {
+  float const rounded = value < 0 ? value - 0.5f : value + 0.5f;
+  float const clamped = std::clamp(rounded, -128.0f, 127.0f);
+  return static_cast<std::int8_t>(static_cast<int>(clamped));
+}
+
+/**
+ * @brief Integer dot product of two int8 code arrays.
+ *
+ * The products are widened to 32 bits and folded into #reduction_lanes accumulators. GCC and Clang turn the loop into
+ * packed multiply-add instructions (`pmaddwd` with SSE2/AVX2, `vpdpbusd` with AVX-512 VNNI, `sdot` on AArch64), and
+ * integer accumulation is exact, so the result does not depend on the vector width.
+ */
+[[nodiscard]] constexpr std::int32_t code_dot_n(std::int8_t const *a, std::int8_t const *b, std::size_t n) {
+  std::int32_t acc[reduction_lanes] = {0, 0, 0, 0};
+  std::size_t i = 0;
+  for (; i + reduction_lanes <= n; i += reduction_lanes) {
+    for (std::size_t lane = 0; lane < reduction_lanes; ++lane) {
+      acc[lane] += std::int32_t(a[i + lane]) * std::int32_t(b[i + lane]);
+    }
+  }
+  for (; i < n; ++i) {
+    acc[0] += std::int32_t(a[i]) * std::int32_t(b[i]);
+  }
+  return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+}
+
+} // namespace detail
+
+/**
+ * @class quantized_vector
+ * @brief Scalar-quantised vector storing one int8 code per element plus a per-vector scale and offset.
+ *
+ * An element is reconstructed as `scale * code + offset`. The codes span the range of the encoded vector, so the
+ * reconstruction error of every element is at most `scale / 2`. Besides the codes, the sum and the sum of squares of
+ * the codes are kept, which lets dot products, distances and cosine similarities between two quantised vectors be
+ * computed from a single integer dot product of the codes. Storage is one byte per element plus 16 bytes.
+ *
+ * @tparam Length The number of elements.
+ */
+template <std::size_t Length>
+class quantized_vector {
+public:
+  using code_type = std::int8_t;
+
+  /**
+   * @brief Default constructor that represents the zero vector.
+   */
+  constexpr quantized_vector() = default;
+
+  /**
+   * @brief Encodes a vector, choosing the scale and offset from its smallest and largest element.
+   *
+   * @tparam T The element type of the vector, arithmetic.
+   * @param v The vector to encode.
+   * @return The quantised vector.
+   */
+  template <typename T>
+    requires std::is_arithmetic_v<T>
+  [[nodiscard]] static constexpr quantized_vector encode(vector<T, Length> const &v) {
+    quantized_vector result;
+    if constexpr (Length > 0) {
+      float const lo = static_cast<float>(v.min());
+      float const hi = static_cast<float>(v.max());
+      result._scale = (hi - lo) / 255.0f;
+      result._offset = lo + 128.0f * result._scale;
+      for (std::size_t i = 0; i < Length; ++i) {
+        result._codes[i] = result._scale == 0.0f
+                               ? code_type(0)
+                               : detail::quantize_code((static_cast<float>(v[i]) - result._offset) / result._scale);
+      }
+      result.update_sums();
+    }
+    return result;
+  }
+
+  /**
+   * @brief Reconstructs the vector from its codes.
+   *
+   * @return The approximate float vector.
+   */
+  [[nodiscard]] constexpr vector<float, Length> decode() const {
+    vector<float, Length> result;
+    detail::unary_n<float>(_codes.data(), result.data(), Length,
+                           [scale = _scale, offset = _offset](float code) { return scale * code + offset; });
+    return result;
+  }
+
+  /**
+   * @brief Returns the int8 codes.
+   */
+  [[nodiscard]] constexpr vector<code_type, Length> const &codes() const {
+    return _codes;
+  }
+
+  /**
+   * @brief Returns the step between two consecutive codes.
+   */
+  [[nodiscard]] constexpr float scale() const {
+    return _scale;
+  }
+
+  /**
+   * @brief Returns the value represented by code zero.
+   */
+  [[nodiscard]] constexpr float offset() const {
+    return _offset;
+  }
+
+  /**
+   * @brief Approximate dot product with another quantised vector, computed on the codes.
+   *
+   * Expands `Σ (s₁q₁ + o₁)(s₂q₂ + o₂)` into one integer dot product of the codes plus the stored code sums.
+   *
+   * @param other The vector to compute the dot product with.
+   * @return The approximate dot product of the encoded vectors.
+   */
+  [[nodiscard]] constexpr float dot(quantized_vector const &other) const {
+    auto const codes = detail::code_dot_n(_codes.data(), other._codes.data(), Length);
+    return static_cast<float>(double(_scale) * other._scale * codes + double(_scale) * other._offset * _code_sum +
+                              double(_offset) * other._scale * other._code_sum +
+                              double(Length) * _offset * other._offset);
+  }
+
+  /**
+   * @brief Asymmetric dot product with an unquantised query.
+   *
+   * Only this vector is approximated, so the result is more accurate than quantising the query as well.
+   *
+   * @tparam T The element type of the query, arithmetic.
+   * @param query The query vector.
+   * @return The approximate dot product.
+   */
+  template <typename T>
+    requires std::is_arithmetic_v<T>
+  [[nodiscard]] constexpr float dot(vector<T, Length> const &query) const {
+    float acc[detail::reduction_lanes] = {0, 0, 0, 0};
+    std::size_t i = 0;
+    for (; i + detail::reduction_lanes <= Length; i += detail::reduction_lanes) {
+      for (std::size_t lane = 0; lane < detail::reduction_lanes; ++lane) {
+        acc[lane] += static_cast<float>(query[i + lane]) * float(_codes[i + lane]);
+      }
+    }
+    for (; i < Length; ++i) {
+      acc[0] += static_cast<float>(query[i]) * float(_codes[i]);
+    }
+    float const sum = detail::reduce_n(query.data(), Length, 0.0f, std::identity(), std::plus<>());
+    return _scale * ((acc[0] + acc[1]) + (acc[2] + acc[3])) + _offset * sum;
+  }
+
+  /**
+   * @brief Approximate squared Euclidean norm of the encoded vector, from the stored code sums.
+   */
+  [[nodiscard]] constexpr float squared_norm() const {
+    return static_cast<float>(double(_scale) * _scale * _code_squared_sum + 2.0 * _scale * _offset * _code_sum +
+                              double(Length) * _offset * _offset);
+  }
+
+  /**
+   * @brief Approximate squared Euclidean distance to another quantised vector, computed on the codes.
+   *
+   * The expansion of `Σ (s₁q₁ + o₁ - s₂q₂ - o₂)²` is evaluated in `double` to limit cancellation between close
+   * vectors.
+   *
+   * @param other The vector to measure the distance to.
+   * @return The approximate squared distance, never negative.
+   */
+  [[nodiscard]] constexpr float squared_distance(quantized_vector const &other) const {
+    double const codes = detail::code_dot_n(_codes.data(), other._codes.data(), Length);
+    double const s1 = _scale;
+    double const s2 = other._scale;
+    double const shift = double(_offset) - double(other._offset);
+    double const result = s1 * s1 * _code_squared_sum + s2 * s2 * other._code_squared_sum - 2.0 * s1 * s2 * codes +
+                          2.0 * shift * (s1 * _code_sum - s2 * other._code_sum) + double(Length) * shift * shift;
+    return static_cast<float>(std::max(0.0, result));
+  }
+
+  /**
+   * @brief Approximate Euclidean distance to another quantised vector, computed on the codes.
+   *
+   * @param other The vector to measure the distance to.
+   * @return The approximate distance.
+   */
+  [[nodiscard]] constexpr float distance(quantized_vector const &other) const {
+    return math::sqrt(squared_distance(other));
+  }
+
+  /**
+   * @brief Approximate cosine similarity with another quantised vector, computed on the codes.
+   *
+   * @param other The vector to compare with.
+   * @throw std::logic_error if either encoded vector is zero.
+   * @return The approximate cosine of the angle between the encoded vectors.
+   */
+  [[nodiscard]] constexpr float cosine(quantized_vector const &other) const {
+    float const norms = squared_norm() * other.squared_norm();
+    if (norms == 0.0f) {
+      throw std::logic_error("Cosine similarity is undefined for a zero vector");
+    }
+    return std::clamp(dot(other) / math::sqrt(norms), -1.0f, 1.0f);
+  }
+
+private:
+  vector<code_type, Length> _codes;
+  float _scale = 0.0f;
+  float _offset = 0.0f;
+  std::int32_t _code_sum = 0;
+  std::int32_t _code_squared_sum = 0;
+
+  constexpr void update_sums() {
+    _code_sum = detail::reduce_n(_codes.data(), Length, std::int32_t(0), std::identity(), std::plus<>());
+    _code_squared_sum = detail::code_dot_n(_codes.data(), _codes.data(), Length);
+  }
+};
+
+/**
+ * @class quantizer
+ * @brief Per-dimension scalar quantiser, fitted to a collection of vectors.
+ *
+ * Every dimension gets its own scale and offset from the range of that dimension over the training vectors, which
+ * keeps the error low when dimensions have very different ranges. Codes are plain `vector<std::int8_t, Length>` and
+ * queries are scored asymmetrically: the per-dimension scales are folded into the query once, after which scoring a
+ * code vector is a single float-by-int8 dot product.
+ *
+ * @tparam Length The number of elements.
+ */
+template <std::size_t Length>
+class quantizer {
+public:
+  using code_type = std::int8_t;
+  using codes_type = vector<code_type, Length>;
+
+  /**
+   * @brief Fits the per-dimension ranges to a collection of vectors.
+   *
+   * @tparam Training A range of firefly::vector with arithmetic elements, such as `std::vector` or `std::span`.
+   * @param training The vectors to fit to.
+   * @throw std::invalid_argument if the collection is empty.
+   * @return The fitted quantiser.
+   */
+  template <std::ranges::forward_range Training>
+    requires std::is_arithmetic_v<typename std::ranges::range_value_t<Training>::value_type> &&
+             std::is_same_v<std::ranges::range_value_t<Training>,
+                            vector<typename std::ranges::range_value_t<Training>::value_type, Length>>
+  [[nodiscard]] static quantizer fit(Training const &training) {
+    if (std::ranges::empty(training)) {
+      throw std::invalid_argument("Quantizer requires at least one training vector");
+    }
+    vector<float, Length> lo = std::ranges::begin(training)->template as_type<float>();
+    vector<float, Length> hi = lo;
+    for (auto const &v : training) {
+      for (std::size_t i = 0; i < Length; ++i) {
+        lo[i] = std::min(lo[i], static_cast<float>(v[i]));
+        hi[i] = std::max(hi[i], static_cast<float>(v[i]));
+      }
+    }
+
+    quantizer result;
+    for (std::size_t i = 0; i < Length; ++i) {
+      result._scale[i] = (hi[i] - lo[i]) / 255.0f;
+      result._offset[i] = lo[i] + 128.0f * result._scale[i];
+    }
+    return result;
+  }
+
+  /**
+   * @brief Encodes a vector with the fitted ranges. Elements outside the fitted range are clamped.
+   *
+   * @tparam T The element type of the vector, arithmetic.
+   * @param v The vector to encode.
+   * @return The codes.
+   */
+  template <typename T>
+    requires std::is_arithmetic_v<T>
+  [[nodiscard]] constexpr codes_type encode(vector<T, Length> const &v) const {
+    codes_type codes;
+    for (std::size_t i = 0; i < Length; ++i) {
+      codes[i] = _scale[i] == 0.0f ? code_type(0)
+                                   : detail::quantize_code((static_cast<float>(v[i]) - _offset[i]) / _scale[i]);
+    }
+    return codes;
+  }
+
+  /**
+   * @brief Reconstructs a vector from its codes.
+   *
+   * @param codes The codes to decode.
+   * @return The approximate float vector.
+   */
+  [[nodiscard]] constexpr vector<float, Length> decode(codes_type const &codes) const {
+    vector<float, Length> result;
+    for (std::size_t i = 0; i < Length; ++i) {
+      result[i] = _scale[i] * float(codes[i]) + _offset[i];
+    }
+    return result;
+  }
+
+  /**
+   * @brief Query prepared for repeated asymmetric scoring against code vectors.
+   */
+  struct prepared_query {
+    /// @brief The query multiplied element-wise by the per-dimension scales.
+    vector<float, Length> weights;
+    /// @brief The dot product of the query with the per-dimension offsets.
+    float bias;
+    /// @brief The query minus the per-dimension offsets.
+    vector<float, Length> residual;
+  };
+
+  /**
+   * @brief Prepares a query for scoring with dot() and squared_distance().
+   *
+   * @tparam T The element type of the query, arithmetic.
+   * @param query The query vector.
+   * @return The prepared query.
+   */
+  template <typename T>
+    requires std::is_arithmetic_v<T>
+  [[nodiscard]] constexpr prepared_query prepare(vector<T, Length> const &query) const {
+    auto const q = query.template as_type<float>();
+    return {map_product(q, _scale), q.dot(_offset), q - _offset};
+  }
+
+  /**
+   * @brief Approximate dot product of a prepared query with a code vector.
+   *
+   * @param query The prepared query.
+   * @param codes The code vector.
+   * @return The approximate dot product.
+   */
+  [[nodiscard]] constexpr float dot(prepared_query const &query, codes_type const &codes) const {
+    float acc[detail::reduction_lanes] = {0, 0, 0, 0};
+    std::size_t i = 0;
+    for (; i + detail::reduction_lanes <= Length; i += detail::reduction_lanes) {
+      for (std::size_t lane = 0; lane < detail::reduction_lanes; ++lane) {
+        acc[lane] += query.weights[i + lane] * float(codes[i + lane]);
+      }
+    }
+    for (; i < Length; ++i) {
+      acc[0] += query.weights[i] * float(codes[i]);
+    }
+    return (acc[0] + acc[1]) + (acc[2] + acc[3]) + query.bias;
+  }
+
+  /**
+   * @brief Approximate squared Euclidean distance between a prepared query and a code vector.
+   *
+   * @param query The prepared query.
+   * @param codes The code vector.
+   * @return The approximate squared distance.
+   */
+  [[nodiscard]] constexpr float squared_distance(prepared_query const &query, codes_type const &codes) const {
+    float acc[detail::reduction_lanes] = {0, 0, 0, 0};
+    std::size_t i = 0;
+    for (; i + detail::reduction_lanes <= Length; i += detail::reduction_lanes) {
+      for (std::size_t lane = 0; lane < detail::reduction_lanes; ++lane) {
+        float const d = query.residual[i + lane] - _scale[i + lane] * float(codes[i + lane]);
+        acc[lane] += d * d;
+      }
+    }
+    for (; i < Length; ++i) {
+      float const d = query.residual[i] - _scale[i] * float(codes[i]);
+      acc[0] += d * d;
+    }
+    return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+  }
+
+private:
+  vector<float, Length> _scale;
+  vector<float, Length> _offset;
+
+  static constexpr vector<float, Length> map_product(vector<float, Length> const &a, vector<float, Length> const &b) {
+    vector<float, Length> result;
+    detail::binary_n<float>(a.data(), b.data(), result.data(), Length, std::multiplies<>());
+    return result;
+  }
+};
+
+/**
+ * @brief Re-ranks approximate candidates by their exact squared Euclidean distance to a query.
+ *
+ * Intended to follow an approximate search over quantised codes: retrieve a few times more candidates than needed
+ * from the codes, then keep the `k` closest according to the original float vectors.
+ *
+ * @tparam T The element type of the query and the original vectors, arithmetic.
+ * @tparam Length The number of elements.
+ * @tparam Originals A random access range of `vector<T, Length>`.
+ * @tparam Candidates A range of integral candidate ids.
+ * @param query The query vector.
+ * @param originals The unquantised vectors, indexed by candidate id.
+ * @param candidates The candidate ids from the approximate search.
+ * @param k The number of results to keep.
+ * @throw std::out_of_range if a candidate id is not a valid index into `originals`.
+ * @return Up to `k` candidate ids, closest first. Ties are broken by the lower id.
+ */
+template <typename T, std::size_t Length, std::ranges::random_access_range Originals,
+          std::ranges::forward_range Candidates>
+  requires std::is_arithmetic_v<T> && std::is_same_v<std::ranges::range_value_t<Originals>, vector<T, Length>> &&
+           std::integral<std::ranges::range_value_t<Candidates>>
+[[nodiscard]] std::vector<std::size_t> rerank(vector<T, Length> const &query, Originals const &originals,
+                                              Candidates const &candidates, std::size_t k) {
+  auto const count = static_cast<std::size_t>(std::ranges::size(originals));
+  std::vector<std::pair<T, std::size_t>> scored;
+  for (auto const candidate : candidates) {
+    auto const id = static_cast<std::size_t>(candidate);
+    if (std::cmp_less(candidate, 0) || id >= count) {
+      throw std::out_of_range("Candidate exceeds the number of original vectors");
+    }
+    scored.emplace_back(query.subtract(std::ranges::begin(originals)[id]).squared_norm(), id);
+  }
+
+  k = std::min(k, scored.size());
+  std::partial_sort(scored.begin(), scored.begin() + k, scored.end());
+
+  std::vector<std::size_t> result(k);
+  for (std::size_t i = 0; i < k; ++i) {
+    result[i] = scored[i].second;
+  }
+  return result;
+}
+
+} // namespace firefly
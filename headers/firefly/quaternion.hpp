@@ -0,0 +1,315 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <iomanip>
+#include <numbers>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "firefly/math.hpp"
+#include "firefly/matrix.hpp"
+#include "firefly/vector.hpp"
+
+namespace firefly {
+
+/**
+ * @class quaternion
+ * @brief Represents a quaternion `w + xi + yj + zk`, used to describe 3D rotations.
+ *
+ * Rotations are represented by unit quaternions, where `q` and `-q` describe the same rotation. Functions that build
+ * a rotation return a unit quaternion; functions that apply one assume it.
+ *
+ * @tparam T The floating point type of the components.
+ */
+template <std::floating_point T>
+class quaternion {
+public:
+  using value_type = T;
+
+  /**
+   * @brief Default constructor that creates the identity rotation `1 + 0i + 0j + 0k`.
+   */
+  [[nodiscard]] constexpr quaternion() = default;
+
+  /**
+   * @brief Constructor that sets every component.
+   *
+   * @param w The real part.
+   * @param x The coefficient of i.
+   * @param y The coefficient of j.
+   * @param z The coefficient of k.
+   */
+  [[nodiscard]] constexpr quaternion(T const w, T const x, T const y, T const z) : _w(w), _x(x), _y(y), _z(z) {}
+
+  /**
+   * @brief Creates the rotation by an angle about an axis.
+   *
+   * @tparam U The type of the axis elements.
+   * @param axis The rotation axis, which does not need to be normalised.
+   * @param angle_rad The angle of the rotation in radians, counter-clockwise when looking down the axis.
+   * @throw std::logic_error if the axis is the zero vector.
+   * @return The unit quaternion of the rotation.
+   */
+  template <vector_type U>
+    requires std::is_arithmetic_v<U>
+  [[nodiscard]] static constexpr quaternion from_axis_angle(vector<U, 3> const &axis, T const angle_rad) {
+    T const length = math::sqrt(T(axis.squared_norm()));
+    if (length == T(0)) {
+      throw std::logic_error("Cannot build a rotation about a zero axis");
+    }
+    T const half = angle_rad / T(2);
+    T const s = math::sin(half) / length;
+    return quaternion(math::cos(half), T(axis[0]) * s, T(axis[1]) * s, T(axis[2]) * s);
+  }
+
+  /**
+   * @brief Converts the rotation to an axis and an angle.
+   *
+   * @return A pair of the unit rotation axis and the angle in radians, in [0, pi]. The identity rotation returns the
+   * x axis and a zero angle.
+   */
+  [[nodiscard]] constexpr std::pair<vector<T, 3>, T> to_axis_angle() const {
+    // q and -q are the same rotation; picking w >= 0 keeps the angle in [0, pi].
+    T const sign = _w < T(0) ? T(-1) : T(1);
+    T const length = math::sqrt(_x * _x + _y * _y + _z * _z);
+    if (length == T(0)) {
+      return {vector<T, 3>{T(1), T(0), T(0)}, T(0)};
+    }
+    T const half = _w == T(0) ? std::numbers::pi_v<T> / T(2) : math::atan(length / (sign * _w));
+    T const s = sign / length;
+    return {vector<T, 3>{_x * s, _y * s, _z * s}, T(2) * half};
+  }
+
+  /**
+   * @brief Returns the real part.
+   */
+  [[nodiscard]] constexpr T w() const {
+    return _w;
+  }
+
+  /**
+   * @brief Returns the coefficient of i.
+   */
+  [[nodiscard]] constexpr T x() const {
+    return _x;
+  }
+
+  /**
+   * @brief Returns the coefficient of j.
+   */
+  [[nodiscard]] constexpr T y() const {
+    return _y;
+  }
+
+  /**
+   * @brief Returns the coefficient of k.
+   */
+  [[nodiscard]] constexpr T z() const {
+    return _z;
+  }
+
+  /**
+   * @brief Returns the imaginary part as a vector `(x, y, z)`.
+   */
+  [[nodiscard]] constexpr vector<T, 3> vec() const {
+    return vector<T, 3>{_x, _y, _z};
+  }
+
+  /**
+   * @brief Computes the Hamilton product, the composition of two rotations.
+   *
+   * The product `a * b` applies `b` first and then `a`.
+   *
+   * @param other The right-hand quaternion.
+   * @return The product of the two quaternions.
+   */
+  [[nodiscard]] constexpr quaternion operator*(quaternion const &other) const {
+    return quaternion(_w * other._w - _x * other._x - _y * other._y - _z * other._z,
+                      _w * other._x + _x * other._w + _y * other._z - _z * other._y,
+                      _w * other._y - _x * other._z + _y * other._w + _z * other._x,
+                      _w * other._z + _x * other._y - _y * other._x + _z * other._w);
+  }
+
+  /**
+   * @brief Adds two quaternions component-wise.
+   */
+  [[nodiscard]] constexpr quaternion operator+(quaternion const &other) const {
+    return quaternion(_w + other._w, _x + other._x, _y + other._y, _z + other._z);
+  }
+
+  /**
+   * @brief Multiplies every component by a scalar.
+   */
+  [[nodiscard]] constexpr quaternion operator*(T const scalar) const {
+    return quaternion(_w * scalar, _x * scalar, _y * scalar, _z * scalar);
+  }
+
+  /**
+   * @brief Negates every component. The result describes the same rotation.
+   */
+  [[nodiscard]] constexpr quaternion operator-() const {
+    return quaternion(-_w, -_x, -_y, -_z);
+  }
+
+  /**
+   * @brief Computes the four-dimensional dot product of two quaternions.
+   */
+  [[nodiscard]] constexpr T dot(quaternion const &other) const {
+    return _w * other._w + _x * other._x + _y * other._y + _z * other._z;
+  }
+
+  /**
+   * @brief Computes the squared norm of the quaternion.
+   */
+  [[nodiscard]] constexpr T squared_norm() const {
+    return dot(*this);
+  }
+
+  /**
+   * @brief Computes the norm of the quaternion.
+   */
+  [[nodiscard]] constexpr T norm() const {
+    return math::sqrt(squared_norm());
+  }
+
+  /**
+   * @brief Computes the conjugate `w - xi - yj - zk`, which is the inverse rotation of a unit quaternion.
+   */
+  [[nodiscard]] constexpr quaternion conjugate() const {
+    return quaternion(_w, -_x, -_y, -_z);
+  }
+
+  /**
+   * @brief Computes the multiplicative inverse.
+   *
+   * @throw std::logic_error if the quaternion is zero.
+   * @return The quaternion `q⁻¹` with `q * q⁻¹ = 1`.
+   */
+  [[nodiscard]] constexpr quaternion inverse() const {
+    T const n = squared_norm();
+    if (n == T(0)) {
+      throw std::logic_error("Cannot invert a zero quaternion");
+    }
+    return conjugate() * (T(1) / n);
+  }
+
+  /**
+   * @brief Scales the quaternion to unit norm.
+   *
+   * @throw std::logic_error if the quaternion is zero.
+   * @return The normalised quaternion.
+   */
+  [[nodiscard]] constexpr quaternion to_normalized() const {
+    T const n = norm();
+    if (n == T(0)) {
+      throw std::logic_error("Cannot normalize a zero quaternion");
+    }
+    return *this * (T(1) / n);
+  }
+
+  /**
+   * @brief Rotates a vector by this unit quaternion.
+   *
+   * Uses `v + w·t + u × t` with `t = 2(u × v)`, which takes two cross products instead of two Hamilton products. To
+   * rotate many vectors, convert the quaternion once with to_matrix() instead.
+   *
+   * @param v The vector to rotate.
+   * @return The rotated vector.
+   */
+  [[nodiscard]] constexpr vector<T, 3> rotate(vector<T, 3> const &v) const {
+    vector<T, 3> const u = vec();
+    vector<T, 3> const t = u.cross(v) * T(2);
+    return v + t * _w + u.cross(t);
+  }
+
+  /**
+   * @brief Converts the rotation to a 3 × 3 rotation matrix.
+   *
+   * The quaternion is normalised as part of the conversion, so any non-zero quaternion gives an orthonormal matrix.
+   *
+   * @tparam Layout The storage order of the matrix.
+   * @return The rotation matrix, or the zero matrix for a zero quaternion.
+   */
+  template <layout Layout = layout::row_major>
+  [[nodiscard]] constexpr matrix<T, 3, 3, Layout> to_matrix() const {
+    T const n = squared_norm();
+    T const s = n == T(0) ? T(0) : T(2) / n;
+    T const xx = _x * _x * s, yy = _y * _y * s, zz = _z * _z * s;
+    T const xy = _x * _y * s, xz = _x * _z * s, yz = _y * _z * s;
+    T const wx = _w * _x * s, wy = _w * _y * s, wz = _w * _z * s;
+    return matrix<T, 3, 3, Layout>{
+        {T(1) - (yy + zz), xy - wz, xz + wy},
+        {xy + wz, T(1) - (xx + zz), yz - wx},
+        {xz - wy, yz + wx, T(1) - (xx + yy)},
+    };
+  }
+
+  /**
+   * @brief Compares two quaternions component-wise.
+   */
+  [[nodiscard]] constexpr bool operator==(quaternion const &other) const = default;
+
+  /**
+   * @brief Converts the quaternion to a string representation in the format "(w, x, y, z)".
+   *
+   * @param precision The precision used for the components.
+   * @return A string representation of the quaternion.
+   */
+  [[nodiscard]] std::string view(int precision = 20) const {
+    std::stringstream ss;
+    ss << std::setprecision(precision) << "(" << _w << ", " << _x << ", " << _y << ", " << _z << ")";
+    return ss.str();
+  }
+
+  /**
+   * @brief Stream insertion operator for quaternions.
+   *
+   * @param os The output stream.
+   * @param other The quaternion to be output.
+   * @return The output stream with the quaternion representation.
+   */
+  friend std::ostream &operator<<(std::ostream &os, quaternion const &other) {
+    os << other.view();
+    return os;
+  }
+
+private:
+  T _w = T(1);
+  T _x = T(0);
+  T _y = T(0);
+  T _z = T(0);
+};
+
+/**
+ * @brief Spherical linear interpolation between two unit quaternions.
+ *
+ * Interpolates along the shorter arc at constant angular velocity. When the quaternions are almost parallel the arc is
+ * indistinguishable from the chord and the normalised linear interpolation is used instead, which avoids dividing by
+ * a vanishing sine.
+ *
+ * @tparam T The floating point type of the components.
+ * @param a The rotation at `t = 0`.
+ * @param b The rotation at `t = 1`.
+ * @param t The interpolation parameter, typically in [0, 1].
+ * @return The interpolated unit quaternion.
+ */
+template <std::floating_point T>
+[[nodiscard]] constexpr quaternion<T> slerp(quaternion<T> const &a, quaternion<T> b, T const t) {
+  T cos_theta = a.dot(b);
+  if (cos_theta < T(0)) {
+    b = -b;
+    cos_theta = -cos_theta;
+  }
+  if (cos_theta > T(0.9995)) {
+    return (a * (T(1) - t) + b * t).to_normalized();
+  }
+  T const theta = math::acos(cos_theta);
+  T const inverse_sin = T(1) / math::sqrt(T(1) - cos_theta * cos_theta);
+  return a * (math::sin((T(1) - t) * theta) * inverse_sin) + b * (math::sin(t * theta) * inverse_sin);
+}
+
+} // namespace firefly
@@ -0,0 +1,536 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <ranges>
+#include <type_traits>
+#include <vector>
+
+#include "firefly/batch.hpp"
+#include "firefly/detail/parallel.hpp"
+#include "firefly/vector.hpp"
+
+namespace firefly {
+
+/**
+ * @brief Floating point types that the random fills produce: `float` uses one 32-bit word per value and `double` two.
+ */
+template <typename T>
+concept random_real = std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+namespace detail {
+
+/// @brief Number of Philox blocks whose rounds are run together, one block per SIMD lane.
+inline constexpr std::size_t philox_chunk = 64;
+
+/// @brief Number of vectors generated together by the random fills.
+inline constexpr std::size_t random_chunk = 128;
+
+/**
+ * @brief Computes `count` consecutive 32-bit words of a Philox4x32-10 stream, starting at word `first`.
+ *
+ * Block `b` of the stream encrypts the counter `(b, stream)` with the key; its four words are words `4b` to `4b + 3`.
+ * The rounds run over a chunk of blocks held as a structure of arrays, so each round is one vectorisable loop of
+ * 32 × 32 → 64-bit multiplications.
+ */
+inline void philox_words(std::uint64_t const key, std::uint64_t const stream, std::uint64_t const first,
+                         std::size_t const count, std::uint32_t *out) {
+  std::uint64_t const first_block = first / 4;
+  std::uint64_t const end_block = (first + count + 3) / 4;
+  std::size_t written = 0;
+  std::size_t skip = std::size_t(first % 4);
+  for (std::uint64_t block = first_block; block < end_block; block += philox_chunk) {
+    std::size_t const blocks = std::size_t(std::min<std::uint64_t>(philox_chunk, end_block - block));
+    std::uint32_t c0[philox_chunk], c1[philox_chunk], c2[philox_chunk], c3[philox_chunk];
+    for (std::size_t i = 0; i < blocks; ++i) {
+      c0[i] = std::uint32_t(block + i);
+      c1[i] = std::uint32_t((block + i) >> 32);
+      c2[i] = std::uint32_t(stream);
+      c3[i] = std::uint32_t(stream >> 32);
+    }
+    std::uint32_t k0 = std::uint32_t(key);
+    std::uint32_t k1 = std::uint32_t(key >> 32);
+    for (int round = 0; round < 10; ++round) {
+      for (std::size_t i = 0; i < blocks; ++i) {
+        std::uint64_t const p0 = std::uint64_t(0xD2511F53u) * c0[i];
+        std::uint64_t const p1 = std::uint64_t(0xCD9E8D57u) * c2[i];
+        std::uint32_t const n0 = std::uint32_t(p1 >> 32) ^ c1[i] ^ k0;
+        std::uint32_t const n2 = std::uint32_t(p0 >> 32) ^ c3[i] ^ k1;
+        c0[i] = n0;
+        c1[i] = std::uint32_t(p1);
+        c2[i] = n2;
+        c3[i] = std::uint32_t(p0);
+      }
+      k0 += 0x9E3779B9u;
+      k1 += 0xBB67AE85u;
+    }
+    for (std::size_t i = 0; i < blocks; ++i) {
+      std::uint32_t const words[4] = {c0[i], c1[i], c2[i], c3[i]};
+      for (std::size_t w = skip; w < 4 && written < count; ++w) {
+        out[written++] = words[w];
+      }
+      skip = 0;
+    }
+  }
+}
+
+/**
+ * @brief Converts random words to a uniform value, in `[0, 1)` or, if `Open`, in `(0, 1)`. Floats take the top 23
+ * bits of one word and doubles the top 52 bits of two words, so every value is a multiple of the machine epsilon, plus
+ * half of it when open. Those half steps still fit in the mantissa, so the sum is exact and an open value never
+ * rounds to 1.
+ */
+template <random_real T, bool Open>
+[[nodiscard]] T to_uniform(std::uint32_t const *words) {
+  if constexpr (std::is_same_v<T, float>) {
+    return (float(words[0] >> 9) + (Open ? 0.5f : 0.0f)) * 0x1p-23f;
+  } else {
+    std::uint64_t const bits = ((std::uint64_t(words[0]) << 32) | words[1]) >> 12;
+    return (double(bits) + (Open ? 0.5 : 0.0)) * 0x1p-52;
+  }
+}
+
+/**
+ * @brief Number of uniforms needed for `Length` standard normal values, which Box–Muller produces in pairs.
+ */
+template <std::size_t Length>
+inline constexpr std::size_t normal_uniforms = (Length + 1) / 2 * 2;
+
+/**
+ * @brief Number of uniforms needed for a point on the unit sphere in `Length` dimensions.
+ */
+template <std::size_t Length>
+inline constexpr std::size_t sphere_uniforms = Length <= 2 ? 1 : Length == 3 ? 2 : normal_uniforms<Length>;
+
+/**
+ * @brief Box–Muller transform of `Length` rows of `m` open uniforms into `Length` rows of standard normal values. Rows
+ * are `random_chunk` apart; the uniforms are overwritten.
+ */
+template <typename T, std::size_t Length>
+void box_muller(T *u, std::size_t const m) {
+  for (std::size_t d = 0; d + 1 < normal_uniforms<Length>; d += 2) {
+    T *radius = u + d * random_chunk;
+    T *angle = u + (d + 1) * random_chunk;
+    for (std::size_t j = 0; j < m; ++j) {
+      T const r = std::sqrt(T(-2) * std::log(radius[j]));
+      T const phi = T(2) * std::numbers::pi_v<T> * angle[j];
+      radius[j] = r * std::cos(phi);
+      angle[j] = r * std::sin(phi);
+    }
+  }
+}
+
+/**
+ * @brief Turns rows of open uniforms into rows of points on the unit sphere, without rejection: a sign in one
+ * dimension, an angle in two, Archimedes' uniform height and an angle in three, and normalised Gaussian vectors
+ * above. Open uniforms are strictly below 1, so their Box–Muller radii are never zero and the Gaussian vectors can
+ * always be normalised.
+ */
+template <typename T, std::size_t Length>
+void sphere_points(T *u, T *result, std::size_t const m) {
+  if constexpr (Length == 1) {
+    for (std::size_t j = 0; j < m; ++j) {
+      result[j] = u[j] < T(0.5) ? T(-1) : T(1);
+    }
+  } else if constexpr (Length == 2) {
+    for (std::size_t j = 0; j < m; ++j) {
+      T const phi = T(2) * std::numbers::pi_v<T> * u[j];
+      result[j] = std::cos(phi);
+      result[random_chunk + j] = std::sin(phi);
+    }
+  } else if constexpr (Length == 3) {
+    for (std::size_t j = 0; j < m; ++j) {
+      T const z = T(2) * u[j] - T(1);
+      T const r = std::sqrt(std::max(T(0), T(1) - z * z));
+      T const phi = T(2) * std::numbers::pi_v<T> * u[random_chunk + j];
+      result[j] = r * std::cos(phi);
+      result[random_chunk + j] = r * std::sin(phi);
+      result[2 * random_chunk + j] = z;
+    }
+  } else {
+    box_muller<T, Length>(u, m);
+    T norm[random_chunk] = {};
+    for (std::size_t d = 0; d < Length; ++d) {
+      for (std::size_t j = 0; j < m; ++j) {
+        norm[j] += u[d * random_chunk + j] * u[d * random_chunk + j];
+      }
+    }
+    for (std::size_t j = 0; j < m; ++j) {
+      norm[j] = T(1) / std::sqrt(norm[j]);
+    }
+    for (std::size_t d = 0; d < Length; ++d) {
+      for (std::size_t j = 0; j < m; ++j) {
+        result[d * random_chunk + j] = u[d * random_chunk + j] * norm[j];
+      }
+    }
+  }
+}
+
+/**
+ * @brief Destination of the random fills: a contiguous array of vectors or a vector_batch, written a chunk of
+ * per-dimension rows at a time.
+ */
+template <typename T, std::size_t Length>
+struct random_target {
+  vector<T, Length> *vectors = nullptr;
+  vector_batch<T, Length> *batch = nullptr;
+  std::size_t count;
+
+  void store(std::size_t const begin, std::size_t const m, T const *rows) const {
+    if (batch != nullptr) {
+      for (std::size_t d = 0; d < Length; ++d) {
+        std::ranges::copy_n(rows + d * random_chunk, std::ptrdiff_t(m), batch->component(d).begin() + begin);
+      }
+      return;
+    }
+    for (std::size_t j = 0; j < m; ++j) {
+      for (std::size_t d = 0; d < Length; ++d) {
+        vectors[begin + j][d] = rows[d * random_chunk + j];
+      }
+    }
+  }
+};
+
+} // namespace detail
+
+/**
+ * @class philox
+ * @brief Counter-based Philox4x32-10 random number generator.
+ *
+ * Word `i` of a stream is a pure function of the seed, the stream number and `i`, so any part of a stream can be
+ * computed directly: the fills below hand contiguous words to each thread and vectorise across blocks, and their
+ * output does not depend on the number of threads. Streams with different numbers are independent; give each thread
+ * or task of a parallel run its own stream with split(). The generator also meets the requirements of a uniform
+ * random bit generator, for use with the standard distributions.
+ */
+class philox {
+public:
+  using result_type = std::uint32_t;
+
+  /**
+   * @brief Constructor that sets the seed and the stream number.
+   *
+   * @param seed The key of the generator.
+   * @param stream The stream number.
+   */
+  explicit philox(std::uint64_t const seed = 0, std::uint64_t const stream = 0) : _seed(seed), _stream(stream) {}
+
+  /**
+   * @brief Returns a generator with the same seed at the start of another stream.
+   *
+   * @param stream The stream number.
+   */
+  [[nodiscard]] philox split(std::uint64_t const stream) const {
+    return philox(_seed, stream);
+  }
+
+  [[nodiscard]] static constexpr result_type min() {
+    return 0;
+  }
+
+  [[nodiscard]] static constexpr result_type max() {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  /**
+   * @brief Returns the next word of the stream.
+   */
+  result_type operator()() {
+    if (_position / 4 != _buffered) {
+      _buffered = _position / 4;
+      detail::philox_words(_seed, _stream, _buffered * 4, 4, _buffer.data());
+    }
+    return _buffer[_position++ % 4];
+  }
+
+  /**
+   * @brief Skips words of the stream.
+   *
+   * @param words The number of words to skip.
+   */
+  void discard(std::uint64_t const words) {
+    _position += words;
+  }
+
+  /**
+   * @brief Returns the number of words consumed from the stream.
+   */
+  [[nodiscard]] std::uint64_t position() const {
+    return _position;
+  }
+
+  /**
+   * @brief Returns the seed.
+   */
+  [[nodiscard]] std::uint64_t seed() const {
+    return _seed;
+  }
+
+  /**
+   * @brief Returns the stream number.
+   */
+  [[nodiscard]] std::uint64_t stream() const {
+    return _stream;
+  }
+
+  /**
+   * @brief Computes words of the stream without consuming them.
+   *
+   * @param first The index of the first word.
+   * @param count The number of words.
+   * @param out The destination of `count` words.
+   */
+  void words(std::uint64_t const first, std::size_t const count, result_type *out) const {
+    detail::philox_words(_seed, _stream, first, count, out);
+  }
+
+private:
+  std::uint64_t _seed;
+  std::uint64_t _stream;
+  std::uint64_t _position = 0;
+  // The block held in _buffer, none at first.
+  std::uint64_t _buffered = std::numeric_limits<std::uint64_t>::max();
+  std::array<result_type, 4> _buffer{};
+};
+
+namespace detail {
+
+/**
+ * @brief Fills a target with vectors computed from `Uniforms` uniforms each.
+ *
+ * Vector `i` uses the words of the generator that follow its current position by `i × Uniforms × words per value`,
+ * and the generator is advanced past all of them. Threads take contiguous ranges of vectors; every chunk of vectors
+ * is converted to rows of uniforms, turned into rows of results by `kernel(u, result, m)` and stored.
+ */
+template <random_real T, std::size_t Length, std::size_t Uniforms, bool Open, typename Kernel>
+void random_fill(philox &generator, random_target<T, Length> const &target, std::size_t const threads,
+                 Kernel const &kernel) {
+  constexpr std::size_t words_per_value = sizeof(T) / sizeof(std::uint32_t);
+  constexpr std::size_t words_per_vector = Uniforms * words_per_value;
+  std::uint64_t const first = generator.position();
+  parallel_for_ranges(target.count, threads, [&](std::size_t begin, std::size_t end) {
+    std::vector<std::uint32_t> words(random_chunk * words_per_vector);
+    std::vector<T> u(random_chunk * Uniforms);
+    std::vector<T> result(random_chunk * Length);
+    for (std::size_t b = begin; b < end; b += random_chunk) {
+      std::size_t const m = std::min(random_chunk, end - b);
+      generator.words(first + std::uint64_t(b) * words_per_vector, m * words_per_vector, words.data());
+      for (std::size_t k = 0; k < Uniforms; ++k) {
+        for (std::size_t j = 0; j < m; ++j) {
+          u[k * random_chunk + j] = to_uniform<T, Open>(words.data() + (j * Uniforms + k) * words_per_value);
+        }
+      }
+      kernel(u.data(), result.data(), m);
+      target.store(b, m, result.data());
+    }
+  });
+  generator.discard(std::uint64_t(target.count) * words_per_vector);
+}
+
+template <random_real T, std::size_t Length>
+void fill_uniform(philox &generator, random_target<T, Length> const &target, T const low, T const high,
+                  std::size_t const threads) {
+  T const scale = high - low;
+  random_fill<T, Length, Length, false>(generator, target, threads, [&](T *u, T *result, std::size_t m) {
+    for (std::size_t i = 0; i < Length * random_chunk; i += random_chunk) {
+      for (std::size_t j = 0; j < m; ++j) {
+        result[i + j] = low + scale * u[i + j];
+      }
+    }
+  });
+}
+
+template <random_real T, std::size_t Length>
+void fill_normal(philox &generator, random_target<T, Length> const &target, T const mean, T const stddev,
+                 std::size_t const threads) {
+  random_fill<T, Length, normal_uniforms<Length>, true>(generator, target, threads, [&](T *u, T *result, std::size_t m) {
+    box_muller<T, Length>(u, m);
+    for (std::size_t i = 0; i < Length * random_chunk; i += random_chunk) {
+      for (std::size_t j = 0; j < m; ++j) {
+        result[i + j] = mean + stddev * u[i + j];
+      }
+    }
+  });
+}
+
+template <random_real T, std::size_t Length>
+void fill_unit_sphere(philox &generator, random_target<T, Length> const &target, std::size_t const threads) {
+  random_fill<T, Length, sphere_uniforms<Length>, true>(
+      generator, target, threads, [](T *u, T *result, std::size_t m) { sphere_points<T, Length>(u, result, m); });
+}
+
+/**
+ * @brief Scales points on the sphere by the inverse of the radial distribution `r^Length`, read from the last row of
+ * uniforms.
+ */
+template <random_real T, std::size_t Length>
+void fill_unit_ball(philox &generator, random_target<T, Length> const &target, std::size_t const threads) {
+  constexpr std::size_t uniforms = sphere_uniforms<Length> + 1;
+  random_fill<T, Length, uniforms, true>(generator, target, threads, [](T *u, T *result, std::size_t m) {
+    T radius[random_chunk];
+    T const *v = u + (uniforms - 1) * random_chunk;
+    for (std::size_t j = 0; j < m; ++j) {
+      if constexpr (Length == 1) {
+        radius[j] = v[j];
+      } else if constexpr (Length == 2) {
+        radius[j] = std::sqrt(v[j]);
+      } else if constexpr (Length == 3) {
+        radius[j] = std::cbrt(v[j]);
+      } else {
+        radius[j] = std::pow(v[j], T(1) / T(Length));
+      }
+    }
+    sphere_points<T, Length>(u, result, m);
+    for (std::size_t i = 0; i < Length * random_chunk; i += random_chunk) {
+      for (std::size_t j = 0; j < m; ++j) {
+        result[i + j] *= radius[j];
+      }
+    }
+  });
+}
+
+/**
+ * @brief Describes a contiguous range of vectors as the destination of a fill.
+ */
+template <typename Vectors, typename V = std::ranges::range_value_t<Vectors>>
+[[nodiscard]] random_target<typename V::value_type, vector_length_v<V>> random_target_of(Vectors &vectors) {
+  return {.vectors = std::ranges::data(vectors), .batch = nullptr, .count = std::size_t(std::ranges::size(vectors))};
+}
+
+/**
+ * @brief Describes a batch as the destination of a fill.
+ */
+template <typename T, std::size_t Length>
+[[nodiscard]] random_target<T, Length> random_target_of(vector_batch<T, Length> &batch) {
+  return {.vectors = nullptr, .batch = &batch, .count = batch.size()};
+}
+
+} // namespace detail
+
+/**
+ * @brief Fills vectors with elements drawn uniformly from `[low, high)`.
+ *
+ * @tparam Vectors A contiguous range of `vector<T, Length>`, with `T` float or double.
+ * @param generator The generator, advanced past the words used.
+ * @param vectors The vectors to fill.
+ * @param low The lower bound.
+ * @param high The upper bound.
+ * @param threads The number of threads, zero for the hardware concurrency. The values do not depend on it.
+ */
+template <std::ranges::contiguous_range Vectors, typename V = std::ranges::range_value_t<Vectors>,
+          typename T = typename V::value_type>
+  requires detail::is_vector_v<V> && random_real<T>
+void fill_uniform(philox &generator, Vectors &&vectors, std::type_identity_t<T> const low = T(0),
+                  std::type_identity_t<T> const high = T(1), std::size_t const threads = 1) {
+  detail::fill_uniform(generator, detail::random_target_of(vectors), low, high, threads);
+}
+
+/**
+ * @brief Fills a batch with elements drawn uniformly from `[low, high)`, writing each component contiguously.
+ *
+ * @param generator The generator, advanced past the words used.
+ * @param batch The batch to fill.
+ * @param low The lower bound.
+ * @param high The upper bound.
+ * @param threads The number of threads, zero for the hardware concurrency. The values do not depend on it.
+ */
+template <random_real T, std::size_t Length>
+void fill_uniform(philox &generator, vector_batch<T, Length> &batch, std::type_identity_t<T> const low = T(0),
+                  std::type_identity_t<T> const high = T(1), std::size_t const threads = 1) {
+  detail::fill_uniform(generator, detail::random_target_of(batch), low, high, threads);
+}
+
+/**
+ * @brief Fills vectors with normally distributed elements, generated in pairs with the Box–Muller transform.
+ *
+ * @tparam Vectors A contiguous range of `vector<T, Length>`, with `T` float or double.
+ * @param generator The generator, advanced past the words used.
+ * @param vectors The vectors to fill.
+ * @param mean The mean.
+ * @param stddev The standard deviation.
+ * @param threads The number of threads, zero for the hardware concurrency. The values do not depend on it.
+ */
+template <std::ranges::contiguous_range Vectors, typename V = std::ranges::range_value_t<Vectors>,
+          typename T = typename V::value_type>
+  requires detail::is_vector_v<V> && random_real<T>
+void fill_normal(philox &generator, Vectors &&vectors, std::type_identity_t<T> const mean = T(0),
+                 std::type_identity_t<T> const stddev = T(1), std::size_t const threads = 1) {
+  detail::fill_normal(generator, detail::random_target_of(vectors), mean, stddev, threads);
+}
+
+/**
+ * @brief Fills a batch with normally distributed elements, generated in pairs with the Box–Muller transform.
+ *
+ * @param generator The generator, advanced past the words used.
+ * @param batch The batch to fill.
+ * @param mean The mean.
+ * @param stddev The standard deviation.
+ * @param threads The number of threads, zero for the hardware concurrency. The values do not depend on it.
+ */
+template <random_real T, std::size_t Length>
+void fill_normal(philox &generator, vector_batch<T, Length> &batch, std::type_identity_t<T> const mean = T(0),
+                 std::type_identity_t<T> const stddev = T(1), std::size_t const threads = 1) {
+  detail::fill_normal(generator, detail::random_target_of(batch), mean, stddev, threads);
+}
+
+/**
+ * @brief Fills vectors with directions drawn uniformly from the unit sphere, without rejection sampling.
+ *
+ * @tparam Vectors A contiguous range of `vector<T, Length>`, with `T` float or double.
+ * @param generator The generator, advanced past the words used.
+ * @param vectors The vectors to fill.
+ * @param threads The number of threads, zero for the hardware concurrency. The values do not depend on it.
+ */
+template <std::ranges::contiguous_range Vectors, typename V = std::ranges::range_value_t<Vectors>,
+          typename T = typename V::value_type>
+  requires detail::is_vector_v<V> && random_real<T>
+void fill_unit_sphere(philox &generator, Vectors &&vectors, std::size_t const threads = 1) {
+  detail::fill_unit_sphere(generator, detail::random_target_of(vectors), threads);
+}
+
+/**
+ * @brief Fills a batch with directions drawn uniformly from the unit sphere, without rejection sampling.
+ *
+ * @param generator The generator, advanced past the words used.
+ * @param batch The batch to fill.
+ * @param threads The number of threads, zero for the hardware concurrency. The values do not depend on it.
+ */
+template <random_real T, std::size_t Length>
+void fill_unit_sphere(philox &generator, vector_batch<T, Length> &batch, std::size_t const threads = 1) {
+  detail::fill_unit_sphere(generator, detail::random_target_of(batch), threads);
+}
+
+/**
+ * @brief Fills vectors with points drawn uniformly from the unit ball, without rejection sampling.
+ *
+ * @tparam Vectors A contiguous range of `vector<T, Length>`, with `T` float or double.
+ * @param generator The generator, advanced past the words used.
+ * @param vectors The vectors to fill.
+ * @param threads The number of threads, zero for the hardware concurrency. The values do not depend on it.
+ */
+template <std::ranges::contiguous_range Vectors, typename V = std::ranges::range_value_t<Vectors>,
+          typename T = typename V::value_type>
+  requires detail::is_vector_v<V> && random_real<T>
+void fill_unit_ball(philox &generator, Vectors &&vectors, std::size_t const threads = 1) {
+  detail::fill_unit_ball(generator, detail::random_target_of(vectors), threads);
+}
+
+/**
+ * @brief Fills a batch with points drawn uniformly from the unit ball, without rejection sampling.
+ *
+ * @param generator The generator, advanced past the words used.
+ * @param batch The batch to fill.
+ * @param threads The number of threads, zero for the hardware concurrency. The values do not depend on it.
+ */
+template <random_real T, std::size_t Length>
+void fill_unit_ball(philox &generator, vector_batch<T, Length> &batch, std::size_t const threads = 1) {
+  detail::fill_unit_ball(generator, detail::random_target_of(batch), threads);
+}
+
+} // namespace firefly
@@ -0,0 +1,317 @@
+#pragma once
+
+#include <cstddef>
+#include <ranges>
+#include <stdexcept>
+#include <vector>
+
+#include "firefly/detail/parallel.hpp"
+#include "firefly/mask.hpp"
+#include "firefly/vector.hpp"
+
+namespace firefly {
+
+/**
+ * @brief Number of elements from which the range scans use more than one thread by default.
+ *
+ * Below this size the cost of starting threads outweighs the second pass over the data.
+ */
+inline constexpr std::size_t parallel_scan_threshold = std::size_t(1) << 16;
+
+namespace detail {
+
+/// @brief Width of the in-register blocks used by the scan kernels.
+inline constexpr std::size_t scan_width = 8;
+
+/**
+ * @brief Inclusive prefix sum of `n` elements starting from `carry`, returning the final running total.
+ *
+ * The input is processed in blocks of #scan_width elements. Each block is scanned in registers with log2(width)
+ * shifted additions (Hillis-Steele) and then offset by the running total, which shortens the dependency chain
+ * compared to a strictly sequential loop. `out` may alias `in`.
+ */
+template <typename T>
+constexpr T inclusive_scan_n(T const *in, T *out, std::size_t n, T carry) {
+  std::size_t i = 0;
+  for (; i + scan_width <= n; i += scan_width) {
+    T lanes[scan_width];
+    for (std::size_t lane = 0; lane < scan_width; ++lane) {
+      lanes[lane] = in[i + lane];
+    }
+    for (std::size_t shift = 1; shift < scan_width; shift *= 2) {
+      for (std::size_t lane = scan_width - 1; lane >= shift; --lane) {
+        lanes[lane] += lanes[lane - shift];
+      }
+    }
+    for (std::size_t lane = 0; lane < scan_width; ++lane) {
+      out[i + lane] = carry + lanes[lane];
+    }
+    carry = out[i + scan_width - 1];
+  }
+  for (; i < n; ++i) {
+    carry += in[i];
+    out[i] = carry;
+  }
+  return carry;
+}
+
+/**
+ * @brief Exclusive prefix sum of `n` elements starting from `carry`, returning the final running total.
+ *
+ * Uses the same in-register blocks as inclusive_scan_n. `out` may alias `in`.
+ */
+template <typename T>
+constexpr T exclusive_scan_n(T const *in, T *out, std::size_t n, T carry) {
+  std::size_t i = 0;
+  for (; i + scan_width <= n; i += scan_width) {
+    T lanes[scan_width];
+    for (std::size_t lane = 0; lane < scan_width; ++lane) {
+      lanes[lane] = in[i + lane];
+    }
+    for (std::size_t shift = 1; shift < scan_width; shift *= 2) {
+      for (std::size_t lane = scan_width - 1; lane >= shift; --lane) {
+        lanes[lane] += lanes[lane - shift];
+      }
+    }
+    for (std::size_t lane = 0; lane < scan_width; ++lane) {
+      out[i + lane] = lane == 0 ? carry : carry + lanes[lane - 1];
+    }
+    carry = carry + lanes[scan_width - 1];
+  }
+  for (; i < n; ++i) {
+    T const value = in[i];
+    out[i] = carry;
+    carry += value;
+  }
+  return carry;
+}
+
+/**
+ * @brief Segmented inclusive prefix sum, restarting the running total wherever `starts` is set.
+ *
+ * @return The final running total.
+ */
+template <typename T>
+constexpr T segmented_scan_n(T const *in, bool const *starts, T *out, std::size_t n, T carry) {
+  for (std::size_t i = 0; i < n; ++i) {
+    carry = starts[i] ? in[i] : carry + in[i];
+    out[i] = carry;
+  }
+  return carry;
+}
+
+template <typename In, typename Out>
+auto scan_spans(In const &in, Out &out) {
+  if (std::ranges::size(out) < std::ranges::size(in)) {
+    throw std::invalid_argument("Output range must be at least as large as the input range");
+  }
+  return std::pair{std::ranges::data(in), std::ranges::data(out)};
+}
+
+inline std::size_t scan_blocks(std::size_t n, std::size_t threads) {
+  if (threads == 0 && n < parallel_scan_threshold) {
+    return 1;
+  }
+  return resolve_threads(threads, n);
+}
+
+/**
+ * @brief Two-pass block scan shared by the inclusive and exclusive range scans.
+ *
+ * Pass one scans every block independently (block 0 starting from `init`) and records its total. The block offsets
+ * are then accumulated sequentially in block order, and pass two adds each block's offset to its elements. The block
+ * layout only depends on the number of elements and threads, so results are reproducible for a fixed thread count.
+ */
+template <typename T, typename Kernel>
+void block_scan(T const *in, T *out, std::size_t n, T init, std::size_t threads, Kernel kernel) {
+  std::size_t const blocks = scan_blocks(n, threads);
+  std::vector<T> totals(blocks);
+
+  parallel_for(blocks, blocks, [&](std::size_t block) {
+    std::size_t const begin = n * block / blocks;
+    std::size_t const end = n * (block + 1) / blocks;
+    totals[block] = kernel(in + begin, out + begin, end - begin, block == 0 ? init : T(0));
+  });
+
+  std::vector<T> offsets(blocks, T(0));
+  for (std::size_t block = 1; block < blocks; ++block) {
+    offsets[block] = block == 1 ? totals[0] : offsets[block - 1] + totals[block - 1];
+  }
+
+  parallel_for(blocks, blocks, [&](std::size_t block) {
+    if (block == 0) {
+      return;
+    }
+    std::size_t const begin = n * block / blocks;
+    std::size_t const end = n * (block + 1) / blocks;
+    for (std::size_t i = begin; i < end; ++i) {
+      out[i] = offsets[block] + out[i];
+    }
+  });
+}
+
+} // namespace detail
+
+/**
+ * @brief Computes the inclusive prefix sum of a vector, `result[i] = v[0] + ... + v[i]`.
+ *
+ * Integer results are exact. Floating point results are deterministic but, because blocks of elements are summed in
+ * registers, may differ in the last bits from a strictly sequential sum.
+ *
+ * @tparam T The type of elements in the vector.
+ * @tparam Length The number of elements.
+ * @param v The vector to scan.
+ * @return A new vector holding the running totals.
+ */
+template <vector_type T, std::size_t Length>
+[[nodiscard]] constexpr auto inclusive_scan(vector<T, Length> const &v) {
+  vector<T, Length> result;
+  detail::inclusive_scan_n(v.data(), result.data(), Length, T(0));
+  return result;
+}
+
+/**
+ * @brief Computes the exclusive prefix sum of a vector, `result[i] = init + v[0] + ... + v[i - 1]`.
+ *
+ * @tparam T The type of elements in the vector.
+ * @tparam Length The number of elements.
+ * @param v The vector to scan.
+ * @param init The value of the first element of the result.
+ * @return A new vector holding the running totals.
+ */
+template <vector_type T, std::size_t Length>
+[[nodiscard]] constexpr auto exclusive_scan(vector<T, Length> const &v, T init = T(0)) {
+  vector<T, Length> result;
+  detail::exclusive_scan_n(v.data(), result.data(), Length, init);
+  return result;
+}
+
+/**
+ * @brief Computes an inclusive prefix sum that restarts wherever `starts` is set.
+ *
+ * The first element always starts a segment.
+ *
+ * @tparam T The type of elements in the vector.
+ * @tparam Length The number of elements.
+ * @param v The vector to scan.
+ * @param starts The mask marking the first element of each segment.
+ * @return A new vector holding the running totals of each segment.
+ */
+template <vector_type T, std::size_t Length>
+[[nodiscard]] constexpr auto segmented_inclusive_scan(vector<T, Length> const &v, mask<Length> const &starts) {
+  vector<T, Length> result;
+  detail::segmented_scan_n(v.data(), starts.data(), result.data(), Length, T(0));
+  return result;
+}
+
+/**
+ * @brief Computes the inclusive prefix sum of a contiguous range into another range.
+ *
+ * Large inputs are split into one block per thread and scanned with a two-pass block scan. Integer results are exact;
+ * floating point results depend only on the number of threads, so pass an explicit `threads` for results that are
+ * reproducible across machines.
+ *
+ * @tparam In A contiguous input range.
+ * @tparam Out A contiguous output range with the same element type. It may be the input range itself.
+ * @param in The elements to scan.
+ * @param out The range receiving the running totals.
+ * @param threads The number of threads. Zero uses the hardware concurrency for inputs of at least
+ * #parallel_scan_threshold elements and one thread otherwise.
+ * @throws std::invalid_argument if `out` is smaller than `in`.
+ */
+template <std::ranges::contiguous_range In, std::ranges::contiguous_range Out>
+  requires vector_type<std::ranges::range_value_t<In>> &&
+           std::is_same_v<std::ranges::range_value_t<In>, std::ranges::range_value_t<Out>>
+void inclusive_scan(In const &in, Out &&out, std::size_t threads = 0) {
+  using T = std::ranges::range_value_t<In>;
+  auto [source, target] = detail::scan_spans(in, out);
+  detail::block_scan(source, target, std::ranges::size(in), T(0), threads,
+                     [](T const *a, T *b, std::size_t n, T carry) { return detail::inclusive_scan_n(a, b, n, carry); });
+}
+
+/**
+ * @brief Computes the exclusive prefix sum of a contiguous range into another range.
+ *
+ * @tparam In A contiguous input range.
+ * @tparam Out A contiguous output range with the same element type. It may be the input range itself.
+ * @param in The elements to scan.
+ * @param out The range receiving the running totals.
+ * @param init The value of the first element of the result.
+ * @param threads The number of threads, as for the inclusive range scan.
+ * @throws std::invalid_argument if `out` is smaller than `in`.
+ */
+template <std::ranges::contiguous_range In, std::ranges::contiguous_range Out>
+  requires vector_type<std::ranges::range_value_t<In>> &&
+           std::is_same_v<std::ranges::range_value_t<In>, std::ranges::range_value_t<Out>>
+void exclusive_scan(In const &in, Out &&out, std::ranges::range_value_t<In> init = {}, std::size_t threads = 0) {
+  using T = std::ranges::range_value_t<In>;
+  auto [source, target] = detail::scan_spans(in, out);
+  detail::block_scan(source, target, std::ranges::size(in), init, threads,
+                     [](T const *a, T *b, std::size_t n, T carry) { return detail::exclusive_scan_n(a, b, n, carry); });
+}
+
+/**
+ * @brief Computes a segmented inclusive prefix sum of a contiguous range into another range.
+ *
+ * The running total restarts wherever `starts` is set; the first element always starts a segment. Large inputs use
+ * the same two-pass block layout as the other range scans, carrying each block's tail only into the elements before
+ * the first segment start of the next block.
+ *
+ * @tparam In A contiguous input range.
+ * @tparam Starts A contiguous range of `bool` with one flag per input element.
+ * @tparam Out A contiguous output range with the same element type. It may be the input range itself.
+ * @param in The elements to scan.
+ * @param starts The flags marking the first element of each segment.
+ * @param out The range receiving the running totals.
+ * @param threads The number of threads, as for the inclusive range scan.
+ * @throws std::invalid_argument if `starts` or `out` is smaller than `in`.
+ */
+template <std::ranges::contiguous_range In, std::ranges::contiguous_range Starts, std::ranges::contiguous_range Out>
+  requires vector_type<std::ranges::range_value_t<In>> && std::is_same_v<std::ranges::range_value_t<Starts>, bool> &&
+           std::is_same_v<std::ranges::range_value_t<In>, std::ranges::range_value_t<Out>>
+void segmented_inclusive_scan(In const &in, Starts const &starts, Out &&out, std::size_t threads = 0) {
+  using T = std::ranges::range_value_t<In>;
+  auto [source, target] = detail::scan_spans(in, out);
+  std::size_t const n = std::ranges::size(in);
+  if (std::ranges::size(starts) < n) {
+    throw std::invalid_argument("Segment flags must cover the input range");
+  }
+  bool const *flags = std::ranges::data(starts);
+
+  std::size_t const blocks = detail::scan_blocks(n, threads);
+  std::vector<T> tails(blocks);
+  std::vector<std::size_t> first_start(blocks);
+
+  detail::parallel_for(blocks, blocks, [&](std::size_t block) {
+    std::size_t const begin = n * block / blocks;
+    std::size_t const end = n * (block + 1) / blocks;
+    tails[block] = detail::segmented_scan_n(source + begin, flags + begin, target + begin, end - begin, T(0));
+
+    std::size_t first = end;
+    for (std::size_t i = begin; i < end; ++i) {
+      if (flags[i]) {
+        first = i;
+        break;
+      }
+    }
+    first_start[block] = first;
+  });
+
+  std::vector<T> carries(blocks, T(0));
+  for (std::size_t block = 1; block < blocks; ++block) {
+    bool const restarted = first_start[block - 1] < n * block / blocks;
+    carries[block] = restarted ? tails[block - 1] : carries[block - 1] + tails[block - 1];
+  }
+
+  detail::parallel_for(blocks, blocks, [&](std::size_t block) {
+    if (block == 0) {
+      return;
+    }
+    std::size_t const begin = n * block / blocks;
+    for (std::size_t i = begin; i < first_start[block]; ++i) {
+      target[i] = carries[block] + target[i];
+    }
+  });
+}
+
+} // namespace firefly
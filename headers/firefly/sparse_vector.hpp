@@ -0,0 +1,522 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <limits>
+#include <ranges>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "firefly/detail/kernels.hpp"
+#include "firefly/detail/parallel.hpp"
+#include "firefly/indexing.hpp"
+#include "firefly/math.hpp"
+#include "firefly/vector.hpp"
+
+namespace firefly {
+
+namespace detail {
+
+/// @brief Index type used by the sparse containers. Dimensions up to 2^32 - 1 are supported.
+using sparse_index = std::uint32_t;
+
+/**
+ * @brief Size ratio from which the sparse–sparse dot product gallops through the longer operand instead of merging.
+ */
+inline constexpr std::size_t gallop_ratio = 8;
+
+/**
+ * @brief Dot product of a sparse vector, given as parallel index and value arrays, with a dense buffer.
+ *
+ * The dense elements are gathered with #reduction_lanes independent accumulators. Long index lists prefetch the
+ * dense elements a few entries ahead, as firefly::gather does.
+ */
+template <typename R, typename T, typename D>
+[[nodiscard]] R sparse_dense_dot_n(sparse_index const *indices, T const *values, std::size_t nnz, D const *dense) {
+  R acc[reduction_lanes] = {R(0), R(0), R(0), R(0)};
+  bool const prefetching = nnz >= gather_prefetch_threshold;
+
+  std::size_t k = 0;
+  for (; k + reduction_lanes <= nnz; k += reduction_lanes) {
+    if (prefetching && k + prefetch_distance < nnz) {
+      prefetch<false>(dense + indices[k + prefetch_distance]);
+    }
+    for (std::size_t lane = 0; lane < reduction_lanes; ++lane) {
+      acc[lane] += element_cast<R>(values[k + lane]) * element_cast<R>(dense[indices[k + lane]]);
+    }
+  }
+  for (; k < nnz; ++k) {
+    acc[0] += element_cast<R>(values[k]) * element_cast<R>(dense[indices[k]]);
+  }
+  return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+}
+
+/**
+ * @brief Dot product of two sparse vectors given as sorted index and value arrays.
+ *
+ * Operands of similar size are intersected with a linear merge. When one operand has at least #gallop_ratio times
+ * more entries, every index of the shorter one is located in the longer one with an exponential (galloping) search
+ * followed by a binary search, so the cost grows with the shorter operand times the logarithm of the gaps.
+ */
+template <typename R, typename A, typename B>
+[[nodiscard]] R sparse_sparse_dot_n(sparse_index const *a_indices, A const *a_values, std::size_t a_nnz,
+                                    sparse_index const *b_indices, B const *b_values, std::size_t b_nnz) {
+  if (a_nnz > b_nnz) {
+    return sparse_sparse_dot_n<R>(b_indices, b_values, b_nnz, a_indices, a_values, a_nnz);
+  }
+
+  R sum(0);
+  if (b_nnz >= gallop_ratio * a_nnz) {
+    std::size_t j = 0;
+    for (std::size_t i = 0; i < a_nnz && j < b_nnz; ++i) {
+      sparse_index const target = a_indices[i];
+      std::size_t high = j;
+      std::size_t step = 1;
+      while (high < b_nnz && b_indices[high] < target) {
+        j = high + 1;
+        high += step;
+        step *= 2;
+      }
+      j = std::lower_bound(b_indices + j, b_indices + std::min(high, b_nnz), target) - b_indices;
+      if (j < b_nnz && b_indices[j] == target) {
+        sum += element_cast<R>(a_values[i]) * element_cast<R>(b_values[j]);
+      }
+    }
+  } else {
+    std::size_t i = 0;
+    std::size_t j = 0;
+    while (i < a_nnz && j < b_nnz) {
+      if (a_indices[i] < b_indices[j]) {
+        ++i;
+      } else if (b_indices[j] < a_indices[i]) {
+        ++j;
+      } else {
+        sum += element_cast<R>(a_values[i++]) * element_cast<R>(b_values[j++]);
+      }
+    }
+  }
+  return sum;
+}
+
+} // namespace detail
+
+/**
+ * @class sparse_vector
+ * @brief A vector of runtime dimension that only stores its non-zero elements, as sorted index and value arrays.
+ *
+ * Memory use and the cost of every operation scale with the number of stored elements, not with the dimension, which
+ * makes the type suitable for high-dimensional features such as bag-of-words vectors.
+ *
+ * @tparam T The type of the elements, arithmetic or complex.
+ */
+template <vector_type T>
+class sparse_vector {
+public:
+  using value_type = T;
+  using index_type = detail::sparse_index;
+
+  /**
+   * @brief Default constructor that creates an empty vector of dimension zero.
+   */
+  sparse_vector() = default;
+
+  /**
+   * @brief Constructor that creates an all-zero vector of the given dimension.
+   *
+   * @param dimension The dimension of the vector.
+   * @throw std::length_error if the dimension cannot be addressed by index_type.
+   */
+  explicit sparse_vector(std::size_t const dimension) : _dimension(dimension) {
+    check_dimension(dimension);
+  }
+
+  /**
+   * @brief Constructor that takes ownership of index and value arrays.
+   *
+   * @param dimension The dimension of the vector.
+   * @param indices The positions of the stored elements, strictly increasing.
+   * @param values The stored elements, one per index.
+   * @throw std::length_error if the dimension cannot be addressed by index_type.
+   * @throw std::invalid_argument if the arrays differ in size or the indices are not strictly increasing.
+   * @throw std::out_of_range if an index is not less than the dimension.
+   */
+  sparse_vector(std::size_t const dimension, std::vector<index_type> indices, std::vector<T> values)
+      : _dimension(dimension), _indices(std::move(indices)), _values(std::move(values)) {
+    check_dimension(dimension);
+    if (_indices.size() != _values.size()) {
+      throw std::invalid_argument("Indices and values must have the same size");
+    }
+    if (std::adjacent_find(_indices.begin(), _indices.end(), std::greater_equal<>()) != _indices.end()) {
+      throw std::invalid_argument("Indices must be strictly increasing");
+    }
+    if (!_indices.empty() && _indices.back() >= dimension) {
+      throw std::out_of_range("Index exceeds sparse vector dimension");
+    }
+  }
+
+  /**
+   * @brief Constructor that stores the non-zero elements of a dense vector.
+   *
+   * @tparam Length The number of elements in the dense vector.
+   * @param dense The dense vector to convert.
+   */
+  template <std::size_t Length>
+  explicit sparse_vector(vector<T, Length> const &dense) : _dimension(Length) {
+    check_dimension(Length);
+    for (std::size_t i = 0; i < Length; ++i) {
+      if (dense[i] != T(0)) {
+        _indices.push_back(static_cast<index_type>(i));
+        _values.push_back(dense[i]);
+      }
+    }
+  }
+
+  /**
+   * @brief Returns the dimension of the vector.
+   */
+  [[nodiscard]] std::size_t dimension() const {
+    return _dimension;
+  }
+
+  /**
+   * @brief Returns the number of stored elements.
+   */
+  [[nodiscard]] std::size_t nnz() const {
+    return _values.size();
+  }
+
+  /**
+   * @brief Returns the positions of the stored elements, in increasing order.
+   */
+  [[nodiscard]] std::span<index_type const> indices() const {
+    return _indices;
+  }
+
+  /**
+   * @brief Returns the stored elements, in the order of indices().
+   */
+  [[nodiscard]] std::span<T const> values() const {
+    return _values;
+  }
+
+  /**
+   * @brief Looks up an element by position with a binary search over the stored indices.
+   *
+   * @param index The position of the element.
+   * @throw std::out_of_range if the index is not less than the dimension.
+   * @return The element, or zero if it is not stored.
+   */
+  [[nodiscard]] T at(std::size_t const index) const {
+    if (index >= _dimension) {
+      throw std::out_of_range("Index exceeds sparse vector dimension");
+    }
+    auto const it = std::lower_bound(_indices.begin(), _indices.end(), index);
+    if (it == _indices.end() || *it != index) {
+      return T(0);
+    }
+    return _values[it - _indices.begin()];
+  }
+
+  /**
+   * @brief Adds another sparse vector by merging the stored elements of both vectors.
+   *
+   * @tparam U The type of elements in the other vector.
+   * @param other The vector to add.
+   * @throw std::invalid_argument if the dimensions differ.
+   * @return A new sparse vector storing the union of both sets of positions.
+   */
+  template <vector_type U>
+  [[nodiscard]] auto add(sparse_vector<U> const &other) const {
+    using R = common_type_t<T, U>;
+    check_same_dimension(other.dimension());
+
+    auto const a_indices = indices();
+    auto const b_indices = other.indices();
+    auto const b_values = other.values();
+    std::vector<index_type> indices;
+    std::vector<R> values;
+    indices.reserve(nnz() + other.nnz());
+    values.reserve(nnz() + other.nnz());
+
+    std::size_t i = 0;
+    std::size_t j = 0;
+    while (i < a_indices.size() || j < b_indices.size()) {
+      if (j == b_indices.size() || (i < a_indices.size() && a_indices[i] < b_indices[j])) {
+        indices.push_back(a_indices[i]);
+        values.push_back(detail::element_cast<R>(_values[i++]));
+      } else if (i == a_indices.size() || b_indices[j] < a_indices[i]) {
+        indices.push_back(b_indices[j]);
+        values.push_back(detail::element_cast<R>(b_values[j++]));
+      } else {
+        indices.push_back(a_indices[i]);
+        values.push_back(detail::element_cast<R>(_values[i++]) + detail::element_cast<R>(b_values[j++]));
+      }
+    }
+    return sparse_vector<R>(_dimension, std::move(indices), std::move(values));
+  }
+
+  /**
+   * @brief Multiplies every stored element by a scalar.
+   *
+   * @tparam U The type of the scalar.
+   * @param scalar The scalar to multiply by.
+   * @return A new sparse vector with the same positions.
+   */
+  template <vector_type U>
+  [[nodiscard]] auto scale(U const &scalar) const {
+    using R = common_type_t<T, U>;
+    using C = detail::compute_type_t<R>;
+    std::vector<R> values(nnz());
+    detail::unary_n<C>(_values.data(), values.data(), nnz(),
+                       [scalar = detail::element_cast<C>(scalar)](C const &el) { return el * scalar; });
+    return sparse_vector<R>(_dimension, _indices, std::move(values));
+  }
+
+  /**
+   * @brief Calculates the dot product with another sparse vector.
+   *
+   * Only positions stored in both vectors contribute. Vectors of very different density are intersected by galloping
+   * through the denser one.
+   *
+   * @tparam U The type of elements in the other vector.
+   * @param other The vector to compute the dot product with.
+   * @throw std::invalid_argument if the dimensions differ.
+   * @return The dot product, with type `common_type_t<T, U>`.
+   */
+  template <vector_type U>
+  [[nodiscard]] auto dot(sparse_vector<U> const &other) const {
+    using R = common_type_t<T, U>;
+    check_same_dimension(other.dimension());
+    return detail::sparse_sparse_dot_n<R>(_indices.data(), _values.data(), nnz(), other.indices().data(),
+                                          other.values().data(), other.nnz());
+  }
+
+  /**
+   * @brief Calculates the dot product with a dense vector by gathering the elements at the stored positions.
+   *
+   * Accepts a firefly::vector as well as any contiguous buffer, such as `std::vector` or `std::span`, whose size
+   * equals the dimension.
+   *
+   * @tparam Dense A contiguous range of arithmetic or complex elements.
+   * @param dense The dense vector to compute the dot product with.
+   * @throw std::invalid_argument if the size of the dense vector differs from the dimension.
+   * @return The dot product, with type `common_type_t<T, U>` where `U` is the dense element type.
+   */
+  template <std::ranges::contiguous_range Dense>
+    requires vector_type<std::ranges::range_value_t<Dense>>
+  [[nodiscard]] auto dot(Dense const &dense) const {
+    using R = common_type_t<T, std::ranges::range_value_t<Dense>>;
+    check_same_dimension(std::ranges::size(dense));
+    return detail::sparse_dense_dot_n<R>(_indices.data(), _values.data(), nnz(), std::ranges::data(dense));
+  }
+
+  /**
+   * @brief Computes the squared Euclidean magnitude of the vector from the stored elements.
+   *
+   * @return The squared magnitude, with the element type for real vectors and `double` for complex vectors.
+   */
+  [[nodiscard]] auto squared_norm() const {
+    if constexpr (is_complex_v<T>) {
+      return detail::reduce_n(
+          _values.data(), nnz(), 0.0,
+          [](T const &val) { return double(val.real()) * double(val.real()) + double(val.imag()) * double(val.imag()); },
+          std::plus<>());
+    } else {
+      return detail::reduce_n(_values.data(), nnz(), T(0), [](T const &val) { return val * val; }, std::plus<>());
+    }
+  }
+
+  /**
+   * @brief Computes the Euclidean magnitude of the vector.
+   *
+   * @return The magnitude, as a floating point value.
+   */
+  [[nodiscard]] auto norm() const {
+    return math::sqrt(squared_norm());
+  }
+
+  /**
+   * @brief Compares two sparse vectors for equality of dimension, positions and stored elements.
+   *
+   * Explicitly stored zeros are significant, so a vector is only equal to one built from the same entries.
+   */
+  [[nodiscard]] bool operator==(sparse_vector const &other) const = default;
+
+  /**
+   * @brief Converts the vector to a string representation in the format "{dimension; index: value, ...}".
+   *
+   * @param precision The precision used for floating point values.
+   * @return A string representation of the vector.
+   */
+  [[nodiscard]] std::string view(int precision = 20) const {
+    std::stringstream ss;
+    ss << std::setprecision(precision) << "{" << _dimension << ";";
+    for (std::size_t k = 0; k < nnz(); ++k) {
+      ss << (k == 0 ? " " : ", ") << _indices[k] << ": " << _values[k];
+    }
+    ss << "}";
+    return ss.str();
+  }
+
+  /**
+   * @brief Stream insertion operator for sparse vectors.
+   *
+   * @param os The output stream.
+   * @param other The vector to be output.
+   * @return The output stream with the vector representation.
+   */
+  friend std::ostream &operator<<(std::ostream &os, sparse_vector const &other) {
+    os << other.view();
+    return os;
+  }
+
+private:
+  std::size_t _dimension = 0;
+  std::vector<index_type> _indices;
+  std::vector<T> _values;
+
+  static void check_dimension(std::size_t const dimension) {
+    if (dimension > std::size_t(std::numeric_limits<index_type>::max())) {
+      throw std::length_error("Sparse vector dimension exceeds the index type range");
+    }
+  }
+
+  void check_same_dimension(std::size_t const dimension) const {
+    if (dimension != _dimension) {
+      throw std::invalid_argument("Sparse vector dimensions must match");
+    }
+  }
+};
+
+/**
+ * @class sparse_batch
+ * @brief A batch of sparse vectors of the same dimension stored in compressed sparse row (CSR) form.
+ *
+ * The rows share three arrays: the row offsets, the column indices and the values. Scoring a dense query against
+ * every row then walks the index and value arrays once, front to back.
+ *
+ * @tparam T The type of the elements, arithmetic or complex.
+ */
+template <vector_type T>
+class sparse_batch {
+public:
+  using value_type = T;
+  using index_type = detail::sparse_index;
+
+  /**
+   * @brief Constructor that creates an empty batch for vectors of the given dimension.
+   *
+   * @param dimension The dimension of every row.
+   */
+  explicit sparse_batch(std::size_t const dimension) : _dimension(dimension) {}
+
+  /**
+   * @brief Reserves storage for a number of rows and stored elements.
+   *
+   * @param rows The expected number of rows.
+   * @param nnz The expected total number of stored elements.
+   */
+  void reserve(std::size_t const rows, std::size_t const nnz) {
+    _offsets.reserve(rows + 1);
+    _indices.reserve(nnz);
+    _values.reserve(nnz);
+  }
+
+  /**
+   * @brief Appends a sparse vector as the last row.
+   *
+   * @param row The vector to append.
+   * @throw std::invalid_argument if the dimension of the vector differs from the batch dimension.
+   */
+  void push_back(sparse_vector<T> const &row) {
+    if (row.dimension() != _dimension) {
+      throw std::invalid_argument("Sparse vector dimensions must match");
+    }
+    _indices.insert(_indices.end(), row.indices().begin(), row.indices().end());
+    _values.insert(_values.end(), row.values().begin(), row.values().end());
+    _offsets.push_back(_values.size());
+  }
+
+  /**
+   * @brief Returns the number of rows.
+   */
+  [[nodiscard]] std::size_t size() const {
+    return _offsets.size() - 1;
+  }
+
+  /**
+   * @brief Returns the dimension of every row.
+   */
+  [[nodiscard]] std::size_t dimension() const {
+    return _dimension;
+  }
+
+  /**
+   * @brief Returns the total number of stored elements.
+   */
+  [[nodiscard]] std::size_t nnz() const {
+    return _values.size();
+  }
+
+  /**
+   * @brief Copies a row out of the batch.
+   *
+   * @param row The row number.
+   * @throw std::out_of_range if the row number is not less than size().
+   * @return The row as a sparse vector.
+   */
+  [[nodiscard]] sparse_vector<T> row(std::size_t const row) const {
+    if (row >= size()) {
+      throw std::out_of_range("Row exceeds sparse batch size");
+    }
+    auto const begin = _offsets[row];
+    auto const end = _offsets[row + 1];
+    return sparse_vector<T>(_dimension, std::vector<index_type>(_indices.begin() + begin, _indices.begin() + end),
+                            std::vector<T>(_values.begin() + begin, _values.begin() + end));
+  }
+
+  /**
+   * @brief Scores a dense query against every row.
+   *
+   * Rows are split into contiguous ranges, one per thread, and every score is computed by the same kernel as
+   * sparse_vector::dot, so the result does not depend on the number of threads.
+   *
+   * @tparam Dense A contiguous range of arithmetic or complex elements.
+   * @param dense The dense query.
+   * @param threads The number of threads, zero for the hardware concurrency.
+   * @throw std::invalid_argument if the size of the query differs from the dimension.
+   * @return One dot product per row, with type `common_type_t<T, U>` where `U` is the query element type.
+   */
+  template <std::ranges::contiguous_range Dense>
+    requires vector_type<std::ranges::range_value_t<Dense>>
+  [[nodiscard]] auto dot(Dense const &dense, std::size_t const threads = 1) const {
+    using R = common_type_t<T, std::ranges::range_value_t<Dense>>;
+    if (std::ranges::size(dense) != _dimension) {
+      throw std::invalid_argument("Sparse vector dimensions must match");
+    }
+
+    auto const *query = std::ranges::data(dense);
+    std::vector<R> scores(size());
+    detail::parallel_for(size(), detail::resolve_threads(threads, size()), [&](std::size_t row) {
+      auto const begin = _offsets[row];
+      scores[row] = detail::sparse_dense_dot_n<R>(_indices.data() + begin, _values.data() + begin,
+                                                  _offsets[row + 1] - begin, query);
+    });
+    return scores;
+  }
+
+private:
+  std::size_t _dimension;
+  std::vector<std::size_t> _offsets{0};
+  std::vector<index_type> _indices;
+  std::vector<T> _values;
+};
+
+} // namespace firefly
@@ -0,0 +1,626 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "firefly/batch.hpp"
+#include "firefly/detail/parallel.hpp"
+#include "firefly/linalg.hpp"
+#include "firefly/vector.hpp"
+
+namespace firefly {
+
+namespace detail {
+
+/// @brief Number of samples centred and folded into the co-moment matrix together.
+inline constexpr std::size_t covariance_block = 64;
+
+/// @brief Number of co-moment rows updated by a whole block of samples while they stay in cache.
+inline constexpr std::size_t covariance_row_tile = 16;
+
+/// @brief Number of samples transposed into per-dimension arrays before their moments are computed.
+inline constexpr std::size_t moments_block = 256;
+
+/**
+ * @brief Two-pass mean, sum of squared deviations, minimum and maximum of `n > 0` contiguous values. Every pass is a
+ * branch-free loop that vectorises.
+ */
+template <typename T>
+void moments_n(T const *x, std::size_t const n, T &mean, T &m2, T &min, T &max) {
+  T sum = T(0);
+  T lo = x[0];
+  T hi = x[0];
+  for (std::size_t i = 0; i < n; ++i) {
+    sum += x[i];
+    lo = x[i] < lo ? x[i] : lo;
+    hi = x[i] > hi ? x[i] : hi;
+  }
+  mean = sum / T(n);
+  T squares = T(0);
+  for (std::size_t i = 0; i < n; ++i) {
+    T const deviation = x[i] - mean;
+    squares += deviation * deviation;
+  }
+  m2 = squares;
+  min = lo;
+  max = hi;
+}
+
+} // namespace detail
+
+/**
+ * @class covariance_accumulator
+ * @brief Accumulates the mean vector and covariance matrix of a stream of vectors.
+ *
+ * The accumulator keeps the count, the mean and the co-moment matrix `Σ (x - mean)(x - mean)ᵀ` rather than raw sums,
+ * so it does not lose precision when the mean is large compared with the spread. Batches of samples are centred on
+ * their own mean and added to the co-moment as blocked outer products, and accumulators built over separate shards
+ * combine exactly with merge().
+ *
+ * @tparam T The floating point type of the elements.
+ * @tparam Length The number of elements of the vectors.
+ */
+template <std::floating_point T, std::size_t Length>
+class covariance_accumulator {
+public:
+  using value_type = vector<T, Length>;
+
+  /**
+   * @brief Default constructor that creates an empty accumulator.
+   */
+  covariance_accumulator() : _comoment(Length * Length, T(0)) {}
+
+  /**
+   * @brief Adds one sample.
+   *
+   * @param x The sample.
+   */
+  void add(value_type const &x) {
+    ++_count;
+    T const weight = T(1) / T(_count);
+    value_type delta;
+    value_type updated;
+    for (std::size_t d = 0; d < Length; ++d) {
+      delta[d] = x[d] - _mean[d];
+      _mean[d] += delta[d] * weight;
+      updated[d] = x[d] - _mean[d];
+    }
+    for (std::size_t i = 0; i < Length; ++i) {
+      T *row = _comoment.data() + i * Length;
+      for (std::size_t j = i; j < Length; ++j) {
+        row[j] += delta[i] * updated[j];
+      }
+    }
+  }
+
+  /**
+   * @brief Adds a range of samples.
+   *
+   * With more than one thread, every thread accumulates a contiguous share of the samples on its own and the partial
+   * accumulators are merged in order, so the result only depends on the samples and the number of threads.
+   *
+   * @tparam Samples A contiguous range of `vector<T, Length>`.
+   * @param samples The samples.
+   * @param threads The number of threads, zero for the hardware concurrency.
+   */
+  template <std::ranges::contiguous_range Samples>
+    requires std::is_same_v<std::ranges::range_value_t<Samples>, value_type>
+  void add(Samples const &samples, std::size_t const threads = 1) {
+    value_type const *x = std::ranges::data(samples);
+    std::size_t const n = std::ranges::size(samples);
+    std::size_t const workers = detail::resolve_threads(threads, n / detail::covariance_block);
+    if (workers <= 1) {
+      add_blocks(x, n);
+      return;
+    }
+    std::vector<covariance_accumulator> partial(workers);
+    detail::parallel_for(workers, workers, [&](std::size_t worker) {
+      std::size_t const begin = n * worker / workers;
+      partial[worker].add_blocks(x + begin, n * (worker + 1) / workers - begin);
+    });
+    for (auto const &shard : partial) {
+      merge(shard);
+    }
+  }
+
+  /**
+   * @brief Adds the samples of another accumulator, as if they had been added to this one.
+   *
+   * @param other The accumulator to merge.
+   */
+  void merge(covariance_accumulator const &other) {
+    merge(other._count, other._mean, other._comoment.data());
+  }
+
+  /**
+   * @brief Returns the number of samples.
+   */
+  [[nodiscard]] std::size_t count() const {
+    return _count;
+  }
+
+  /**
+   * @brief Returns the mean of the samples.
+   *
+   * @throw std::logic_error if no sample was added.
+   */
+  [[nodiscard]] value_type mean() const {
+    if (_count == 0) {
+      throw std::logic_error("Cannot compute the mean of an empty accumulator");
+    }
+    return _mean;
+  }
+
+  /**
+   * @brief Returns the covariance matrix of the samples.
+   *
+   * @param unbiased Whether to divide the co-moment by `count - 1` (sample covariance) instead of `count`.
+   * @throw std::logic_error if there are not enough samples for the requested estimate.
+   * @return The `Length × Length` symmetric covariance matrix in row-major order.
+   */
+  [[nodiscard]] std::vector<T> covariance(bool const unbiased = true) const {
+    if (_count < (unbiased ? 2u : 1u)) {
+      throw std::logic_error("Not enough samples to compute a covariance");
+    }
+    T const scale = T(1) / T(unbiased ? _count - 1 : _count);
+    std::vector<T> result(Length * Length);
+    for (std::size_t i = 0; i < Length; ++i) {
+      for (std::size_t j = i; j < Length; ++j) {
+        T const value = _comoment[i * Length + j] * scale;
+        result[i * Length + j] = value;
+        result[j * Length + i] = value;
+      }
+    }
+    return result;
+  }
+
+private:
+  std::size_t _count = 0;
+  value_type _mean;
+  // Only the upper triangle is kept up to date.
+  std::vector<T> _comoment;
+
+  void merge(std::size_t const count, value_type const &mean, T const *comoment) {
+    if (count == 0) {
+      return;
+    }
+    std::size_t const total = _count + count;
+    T const weight = T(_count) * T(count) / T(total);
+    value_type delta;
+    for (std::size_t d = 0; d < Length; ++d) {
+      delta[d] = mean[d] - _mean[d];
+      _mean[d] += delta[d] * (T(count) / T(total));
+    }
+    for (std::size_t i = 0; i < Length; ++i) {
+      T *row = _comoment.data() + i * Length;
+      T const *other = comoment + i * Length;
+      T const scaled = delta[i] * weight;
+      for (std::size_t j = i; j < Length; ++j) {
+        row[j] += other[j] + scaled * delta[j];
+      }
+    }
+    _count = total;
+  }
+
+  /**
+   * @brief Adds samples a block at a time: each block is centred on its own mean, its co-moment is built as a sum of
+   * outer products with the rows tiled so that the block is reused while they stay in cache, and it is merged in.
+   */
+  void add_blocks(value_type const *x, std::size_t const n) {
+    std::vector<T> centred(detail::covariance_block * Length);
+    std::vector<T> block(Length * Length);
+    for (std::size_t first = 0; first < n; first += detail::covariance_block) {
+      std::size_t const count = std::min(detail::covariance_block, n - first);
+      value_type mean;
+      for (std::size_t s = 0; s < count; ++s) {
+        for (std::size_t d = 0; d < Length; ++d) {
+          mean[d] += x[first + s][d];
+        }
+      }
+      T const inverse = T(1) / T(count);
+      for (std::size_t d = 0; d < Length; ++d) {
+        mean[d] *= inverse;
+      }
+      for (std::size_t s = 0; s < count; ++s) {
+        for (std::size_t d = 0; d < Length; ++d) {
+          centred[s * Length + d] = x[first + s][d] - mean[d];
+        }
+      }
+
+      std::fill(block.begin(), block.end(), T(0));
+      for (std::size_t i0 = 0; i0 < Length; i0 += detail::covariance_row_tile) {
+        std::size_t const i1 = std::min(i0 + detail::covariance_row_tile, Length);
+        for (std::size_t s = 0; s < count; ++s) {
+          T const *row = centred.data() + s * Length;
+          for (std::size_t i = i0; i < i1; ++i) {
+            T const xi = row[i];
+            T *target = block.data() + i * Length;
+            for (std::size_t j = i; j < Length; ++j) {
+              target[j] += xi * row[j];
+            }
+          }
+        }
+      }
+      merge(count, mean, block.data());
+    }
+  }
+};
+
+/**
+ * @class running_statistics
+ * @brief Online per-dimension mean, variance, minimum and maximum of a stream of vectors.
+ *
+ * Single samples are added with Welford's update, which needs one division per sample and stays accurate when the
+ * mean is large compared with the spread, unlike running sums of values and squares. Ranges of vectors and
+ * vector_batch batches are reduced per dimension with a two-pass kernel over contiguous values and folded in with
+ * the pairwise update of Chan et al., which also merges accumulators built on separate shards. Samples can be
+ * removed again to maintain the statistics of a sliding window; the minimum and maximum are not windowed and keep
+ * covering every sample ever added.
+ *
+ * @tparam T The floating point type of the elements.
+ * @tparam Length The number of elements of the vectors.
+ */
+template <std::floating_point T, std::size_t Length>
+class running_statistics {
+public:
+  using value_type = vector<T, Length>;
+
+  /**
+   * @brief Adds one sample.
+   *
+   * @param x The sample.
+   */
+  void add(value_type const &x) {
+    ++_count;
+    T const weight = T(1) / T(_count);
+    for (std::size_t d = 0; d < Length; ++d) {
+      T const delta = x[d] - _mean[d];
+      _mean[d] += delta * weight;
+      _m2[d] += delta * (x[d] - _mean[d]);
+      _min[d] = x[d] < _min[d] ? x[d] : _min[d];
+      _max[d] = x[d] > _max[d] ? x[d] : _max[d];
+    }
+  }
+
+  /**
+   * @brief Adds a range of samples.
+   *
+   * The samples are transposed a block at a time into per-dimension arrays, whose moments are merged in. Blocks are
+   * reduced in parallel and merged in order, so the result does not depend on the number of threads.
+   *
+   * @tparam Samples A contiguous range of `vector<T, Length>`.
+   * @param samples The samples.
+   * @param threads The number of threads, zero for the hardware concurrency.
+   */
+  template <std::ranges::contiguous_range Samples>
+    requires std::is_same_v<std::ranges::range_value_t<Samples>, value_type>
+  void add(Samples const &samples, std::size_t const threads = 1) {
+    value_type const *x = std::ranges::data(samples);
+    std::size_t const n = std::ranges::size(samples);
+    add_blocks(n, threads, [&](running_statistics &shard, std::size_t first, std::size_t count, T *scratch) {
+      for (std::size_t i = 0; i < count; ++i) {
+        for (std::size_t d = 0; d < Length; ++d) {
+          scratch[d * detail::moments_block + i] = x[first + i][d];
+        }
+      }
+      shard.merge_columns(count, [&](std::size_t d) { return scratch + d * detail::moments_block; });
+    });
+  }
+
+  /**
+   * @brief Adds every vector of a structure-of-arrays batch, reducing each component array directly. The result is
+   * the same as adding the vectors as a range.
+   *
+   * @param batch The samples.
+   * @param threads The number of threads, zero for the hardware concurrency.
+   */
+  void add(vector_batch<T, Length> const &batch, std::size_t const threads = 1) {
+    add_blocks(batch.size(), threads, [&](running_statistics &shard, std::size_t first, std::size_t count, T *) {
+      shard.merge_columns(count, [&](std::size_t d) { return batch.component(d).data() + first; });
+    });
+  }
+
+  /**
+   * @brief Removes a sample that was added before, reversing Welford's update.
+   *
+   * Only the count, mean and variance are updated; the minimum and maximum are left unchanged, even when the
+   * accumulator becomes empty.
+   *
+   * @param x The sample to remove.
+   * @throw std::logic_error if the accumulator is empty.
+   */
+  void remove(value_type const &x) {
+    if (_count == 0) {
+      throw std::logic_error("Cannot remove a sample from an empty accumulator");
+    }
+    if (--_count == 0) {
+      _mean = value_type();
+      _m2 = value_type();
+      return;
+    }
+    T const weight = T(1) / T(_count);
+    for (std::size_t d = 0; d < Length; ++d) {
+      T const mean = _mean[d] + (_mean[d] - x[d]) * weight;
+      T const m2 = _m2[d] - (x[d] - mean) * (x[d] - _mean[d]);
+      _mean[d] = mean;
+      _m2[d] = m2 < T(0) ? T(0) : m2;
+    }
+  }
+
+  /**
+   * @brief Adds the samples of another accumulator, as if they had been added to this one.
+   *
+   * @param other The accumulator to merge.
+   */
+  void merge(running_statistics const &other) {
+    merge(other._count, other._mean, other._m2, other._min, other._max);
+  }
+
+  /**
+   * @brief Returns the number of samples.
+   */
+  [[nodiscard]] std::size_t count() const {
+    return _count;
+  }
+
+  /**
+   * @brief Returns the per-dimension mean.
+   *
+   * @throw std::logic_error if the accumulator is empty.
+   */
+  [[nodiscard]] value_type mean() const {
+    check_samples(1);
+    return _mean;
+  }
+
+  /**
+   * @brief Returns the per-dimension variance.
+   *
+   * @param unbiased Whether to divide by `count - 1` (sample variance) instead of `count`.
+   * @throw std::logic_error if there are not enough samples for the requested estimate.
+   */
+  [[nodiscard]] value_type variance(bool const unbiased = true) const {
+    check_samples(unbiased ? 2 : 1);
+    T const scale = T(1) / T(unbiased ? _count - 1 : _count);
+    value_type result;
+    for (std::size_t d = 0; d < Length; ++d) {
+      result[d] = _m2[d] * scale;
+    }
+    return result;
+  }
+
+  /**
+   * @brief Returns the per-dimension minimum of every sample added.
+   *
+   * @throw std::logic_error if the accumulator is empty.
+   */
+  [[nodiscard]] value_type min() const {
+    check_samples(1);
+    return _min;
+  }
+
+  /**
+   * @brief Returns the per-dimension maximum of every sample added.
+   *
+   * @throw std::logic_error if the accumulator is empty.
+   */
+  [[nodiscard]] value_type max() const {
+    check_samples(1);
+    return _max;
+  }
+
+private:
+  std::size_t _count = 0;
+  value_type _mean;
+  value_type _m2;
+  // Start at the identities of min and max, so that the extrema survive a window that has emptied.
+  value_type _min = value_type(std::numeric_limits<T>::infinity());
+  value_type _max = value_type(-std::numeric_limits<T>::infinity());
+
+  void check_samples(std::size_t const required) const {
+    if (_count < required) {
+      throw std::logic_error("Not enough samples in the accumulator");
+    }
+  }
+
+  void merge(std::size_t const count, value_type const &mean, value_type const &m2, value_type const &min,
+             value_type const &max) {
+    for (std::size_t d = 0; d < Length; ++d) {
+      _min[d] = min[d] < _min[d] ? min[d] : _min[d];
+      _max[d] = max[d] > _max[d] ? max[d] : _max[d];
+    }
+    if (count == 0) {
+      return;
+    }
+    std::size_t const total = _count + count;
+    T const share = T(count) / T(total);
+    T const weight = T(_count) * share;
+    for (std::size_t d = 0; d < Length; ++d) {
+      T const delta = mean[d] - _mean[d];
+      _mean[d] += delta * share;
+      _m2[d] += m2[d] + delta * delta * weight;
+    }
+    _count = total;
+  }
+
+  /**
+   * @brief Merges `count > 0` samples given as one contiguous array per dimension, `column(d)`.
+   */
+  template <typename Column>
+  void merge_columns(std::size_t const count, Column const &column) {
+    value_type mean, m2, min, max;
+    for (std::size_t d = 0; d < Length; ++d) {
+      detail::moments_n(column(d), count, mean[d], m2[d], min[d], max[d]);
+    }
+    merge(count, mean, m2, min, max);
+  }
+
+  /**
+   * @brief Runs `reduce(shard, first, count, scratch)` on every block of up to #detail::moments_block samples of
+   * `[0, n)`, each into its own shard, with the blocks spread over threads, then merges the shards in block order.
+   * `scratch` has room for one block of every dimension.
+   */
+  template <typename Reduce>
+  void add_blocks(std::size_t const n, std::size_t const threads, Reduce const &reduce) {
+    std::size_t const blocks = (n + detail::moments_block - 1) / detail::moments_block;
+    std::vector<running_statistics> shards(blocks);
+    detail::parallel_for_ranges(blocks, threads, [&](std::size_t begin, std::size_t end) {
+      std::vector<T> scratch(Length * detail::moments_block);
+      for (std::size_t b = begin; b < end; ++b) {
+        std::size_t const first = b * detail::moments_block;
+        reduce(shards[b], first, std::min(detail::moments_block, n - first), scratch.data());
+      }
+    });
+    for (auto const &shard : shards) {
+      merge(shard);
+    }
+  }
+};
+
+/**
+ * @brief Computes the eigenvectors of the `k` eigenvalues of largest magnitude of a symmetric matrix.
+ *
+ * Uses orthogonal iteration: a block of `k` vectors is multiplied by the matrix and re-orthonormalised with
+ * orthonormalize() until the residual `|Aq - λq|` of every vector is within a few rounding errors of the largest
+ * eigenvalue. The residual bounds the angle to the true eigenvector by `|Aq - λq| / gap`, so unlike the change of the
+ * vectors between iterations it does not stop early when neighbouring eigenvalues are close. The matrix is streamed
+ * once per iteration, one range of rows per thread, with all `k` vectors in cache. Convergence is linear in
+ * `|λ(k+1)| / |λ(k)|`; when the iteration limit is reached the current estimates are returned.
+ *
+ * @tparam Length The order of the matrix.
+ * @tparam Matrix A contiguous range of floating point values.
+ * @param symmetric The `Length × Length` symmetric matrix in row-major order, e.g. from
+ * covariance_accumulator::covariance().
+ * @param k The number of eigenvectors.
+ * @param threads The number of threads, zero for the hardware concurrency.
+ * @param max_iterations The maximum number of iterations.
+ * @throw std::invalid_argument if the matrix does not have `Length × Length` elements or `k` exceeds Length.
+ * @throw std::logic_error if the matrix has fewer than `k` non-zero eigenvalues.
+ * @return A pair of the eigenvalues, by decreasing magnitude, and the matching unit eigenvectors.
+ */
+template <std::size_t Length, std::ranges::contiguous_range Matrix, typename T = std::ranges::range_value_t<Matrix>>
+  requires std::floating_point<T>
+[[nodiscard]] std::pair<std::vector<T>, std::vector<vector<T, Length>>>
+top_eigenvectors(Matrix const &symmetric, std::size_t const k, std::size_t const threads = 1,
+                 std::size_t const max_iterations = 1000) {
+  if (std::ranges::size(symmetric) != Length * Length || k > Length) {
+    throw std::invalid_argument("Matrix must be Length x Length with at least k rows");
+  }
+  T const *a = std::ranges::data(symmetric);
+
+  std::vector<vector<T, Length>> q(k);
+  for (std::size_t c = 0; c < k; ++c) {
+    for (std::size_t d = 0; d < Length; ++d) {
+      q[c][d] = T(std::sin(double(c * Length + d) * 12.9898 + 1.0));
+    }
+  }
+  (void)orthonormalize(q);
+
+  std::vector<T> values(k);
+  std::vector<vector<T, Length>> z(k);
+  T const tolerance = T(Length) * std::numeric_limits<T>::epsilon();
+  for (std::size_t iteration = 0; iteration < max_iterations; ++iteration) {
+    detail::parallel_for_ranges(Length, threads, [&](std::size_t begin, std::size_t end) {
+      for (std::size_t i = begin; i < end; ++i) {
+        for (std::size_t c = 0; c < k; ++c) {
+          z[c][i] = detail::dot_n(a + i * Length, q[c].data(), Length);
+        }
+      }
+    });
+    T scale = T(0);
+    T residual = T(0);
+    for (std::size_t c = 0; c < k; ++c) {
+      values[c] = detail::dot_n(q[c].data(), z[c].data(), Length);
+      scale = std::max(scale, std::abs(values[c]));
+      T squares = T(0);
+      for (std::size_t d = 0; d < Length; ++d) {
+        T const r = z[c][d] - values[c] * q[c][d];
+        squares += r * r;
+      }
+      residual = std::max(residual, squares);
+    }
+    (void)orthonormalize(z);
+
+    std::swap(q, z);
+    if (std::sqrt(residual) <= tolerance * scale) {
+      break;
+    }
+  }
+  return {std::move(values), std::move(q)};
+}
+
+/**
+ * @brief Computes the principal components of the samples of an accumulator.
+ *
+ * @tparam T The floating point type of the elements.
+ * @tparam Length The number of elements of the vectors.
+ * @param accumulator The accumulator holding the samples.
+ * @param k The number of components.
+ * @param threads The number of threads, zero for the hardware concurrency.
+ * @throw std::invalid_argument if `k` exceeds Length.
+ * @throw std::logic_error if there are fewer than two samples, or the samples span fewer than `k` dimensions.
+ * @return A pair of the variances along the components, in decreasing order, and the unit component vectors.
+ */
+template <std::floating_point T, std::size_t Length>
+[[nodiscard]] std::pair<std::vector<T>, std::vector<vector<T, Length>>>
+principal_components(covariance_accumulator<T, Length> const &accumulator, std::size_t const k,
+                     std::size_t const threads = 1) {
+  return top_eigenvectors<Length>(accumulator.covariance(), k, threads);
+}
+
+/**
+ * @brief Projects a batch of vectors onto a basis after subtracting a mean, `out[i][c] = basis[c] · (in[i] - mean)`.
+ *
+ * Every vector is centred once and then dotted with the whole basis, which stays in cache across the batch.
+ *
+ * @tparam T The floating point type of the elements.
+ * @tparam Length The number of elements of the input vectors.
+ * @tparam Basis A contiguous range of `vector<T, Length>`.
+ * @tparam In A contiguous range of `vector<T, Length>`.
+ * @tparam Out A contiguous range of `vector<T, K>`, where `K` is the number of basis vectors.
+ * @param basis The basis vectors, e.g. the principal components.
+ * @param mean The vector subtracted before projecting, e.g. the sample mean.
+ * @param in The vectors to project.
+ * @param out The range receiving the coordinates of every vector in the basis.
+ * @param threads The number of threads, zero for the hardware concurrency.
+ * @throw std::invalid_argument if the basis size differs from the length of the output vectors, or `out` is smaller
+ * than `in`.
+ */
+template <std::floating_point T, std::size_t Length, std::ranges::contiguous_range Basis,
+          std::ranges::contiguous_range In, std::ranges::contiguous_range Out,
+          typename W = std::ranges::range_value_t<Out>>
+  requires std::is_same_v<std::ranges::range_value_t<Basis>, vector<T, Length>> &&
+           std::is_same_v<std::ranges::range_value_t<In>, vector<T, Length>> && detail::is_vector_v<W> &&
+           std::is_same_v<typename W::value_type, T>
+void project(Basis const &basis, vector<T, Length> const &mean, In const &in, Out &&out,
+             std::size_t const threads = 1) {
+  constexpr std::size_t K = detail::vector_length_v<W>;
+  std::size_t const n = std::ranges::size(in);
+  if (std::ranges::size(basis) != K || std::ranges::size(out) < n) {
+    throw std::invalid_argument("Basis size must match the output length and the output must hold every vector");
+  }
+  vector<T, Length> const *axes = std::ranges::data(basis);
+  vector<T, Length> const *source = std::ranges::data(in);
+  W *target = std::ranges::data(out);
+  detail::parallel_for_ranges(n, threads, [&](std::size_t begin, std::size_t end) {
+    T centred[Length];
+    for (std::size_t i = begin; i < end; ++i) {
+      for (std::size_t d = 0; d < Length; ++d) {
+        centred[d] = source[i][d] - mean[d];
+      }
+      for (std::size_t c = 0; c < K; ++c) {
+        target[i][c] = detail::dot_n(axes[c].data(), centred, Length);
+      }
+    }
+  });
+}
+
+} // namespace firefly
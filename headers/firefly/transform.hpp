@@ -0,0 +1,694 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <ostream>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "firefly/batch.hpp"
+#include "firefly/detail/parallel.hpp"
+#include "firefly/math.hpp"
+#include "firefly/matrix.hpp"
+#include "firefly/quaternion.hpp"
+#include "firefly/vector.hpp"
+
+namespace firefly {
+
+namespace detail {
+
+/**
+ * @brief Applies `p ↦ linear · p + translation` to the points `[begin, end)` of a structure-of-arrays batch in place.
+ *
+ * Each coordinate lives in its own array, so every statement of the loop body is a vertical operation over
+ * contiguous memory and the loop vectorises to one multiply-add per matrix element and lane.
+ */
+template <typename T, std::size_t Dim>
+void affine_soa_n(matrix<T, Dim, Dim> const &linear, vector<T, Dim> const &translation,
+                  std::array<T *, Dim> const &coords, std::size_t begin, std::size_t end) {
+  for (std::size_t i = begin; i < end; ++i) {
+    T in[Dim];
+    for (std::size_t d = 0; d < Dim; ++d) {
+      in[d] = coords[d][i];
+    }
+    for (std::size_t r = 0; r < Dim; ++r) {
+      T acc = translation[r];
+      for (std::size_t c = 0; c < Dim; ++c) {
+        acc += linear(r, c) * in[c];
+      }
+      coords[r][i] = acc;
+    }
+  }
+}
+
+/**
+ * @brief Applies an affine map to a structure-of-arrays batch given as Dim coordinate ranges of equal size.
+ *
+ * @throw std::invalid_argument if the coordinate ranges differ in size.
+ */
+template <typename T, std::size_t Dim, typename... Coords>
+void affine_soa(matrix<T, Dim, Dim> const &linear, vector<T, Dim> const &translation, std::size_t threads,
+                Coords &&...coords) {
+  std::array<T *, Dim> const pointers{std::ranges::data(coords)...};
+  std::array<std::size_t, Dim> const sizes{std::size_t(std::ranges::size(coords))...};
+  std::size_t const n = sizes[0];
+  for (std::size_t const size : sizes) {
+    if (size != n) {
+      throw std::invalid_argument("Coordinate ranges must have the same size");
+    }
+  }
+  parallel_for_ranges(n, threads, [&](std::size_t begin, std::size_t end) {
+    affine_soa_n(linear, translation, pointers, begin, end);
+  });
+}
+
+/// @brief Number of angles whose sine and cosine are computed together before the rotations are applied.
+inline constexpr std::size_t rotation_chunk = 256;
+
+/**
+ * @brief Rotates the points `[begin, end)` by their own angles, `(x, y) ↦ (c·x - s·y, s·x + c·y)`.
+ *
+ * Sines and cosines are computed a chunk at a time into stack buffers with the vectorised math::sincos kernel, and the
+ * chunk is then rotated in a second vectorised loop.
+ */
+template <typename T, typename Load, typename Store>
+void rotate_each_n(T const *angles, std::size_t begin, std::size_t end, Load load, Store store) {
+  T sines[rotation_chunk];
+  T cosines[rotation_chunk];
+  for (std::size_t chunk = begin; chunk < end; chunk += rotation_chunk) {
+    std::size_t const count = std::min(rotation_chunk, end - chunk);
+    for (std::size_t i = 0; i < count; ++i) {
+      math::detail::sincos_kernel(angles[chunk + i], sines[i], cosines[i]);
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+      auto const [x, y] = load(chunk + i);
+      store(chunk + i, cosines[i] * x - sines[i] * y, sines[i] * x + cosines[i] * y);
+    }
+  }
+}
+
+} // namespace detail
+
+/**
+ * @class rotation_2d
+ * @brief Represents a rotation of the plane about the origin, with its sine and cosine computed once.
+ *
+ * Build the rotation once and apply it to as many vectors as needed; applying it costs four multiplications and two
+ * additions, with no trigonometric calls.
+ *
+ * @tparam T The floating point type of the elements.
+ */
+template <std::floating_point T>
+class rotation_2d {
+public:
+  using value_type = T;
+
+  /**
+   * @brief Default constructor that creates the identity rotation.
+   */
+  [[nodiscard]] constexpr rotation_2d() = default;
+
+  /**
+   * @brief Constructor that computes the sine and cosine of the angle.
+   *
+   * @param angle_rad The angle in radians, counter-clockwise.
+   */
+  [[nodiscard]] constexpr explicit rotation_2d(T const angle_rad)
+      : _cos(math::cos(angle_rad)), _sin(math::sin(angle_rad)) {}
+
+  /**
+   * @brief Returns the cosine of the angle.
+   */
+  [[nodiscard]] constexpr T cos() const {
+    return _cos;
+  }
+
+  /**
+   * @brief Returns the sine of the angle.
+   */
+  [[nodiscard]] constexpr T sin() const {
+    return _sin;
+  }
+
+  /**
+   * @brief Rotates a vector.
+   *
+   * @param v The vector to rotate.
+   * @return The rotated vector.
+   */
+  [[nodiscard]] constexpr vector<T, 2> operator()(vector<T, 2> const &v) const {
+    return vector<T, 2>{_cos * v[0] - _sin * v[1], _sin * v[0] + _cos * v[1]};
+  }
+
+  /**
+   * @brief Composes two rotations, adding their angles with the angle-sum identities.
+   *
+   * @param other The other rotation.
+   * @return The rotation by the sum of the two angles.
+   */
+  [[nodiscard]] constexpr rotation_2d operator*(rotation_2d const &other) const {
+    return rotation_2d(_cos * other._cos - _sin * other._sin, _sin * other._cos + _cos * other._sin);
+  }
+
+  /**
+   * @brief Returns the rotation by the opposite angle.
+   */
+  [[nodiscard]] constexpr rotation_2d inverse() const {
+    return rotation_2d(_cos, -_sin);
+  }
+
+  /**
+   * @brief Converts the rotation to a 2 × 2 rotation matrix.
+   *
+   * @tparam Layout The storage order of the matrix.
+   * @return The rotation matrix.
+   */
+  template <layout Layout = layout::row_major>
+  [[nodiscard]] constexpr matrix<T, 2, 2, Layout> to_matrix() const {
+    return matrix<T, 2, 2, Layout>{{_cos, -_sin}, {_sin, _cos}};
+  }
+
+private:
+  T _cos = T(1);
+  T _sin = T(0);
+
+  constexpr rotation_2d(T const cos, T const sin) : _cos(cos), _sin(sin) {}
+};
+
+/**
+ * @class affine
+ * @brief Represents an affine transform `p ↦ A·p + t` of 2D or 3D space.
+ *
+ * The transform is stored as its linear part and its translation, and converts to and from the 3 × 3 (2D) or 4 × 4
+ * (3D) homogeneous matrix.
+ *
+ * @tparam T The floating point type of the elements.
+ * @tparam Dim The dimension of the space, 2 or 3.
+ */
+template <std::floating_point T, std::size_t Dim>
+  requires(Dim == 2 || Dim == 3)
+class affine {
+public:
+  using value_type = T;
+
+  /// @brief The dimension of the space.
+  static constexpr std::size_t dimension = Dim;
+
+  /**
+   * @brief Default constructor that creates the identity transform.
+   */
+  [[nodiscard]] constexpr affine() : _linear(matrix<T, Dim, Dim>::identity()) {}
+
+  /**
+   * @brief Constructor from a linear part and a translation.
+   *
+   * @param linear The linear part `A`.
+   * @param translation The translation `t`.
+   */
+  [[nodiscard]] constexpr affine(matrix<T, Dim, Dim> const &linear, vector<T, Dim> const &translation = {})
+      : _linear(linear), _translation(translation) {}
+
+  /**
+   * @brief Constructor from a homogeneous matrix.
+   *
+   * @tparam Layout The storage order of the matrix.
+   * @param homogeneous The (Dim + 1) × (Dim + 1) matrix, whose last row must be `(0, ..., 0, 1)`.
+   * @throw std::invalid_argument if the last row of the matrix is not `(0, ..., 0, 1)`.
+   */
+  template <layout Layout>
+  [[nodiscard]] constexpr explicit affine(matrix<T, Dim + 1, Dim + 1, Layout> const &homogeneous) {
+    for (std::size_t c = 0; c <= Dim; ++c) {
+      if (homogeneous(Dim, c) != (c == Dim ? T(1) : T(0))) {
+        throw std::invalid_argument("Homogeneous matrix must have a last row of (0, ..., 0, 1)");
+      }
+    }
+    for (std::size_t r = 0; r < Dim; ++r) {
+      for (std::size_t c = 0; c < Dim; ++c) {
+        _linear(r, c) = homogeneous(r, c);
+      }
+      _translation[r] = homogeneous(r, Dim);
+    }
+  }
+
+  /**
+   * @brief Creates a translation.
+   *
+   * @param offset The translation vector.
+   * @return The transform `p ↦ p + offset`.
+   */
+  [[nodiscard]] static constexpr affine translation(vector<T, Dim> const &offset) {
+    return affine(matrix<T, Dim, Dim>::identity(), offset);
+  }
+
+  /**
+   * @brief Creates a scaling along the coordinate axes.
+   *
+   * @param factors The scale factor of each axis.
+   * @return The transform `p ↦ diag(factors) · p`.
+   */
+  [[nodiscard]] static constexpr affine scaling(vector<T, Dim> const &factors) {
+    matrix<T, Dim, Dim> linear;
+    for (std::size_t i = 0; i < Dim; ++i) {
+      linear(i, i) = factors[i];
+    }
+    return affine(linear);
+  }
+
+  /**
+   * @brief Creates a 2D rotation about the origin.
+   *
+   * @param angle_rad The angle in radians, counter-clockwise.
+   * @return The rotation transform.
+   */
+  [[nodiscard]] static constexpr affine rotation(T const angle_rad)
+    requires(Dim == 2)
+  {
+    return affine(rotation_2d<T>(angle_rad).to_matrix());
+  }
+
+  /**
+   * @brief Creates a 3D rotation about the origin.
+   *
+   * @param rotation The rotation as a quaternion.
+   * @return The rotation transform.
+   */
+  [[nodiscard]] static constexpr affine rotation(quaternion<T> const &rotation)
+    requires(Dim == 3)
+  {
+    return affine(rotation.to_matrix());
+  }
+
+  /**
+   * @brief Returns the linear part `A`.
+   */
+  [[nodiscard]] constexpr matrix<T, Dim, Dim> const &linear() const {
+    return _linear;
+  }
+
+  /**
+   * @brief Returns the translation `t`.
+   */
+  [[nodiscard]] constexpr vector<T, Dim> const &translation() const {
+    return _translation;
+  }
+
+  /**
+   * @brief Converts the transform to its homogeneous matrix.
+   *
+   * @tparam Layout The storage order of the matrix.
+   * @return The (Dim + 1) × (Dim + 1) matrix, 3 × 3 in 2D and 4 × 4 in 3D.
+   */
+  template <layout Layout = layout::row_major>
+  [[nodiscard]] constexpr matrix<T, Dim + 1, Dim + 1, Layout> to_matrix() const {
+    matrix<T, Dim + 1, Dim + 1, Layout> result;
+    for (std::size_t r = 0; r < Dim; ++r) {
+      for (std::size_t c = 0; c < Dim; ++c) {
+        result(r, c) = _linear(r, c);
+      }
+      result(r, Dim) = _translation[r];
+    }
+    result(Dim, Dim) = T(1);
+    return result;
+  }
+
+  /**
+   * @brief Composes two transforms.
+   *
+   * The composition `a * b` applies `b` first and then `a`.
+   *
+   * @param other The transform applied first.
+   * @return The composed transform.
+   */
+  [[nodiscard]] constexpr affine operator*(affine const &other) const {
+    return affine(_linear * other._linear, _linear * other._translation + _translation);
+  }
+
+  /**
+   * @brief Transforms a point, applying both the linear part and the translation.
+   *
+   * @param point The point to transform.
+   * @return The transformed point.
+   */
+  [[nodiscard]] constexpr vector<T, Dim> operator()(vector<T, Dim> const &point) const {
+    return _linear * point + _translation;
+  }
+
+  /**
+   * @brief Transforms a direction, applying only the linear part.
+   *
+   * @param direction The direction to transform.
+   * @return The transformed direction.
+   */
+  [[nodiscard]] constexpr vector<T, Dim> apply_direction(vector<T, Dim> const &direction) const {
+    return _linear * direction;
+  }
+
+  /**
+   * @brief Computes the inverse transform by Gauss–Jordan elimination with partial pivoting.
+   *
+   * @throw std::logic_error if the linear part is singular.
+   * @return The transform `p ↦ A⁻¹·(p - t)`.
+   */
+  [[nodiscard]] constexpr affine inverse() const {
+    matrix<T, Dim, Dim> a = _linear;
+    matrix<T, Dim, Dim> inv = matrix<T, Dim, Dim>::identity();
+    for (std::size_t col = 0; col < Dim; ++col) {
+      std::size_t pivot = col;
+      for (std::size_t r = col + 1; r < Dim; ++r) {
+        if (abs(a(r, col)) > abs(a(pivot, col))) {
+          pivot = r;
+        }
+      }
+      if (a(pivot, col) == T(0)) {
+        throw std::logic_error("Cannot invert a transform with a singular linear part");
+      }
+      for (std::size_t c = 0; c < Dim; ++c) {
+        std::swap(a(col, c), a(pivot, c));
+        std::swap(inv(col, c), inv(pivot, c));
+      }
+      T const scale = T(1) / a(col, col);
+      for (std::size_t c = 0; c < Dim; ++c) {
+        a(col, c) *= scale;
+        inv(col, c) *= scale;
+      }
+      for (std::size_t r = 0; r < Dim; ++r) {
+        if (r != col) {
+          T const factor = a(r, col);
+          for (std::size_t c = 0; c < Dim; ++c) {
+            a(r, c) -= factor * a(col, c);
+            inv(r, c) -= factor * inv(col, c);
+          }
+        }
+      }
+    }
+    return affine(inv, -(inv * _translation));
+  }
+
+  /**
+   * @brief Compares two transforms element-wise.
+   */
+  [[nodiscard]] constexpr bool operator==(affine const &other) const {
+    return _linear == other._linear && _translation == other._translation;
+  }
+
+  /**
+   * @brief Converts the transform to the string representation of its homogeneous matrix.
+   *
+   * @param precision The precision used for the elements.
+   * @return A string representation of the transform.
+   */
+  [[nodiscard]] std::string view(int precision = 20) const {
+    return to_matrix().view(precision);
+  }
+
+  /**
+   * @brief Stream insertion operator for affine transforms.
+   *
+   * @param os The output stream.
+   * @param other The transform to be output.
+   * @return The output stream with the transform representation.
+   */
+  friend std::ostream &operator<<(std::ostream &os, affine const &other) {
+    os << other.view();
+    return os;
+  }
+
+private:
+  matrix<T, Dim, Dim> _linear;
+  vector<T, Dim> _translation;
+
+  static constexpr T abs(T const value) {
+    return value < T(0) ? -value : value;
+  }
+};
+
+/**
+ * @brief Transforms a batch of points stored as an array of vectors, `out[i] = a(in[i])`.
+ *
+ * @tparam T The floating point type of the elements.
+ * @tparam Dim The dimension of the space.
+ * @tparam In A contiguous range of `vector<T, Dim>`.
+ * @tparam Out A contiguous range of `vector<T, Dim>`.
+ * @param a The transform to apply.
+ * @param in The points to transform.
+ * @param out The range receiving the transformed points. It may alias `in`.
+ * @param threads The number of threads, zero for the hardware concurrency.
+ * @throw std::invalid_argument if `out` is smaller than `in`.
+ */
+template <std::floating_point T, std::size_t Dim, std::ranges::contiguous_range In, std::ranges::contiguous_range Out>
+  requires std::is_same_v<std::ranges::range_value_t<In>, vector<T, Dim>> &&
+           std::is_same_v<std::ranges::range_value_t<Out>, vector<T, Dim>>
+void transform_points(affine<T, Dim> const &a, In const &in, Out &&out, std::size_t const threads = 1) {
+  std::size_t const n = std::ranges::size(in);
+  if (std::ranges::size(out) < n) {
+    throw std::invalid_argument("Output range must be at least as large as the input range");
+  }
+  auto const *source = std::ranges::data(in);
+  auto *target = std::ranges::data(out);
+  detail::parallel_for_ranges(n, threads, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+      target[i] = a(source[i]);
+    }
+  });
+}
+
+/**
+ * @brief Transforms a batch of 2D points stored as a structure of arrays, in place.
+ *
+ * @tparam T The floating point type of the elements.
+ * @param a The transform to apply.
+ * @param xs The x coordinates.
+ * @param ys The y coordinates.
+ * @param threads The number of threads, zero for the hardware concurrency.
+ * @throw std::invalid_argument if the coordinate ranges differ in size.
+ */
+template <std::floating_point T, std::ranges::contiguous_range Xs, std::ranges::contiguous_range Ys>
+  requires std::is_same_v<std::ranges::range_value_t<Xs>, T> && std::is_same_v<std::ranges::range_value_t<Ys>, T>
+void transform_points(affine<T, 2> const &a, Xs &&xs, Ys &&ys, std::size_t const threads = 1) {
+  detail::affine_soa(a.linear(), a.translation(), threads, xs, ys);
+}
+
+/**
+ * @brief Transforms a batch of 3D points stored as a structure of arrays, in place.
+ *
+ * @tparam T The floating point type of the elements.
+ * @param a The transform to apply.
+ * @param xs The x coordinates.
+ * @param ys The y coordinates.
+ * @param zs The z coordinates.
+ * @param threads The number of threads, zero for the hardware concurrency.
+ * @throw std::invalid_argument if the coordinate ranges differ in size.
+ */
+template <std::floating_point T, std::ranges::contiguous_range Xs, std::ranges::contiguous_range Ys,
+          std::ranges::contiguous_range Zs>
+  requires std::is_same_v<std::ranges::range_value_t<Xs>, T> && std::is_same_v<std::ranges::range_value_t<Ys>, T> &&
+           std::is_same_v<std::ranges::range_value_t<Zs>, T>
+void transform_points(affine<T, 3> const &a, Xs &&xs, Ys &&ys, Zs &&zs, std::size_t const threads = 1) {
+  detail::affine_soa(a.linear(), a.translation(), threads, xs, ys, zs);
+}
+
+/**
+ * @brief Transforms the points of a structure-of-arrays batch in place.
+ *
+ * @tparam T The floating point type of the elements.
+ * @tparam Dim The dimension of the space.
+ * @param a The transform to apply.
+ * @param points The points to transform.
+ * @param threads The number of threads, zero for the hardware concurrency.
+ */
+template <std::floating_point T, std::size_t Dim>
+void transform_points(affine<T, Dim> const &a, vector_batch<T, Dim> &points, std::size_t const threads = 1) {
+  if constexpr (Dim == 2) {
+    detail::affine_soa(a.linear(), a.translation(), threads, points.component(0), points.component(1));
+  } else {
+    detail::affine_soa(a.linear(), a.translation(), threads, points.component(0), points.component(1),
+                       points.component(2));
+  }
+}
+
+/**
+ * @brief Rotates a batch of vectors stored as an array of vectors, `out[i] = q.rotate(in[i])`.
+ *
+ * The quaternion is converted to a rotation matrix once, so each vector costs nine multiply-adds.
+ *
+ * @tparam T The floating point type of the elements.
+ * @param rotation The rotation to apply.
+ * @param in The vectors to rotate.
+ * @param out The range receiving the rotated vectors. It may alias `in`.
+ * @param threads The number of threads, zero for the hardware concurrency.
+ * @throw std::invalid_argument if `out` is smaller than `in`.
+ */
+template <std::floating_point T, std::ranges::contiguous_range In, std::ranges::contiguous_range Out>
+  requires std::is_same_v<std::ranges::range_value_t<In>, vector<T, 3>> &&
+           std::is_same_v<std::ranges::range_value_t<Out>, vector<T, 3>>
+void rotate(quaternion<T> const &rotation, In const &in, Out &&out, std::size_t const threads = 1) {
+  transform(rotation.to_matrix(), in, out, threads);
+}
+
+/**
+ * @brief Rotates a batch of vectors stored as a structure of arrays, in place.
+ *
+ * @tparam T The floating point type of the elements.
+ * @param rotation The rotation to apply.
+ * @param xs The x coordinates.
+ * @param ys The y coordinates.
+ * @param zs The z coordinates.
+ * @param threads The number of threads, zero for the hardware concurrency.
+ * @throw std::invalid_argument if the coordinate ranges differ in size.
+ */
+template <std::floating_point T, std::ranges::contiguous_range Xs, std::ranges::contiguous_range Ys,
+          std::ranges::contiguous_range Zs>
+  requires std::is_same_v<std::ranges::range_value_t<Xs>, T> && std::is_same_v<std::ranges::range_value_t<Ys>, T> &&
+           std::is_same_v<std::ranges::range_value_t<Zs>, T>
+void rotate(quaternion<T> const &rotation, Xs &&xs, Ys &&ys, Zs &&zs, std::size_t const threads = 1) {
+  detail::affine_soa(rotation.to_matrix(), vector<T, 3>{}, threads, xs, ys, zs);
+}
+
+/**
+ * @brief Rotates the vectors of a structure-of-arrays batch in place.
+ *
+ * @tparam T The floating point type of the elements.
+ * @param rotation The rotation to apply.
+ * @param batch The vectors to rotate.
+ * @param threads The number of threads, zero for the hardware concurrency.
+ */
+template <std::floating_point T>
+void rotate(quaternion<T> const &rotation, vector_batch<T, 3> &batch, std::size_t const threads = 1) {
+  detail::affine_soa(rotation.to_matrix(), vector<T, 3>{}, threads, batch.component(0), batch.component(1),
+                     batch.component(2));
+}
+
+/**
+ * @brief Rotates a batch of 2D vectors stored as an array of vectors, `out[i] = rotation(in[i])`.
+ *
+ * @tparam T The floating point type of the elements.
+ * @param rotation The rotation to apply.
+ * @param in The vectors to rotate.
+ * @param out The range receiving the rotated vectors. It may alias `in`.
+ * @param threads The number of threads, zero for the hardware concurrency.
+ * @throw std::invalid_argument if `out` is smaller than `in`.
+ */
+template <std::floating_point T, std::ranges::contiguous_range In, std::ranges::contiguous_range Out>
+  requires std::is_same_v<std::ranges::range_value_t<In>, vector<T, 2>> &&
+           std::is_same_v<std::ranges::range_value_t<Out>, vector<T, 2>>
+void rotate(rotation_2d<T> const &rotation, In const &in, Out &&out, std::size_t const threads = 1) {
+  transform(rotation.to_matrix(), in, out, threads);
+}
+
+/**
+ * @brief Rotates a batch of 2D vectors stored as a structure of arrays, in place.
+ *
+ * @tparam T The floating point type of the elements.
+ * @param rotation The rotation to apply.
+ * @param xs The x coordinates.
+ * @param ys The y coordinates.
+ * @param threads The number of threads, zero for the hardware concurrency.
+ * @throw std::invalid_argument if the coordinate ranges differ in size.
+ */
+template <std::floating_point T, std::ranges::contiguous_range Xs, std::ranges::contiguous_range Ys>
+  requires std::is_same_v<std::ranges::range_value_t<Xs>, T> && std::is_same_v<std::ranges::range_value_t<Ys>, T>
+void rotate(rotation_2d<T> const &rotation, Xs &&xs, Ys &&ys, std::size_t const threads = 1) {
+  detail::affine_soa(rotation.to_matrix(), vector<T, 2>{}, threads, xs, ys);
+}
+
+/**
+ * @brief Rotates the 2D vectors of a structure-of-arrays batch in place.
+ *
+ * @tparam T The floating point type of the elements.
+ * @param rotation The rotation to apply.
+ * @param batch The vectors to rotate.
+ * @param threads The number of threads, zero for the hardware concurrency.
+ */
+template <std::floating_point T>
+void rotate(rotation_2d<T> const &rotation, vector_batch<T, 2> &batch, std::size_t const threads = 1) {
+  detail::affine_soa(rotation.to_matrix(), vector<T, 2>{}, threads, batch.component(0), batch.component(1));
+}
+
+/**
+ * @brief Rotates every 2D vector of an array by its own angle, `out[i] = rotation_2d(angles[i])(in[i])`.
+ *
+ * @tparam In A contiguous range of `vector<T, 2>` with `T` either `float` or `double`.
+ * @tparam Angles A contiguous range of `T`.
+ * @tparam Out A contiguous range of `vector<T, 2>`.
+ * @param in The vectors to rotate.
+ * @param angles The angle in radians of each vector.
+ * @param out The range receiving the rotated vectors. It may alias `in`.
+ * @param threads The number of threads, zero for the hardware concurrency.
+ * @throw std::invalid_argument if `angles` or `out` is smaller than `in`.
+ */
+template <std::ranges::contiguous_range In, std::ranges::contiguous_range Angles, std::ranges::contiguous_range Out,
+          typename T = std::ranges::range_value_t<Angles>>
+  requires(std::is_same_v<T, float> || std::is_same_v<T, double>) &&
+          std::is_same_v<std::ranges::range_value_t<In>, vector<T, 2>> &&
+          std::is_same_v<std::ranges::range_value_t<Out>, vector<T, 2>>
+void rotate(In const &in, Angles const &angles, Out &&out, std::size_t const threads = 1) {
+  std::size_t const n = std::ranges::size(in);
+  if (std::ranges::size(angles) < n || std::ranges::size(out) < n) {
+    throw std::invalid_argument("Angle and output ranges must be at least as large as the input range");
+  }
+  auto const *source = std::ranges::data(in);
+  auto *target = std::ranges::data(out);
+  detail::parallel_for_ranges(n, threads, [&](std::size_t begin, std::size_t end) {
+    detail::rotate_each_n(
+        std::ranges::data(angles), begin, end,
+        [source](std::size_t i) { return std::pair<T, T>(source[i][0], source[i][1]); },
+        [target](std::size_t i, T x, T y) { target[i] = vector<T, 2>{x, y}; });
+  });
+}
+
+/**
+ * @brief Rotates every 2D point of a structure of arrays by its own angle, in place.
+ *
+ * @tparam Xs A contiguous range of `T` with `T` either `float` or `double`.
+ * @tparam Ys A contiguous range of `T`.
+ * @tparam Angles A contiguous range of `T`.
+ * @param xs The x coordinates.
+ * @param ys The y coordinates.
+ * @param angles The angle in radians of each point.
+ * @param threads The number of threads, zero for the hardware concurrency.
+ * @throw std::invalid_argument if the ranges differ in size.
+ */
+template <std::ranges::contiguous_range Xs, std::ranges::contiguous_range Ys, std::ranges::contiguous_range Angles,
+          typename T = std::ranges::range_value_t<Angles>>
+  requires(std::is_same_v<T, float> || std::is_same_v<T, double>) &&
+          std::is_same_v<std::ranges::range_value_t<Xs>, T> && std::is_same_v<std::ranges::range_value_t<Ys>, T>
+void rotate(Xs &&xs, Ys &&ys, Angles const &angles, std::size_t const threads = 1) {
+  std::size_t const n = std::ranges::size(xs);
+  if (std::ranges::size(ys) != n || std::ranges::size(angles) != n) {
+    throw std::invalid_argument("Coordinate and angle ranges must have the same size");
+  }
+  T *x = std::ranges::data(xs);
+  T *y = std::ranges::data(ys);
+  detail::parallel_for_ranges(n, threads, [&](std::size_t begin, std::size_t end) {
+    detail::rotate_each_n(
+        std::ranges::data(angles), begin, end, [x, y](std::size_t i) { return std::pair<T, T>(x[i], y[i]); },
+        [x, y](std::size_t i, T rx, T ry) {
+          x[i] = rx;
+          y[i] = ry;
+        });
+  });
+}
+
+/**
+ * @brief Rotates every 2D vector of a structure-of-arrays batch by its own angle, in place.
+ *
+ * @tparam T The floating point type of the elements, `float` or `double`.
+ * @tparam Angles A contiguous range of `T`.
+ * @param batch The vectors to rotate.
+ * @param angles The angle in radians of each vector.
+ * @param threads The number of threads, zero for the hardware concurrency.
+ * @throw std::invalid_argument if `angles` differs in size from `batch`.
+ */
+template <typename T, std::ranges::contiguous_range Angles>
+  requires(std::is_same_v<T, float> || std::is_same_v<T, double>) &&
+          std::is_same_v<std::ranges::range_value_t<Angles>, T>
+void rotate(vector_batch<T, 2> &batch, Angles const &angles, std::size_t const threads = 1) {
+  rotate(batch.component(0), batch.component(1), angles, threads);
+}
+
+} // namespace firefly
@@ -1,5 +1,142 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <numbers>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "firefly/batch.hpp"
+#include "firefly/detail/kernels.hpp"
+#include "firefly/detail/parallel.hpp"
+#include "firefly/math.hpp"
 #include "firefly/vector.hpp"
 
+namespace firefly::detail {
+
+/// @brief Number of vector pairs whose dot products and squared norms are computed together.
+inline constexpr std::size_t pair_chunk = 256;
+
+/**
+ * @brief Computes `a·b`, `|a|²` and `|b|²` for a chunk of pairs stored as arrays of vectors.
+ */
+template <typename T, std::size_t Length>
+void pair_products_n(firefly::vector<T, Length> const *a, firefly::vector<T, Length> const *b, std::size_t count,
+                     T *dot, T *aa, T *bb) {
+  for (std::size_t i = 0; i < count; ++i) {
+    T d = T(0), x = T(0), y = T(0);
+    for (std::size_t k = 0; k < Length; ++k) {
+      d += a[i][k] * b[i][k];
+      x += a[i][k] * a[i][k];
+      y += b[i][k] * b[i][k];
+    }
+    dot[i] = d;
+    aa[i] = x;
+    bb[i] = y;
+  }
+}
+
+/**
+ * @brief Computes `a·b`, `|a|²` and `|b|²` for a chunk of pairs stored as structures of arrays.
+ *
+ * The sums are accumulated one component at a time across the chunk, so every inner loop is a contiguous,
+ * vectorisable multiply-add.
+ */
+template <typename T, std::size_t Length>
+void pair_products_n(vector_batch<T, Length> const &a, vector_batch<T, Length> const &b, std::size_t first,
+                     std::size_t count, T *dot, T *aa, T *bb) {
+  std::fill_n(dot, count, T(0));
+  std::fill_n(aa, count, T(0));
+  std::fill_n(bb, count, T(0));
+  for (std::size_t k = 0; k < Length; ++k) {
+    T const *x = a.component(k).data() + first;
+    T const *y = b.component(k).data() + first;
+    for (std::size_t i = 0; i < count; ++i) {
+      dot[i] += x[i] * y[i];
+      aa[i] += x[i] * x[i];
+      bb[i] += y[i] * y[i];
+    }
+  }
+}
+
+/**
+ * @brief Runs `products(first, count, dot, aa, bb)` and then `finish(first, count, dot, aa, bb)` over chunks of
+ * `[0, n)`, one contiguous range of pairs per thread.
+ */
+template <typename T, typename Products, typename Finish>
+void for_each_pair_chunk(std::size_t n, std::size_t threads, Products products, Finish finish) {
+  parallel_for_ranges(n, threads, [&](std::size_t begin, std::size_t end) {
+    T dot[pair_chunk];
+    T aa[pair_chunk];
+    T bb[pair_chunk];
+    for (std::size_t first = begin; first < end; first += pair_chunk) {
+      std::size_t const count = std::min(pair_chunk, end - first);
+      products(first, count, dot, aa, bb);
+      finish(first, count, dot, aa, bb);
+    }
+  });
+}
+
+/**
+ * @brief Checks the sizes of the ranges of a batched pair function and returns the number of pairs.
+ *
+ * @throw std::invalid_argument if `b` or `out` is smaller than `a`.
+ */
+inline std::size_t pair_count(std::size_t a, std::size_t b, std::size_t out) {
+  if (b < a || out < a) {
+    throw std::invalid_argument("Second and output ranges must be at least as large as the first range");
+  }
+  return a;
+}
+
+/**
+ * @brief Turns the dot products and squared norms of a chunk into angles, with the conventions of angle_between.
+ *
+ * The norms are taken before they are multiplied: `|a|²|b|²` overflows or underflows long before `a·b` does.
+ */
+template <typename T>
+void pair_angles_n(T const *dot, T const *aa, T const *bb, std::size_t count, T delta, T *out) {
+  for (std::size_t i = 0; i < count; ++i) {
+    T const norms = std::sqrt(aa[i]) * std::sqrt(bb[i]);
+    T const ratio = std::min(std::max(dot[i] / norms, T(-1)), T(1));
+    T const cosine = norms > T(0) ? ratio : T(0);
+    T const angle = math::detail::acos_kernel(cosine);
+    out[i] = angle < delta ? T(0) : angle;
+  }
+}
+
+/**
+ * @brief Classifies the pairs of a chunk without computing any angle.
+ *
+ * With `s = sin δ`, a pair is orthogonal when `|a·b| <= s|a||b|` and parallel when `|a·b| >= sqrt(1 - s²)|a||b|`.
+ * The norms are compared unsquared, since `|a|²|b|²` overflows or underflows long before `a·b` does. `s²` is not
+ * allowed below a few rounding errors of T, so that pairs that are exactly parallel are still detected after
+ * rounding.
+ */
+template <typename T, typename Relation>
+void pair_relations_n(T const *dot, T const *aa, T const *bb, std::size_t count, T sin_delta, Relation *out) {
+  T const s2 = std::max(sin_delta * sin_delta, T(16) * std::numeric_limits<T>::epsilon());
+  T const s = std::sqrt(s2);
+  T const c = std::sqrt(T(1) - s2);
+  for (std::size_t i = 0; i < count; ++i) {
+    T const norms = std::sqrt(aa[i]) * std::sqrt(bb[i]);
+    T const d = std::fabs(dot[i]);
+    bool const orthogonal = d <= s * norms;
+    bool const parallel = (norms > T(0)) & (d >= c * norms);
+    bool const anti_parallel = parallel & (dot[i] < T(0));
+    out[i] = Relation(std::uint8_t(orthogonal) | std::uint8_t(parallel) << 1 | std::uint8_t(anti_parallel) << 2);
+  }
+}
+
+} // namespace firefly::detail
+
 namespace firefly::utilities::vector {
 
 /**
@@ -26,10 +163,10 @@ template <vector_type T, vector_type U, std::size_t Length>
                                            double delta = 1e-6) {
   static_assert(std::is_arithmetic_v<T> && std::is_arithmetic_v<U>, "Only arithmetic types are allowed.");
   if (v1.norm() == 0 || v2.norm() == 0) {
-    return M_PI_2;
+    return std::numbers::pi / 2;
   }
 
-  auto rad = std::acos(std::clamp((v1.to_normalized() * v2.to_normalized()) / 1, -1.0, 1.0));
+  auto rad = math::acos(std::clamp((v1.to_normalized() * v2.to_normalized()) / 1, -1.0, 1.0));
   return rad < delta ? 0.0 : rad;
 }
 
@@ -103,6 +240,165 @@ bool are_orthogonal(firefly::vector<T, Length> const &v1, firefly::vector<U, Len
   return std::fabs(angle_between(v1, v2) - M_PI_2) < delta;
 }
 
+/**
+ * @brief Relations between the two vectors of a pair, as returned by classify_pairs(). Values combine as bit flags.
+ */
+enum class pair_relation : std::uint8_t {
+  /// @brief The vectors are neither orthogonal nor parallel.
+  none = 0,
+  /// @brief The angle between the vectors is within the tolerance of pi/2, or a vector is zero.
+  orthogonal = 1,
+  /// @brief The vectors point in the same or in opposite directions, as in are_parallel().
+  parallel = 2,
+  /// @brief The vectors point in opposite directions. Always set together with parallel.
+  anti_parallel = 4,
+};
+
+/**
+ * @brief Combines two sets of pair relations.
+ */
+[[nodiscard]] constexpr pair_relation operator|(pair_relation const a, pair_relation const b) {
+  return pair_relation(std::uint8_t(a) | std::uint8_t(b));
+}
+
+/**
+ * @brief Intersects two sets of pair relations, e.g. `(r & pair_relation::parallel) != pair_relation::none`.
+ */
+[[nodiscard]] constexpr pair_relation operator&(pair_relation const a, pair_relation const b) {
+  return pair_relation(std::uint8_t(a) & std::uint8_t(b));
+}
+
+/**
+ * @brief Computes the angle between the vectors of every pair of two arrays of vectors.
+ *
+ * Every pair costs one fused pass for `a·b`, `|a|²` and `|b|²`, one square root and a branch-free polynomial arc
+ * cosine, instead of the two normalisations and the library `acos` of angle_between(). Results follow the conventions
+ * of angle_between(): pi/2 when a vector is zero, and zero below `delta`.
+ *
+ * @tparam As A contiguous range of `vector<T, Length>` with `T` either `float` or `double`.
+ * @tparam Bs A contiguous range of the same vector type.
+ * @tparam Out A contiguous range of `T`.
+ * @param as The first vector of every pair.
+ * @param bs The second vector of every pair.
+ * @param out The range receiving the angles in radians.
+ * @param delta Angles below this value are reported as zero.
+ * @param threads The number of threads, zero for the hardware concurrency.
+ * @throw std::invalid_argument if `bs` or `out` is smaller than `as`.
+ */
+template <std::ranges::contiguous_range As, std::ranges::contiguous_range Bs, std::ranges::contiguous_range Out,
+          typename V = std::ranges::range_value_t<As>, typename T = typename V::value_type>
+  requires detail::is_vector_v<V> && (std::is_same_v<T, float> || std::is_same_v<T, double>) &&
+           std::is_same_v<std::ranges::range_value_t<Bs>, V> && std::is_same_v<std::ranges::range_value_t<Out>, T>
+void angles_between(As const &as, Bs const &bs, Out &&out, double const delta = 1e-6, std::size_t const threads = 1) {
+  std::size_t const n = detail::pair_count(std::ranges::size(as), std::ranges::size(bs), std::ranges::size(out));
+  auto const *a = std::ranges::data(as);
+  auto const *b = std::ranges::data(bs);
+  T *target = std::ranges::data(out);
+  detail::for_each_pair_chunk<T>(
+      n, threads,
+      [&](std::size_t first, std::size_t count, T *dot, T *aa, T *bb) {
+        detail::pair_products_n(a + first, b + first, count, dot, aa, bb);
+      },
+      [&](std::size_t first, std::size_t count, T const *dot, T const *aa, T const *bb) {
+        detail::pair_angles_n(dot, aa, bb, count, T(delta), target + first);
+      });
+}
+
+/**
+ * @brief Computes the angle between the vectors of every pair of two structure-of-arrays batches.
+ *
+ * @tparam T The element type, `float` or `double`.
+ * @tparam Length The number of elements of the vectors.
+ * @tparam Out A contiguous range of `T`.
+ * @param as The first vector of every pair.
+ * @param bs The second vector of every pair.
+ * @param out The range receiving the angles in radians.
+ * @param delta Angles below this value are reported as zero.
+ * @param threads The number of threads, zero for the hardware concurrency.
+ * @throw std::invalid_argument if `bs` or `out` is smaller than `as`.
+ */
+template <typename T, std::size_t Length, std::ranges::contiguous_range Out>
+  requires(std::is_same_v<T, float> || std::is_same_v<T, double>) && std::is_same_v<std::ranges::range_value_t<Out>, T>
+void angles_between(vector_batch<T, Length> const &as, vector_batch<T, Length> const &bs, Out &&out,
+                    double const delta = 1e-6, std::size_t const threads = 1) {
+  std::size_t const n = detail::pair_count(as.size(), bs.size(), std::ranges::size(out));
+  T *target = std::ranges::data(out);
+  detail::for_each_pair_chunk<T>(
+      n, threads,
+      [&](std::size_t first, std::size_t count, T *dot, T *aa, T *bb) {
+        detail::pair_products_n(as, bs, first, count, dot, aa, bb);
+      },
+      [&](std::size_t first, std::size_t count, T const *dot, T const *aa, T const *bb) {
+        detail::pair_angles_n(dot, aa, bb, count, T(delta), target + first);
+      });
+}
+
+/**
+ * @brief Classifies every pair of two arrays of vectors as orthogonal, parallel or anti-parallel.
+ *
+ * No angle is computed: the relations are decided by comparing `(a·b)²` with `sin²δ |a|²|b|²` and
+ * `cos²δ |a|²|b|²`, all from the same fused pass over the pair.
+ *
+ * @tparam As A contiguous range of `vector<T, Length>` with `T` either `float` or `double`.
+ * @tparam Bs A contiguous range of the same vector type.
+ * @tparam Out A contiguous range of pair_relation.
+ * @param as The first vector of every pair.
+ * @param bs The second vector of every pair.
+ * @param out The range receiving the relations of every pair.
+ * @param delta The angular tolerance in radians.
+ * @param threads The number of threads, zero for the hardware concurrency.
+ * @throw std::invalid_argument if `bs` or `out` is smaller than `as`.
+ */
+template <std::ranges::contiguous_range As, std::ranges::contiguous_range Bs, std::ranges::contiguous_range Out,
+          typename V = std::ranges::range_value_t<As>, typename T = typename V::value_type>
+  requires detail::is_vector_v<V> && (std::is_same_v<T, float> || std::is_same_v<T, double>) &&
+           std::is_same_v<std::ranges::range_value_t<Bs>, V> &&
+           std::is_same_v<std::ranges::range_value_t<Out>, pair_relation>
+void classify_pairs(As const &as, Bs const &bs, Out &&out, double const delta = 1e-6, std::size_t const threads = 1) {
+  std::size_t const n = detail::pair_count(std::ranges::size(as), std::ranges::size(bs), std::ranges::size(out));
+  auto const *a = std::ranges::data(as);
+  auto const *b = std::ranges::data(bs);
+  pair_relation *target = std::ranges::data(out);
+  detail::for_each_pair_chunk<T>(
+      n, threads,
+      [&](std::size_t first, std::size_t count, T *dot, T *aa, T *bb) {
+        detail::pair_products_n(a + first, b + first, count, dot, aa, bb);
+      },
+      [&](std::size_t first, std::size_t count, T const *dot, T const *aa, T const *bb) {
+        detail::pair_relations_n(dot, aa, bb, count, T(math::sin(delta)), target + first);
+      });
+}
+
+/**
+ * @brief Classifies every pair of two structure-of-arrays batches as orthogonal, parallel or anti-parallel.
+ *
+ * @tparam T The element type, `float` or `double`.
+ * @tparam Length The number of elements of the vectors.
+ * @tparam Out A contiguous range of pair_relation.
+ * @param as The first vector of every pair.
+ * @param bs The second vector of every pair.
+ * @param out The range receiving the relations of every pair.
+ * @param delta The angular tolerance in radians.
+ * @param threads The number of threads, zero for the hardware concurrency.
+ * @throw std::invalid_argument if `bs` or `out` is smaller than `as`.
+ */
+template <typename T, std::size_t Length, std::ranges::contiguous_range Out>
+  requires(std::is_same_v<T, float> || std::is_same_v<T, double>) &&
+          std::is_same_v<std::ranges::range_value_t<Out>, pair_relation>
+void classify_pairs(vector_batch<T, Length> const &as, vector_batch<T, Length> const &bs, Out &&out,
+                    double const delta = 1e-6, std::size_t const threads = 1) {
+  std::size_t const n = detail::pair_count(as.size(), bs.size(), std::ranges::size(out));
+  pair_relation *target = std::ranges::data(out);
+  detail::for_each_pair_chunk<T>(
+      n, threads,
+      [&](std::size_t first, std::size_t count, T *dot, T *aa, T *bb) {
+        detail::pair_products_n(as, bs, first, count, dot, aa, bb);
+      },
+      [&](std::size_t first, std::size_t count, T const *dot, T const *aa, T const *bb) {
+        detail::pair_relations_n(dot, aa, bb, count, T(math::sin(delta)), target + first);
+      });
+}
+
 /**
  * @brief Computes the area of the parallelogram formed by two vectors.
  *
@@ -162,6 +458,25 @@ template <vector_type T, vector_type U, std::size_t Length>
   return target_vector * ((source_vector * target_vector) / (target_vector * target_vector));
 }
 
+/**
+ * @brief Projects a source vector onto an expiring target vector, reusing the target's storage for the result.
+ *
+ * @tparam T The type of the elements in the source vector.
+ * @tparam U The type of the elements in the target vector.
+ * @tparam Length The number of dimensions of the vectors.
+ *
+ * @param source_vector The vector being projected.
+ * @param target_vector The expiring vector onto which the source_vector is projected.
+ *
+ * @return The projection of source_vector onto target_vector.
+ */
+template <vector_type T, vector_type U, std::size_t Length>
+[[nodiscard]] constexpr auto projection(firefly::vector<T, Length> const &source_vector,
+                                        firefly::vector<U, Length> &&target_vector) {
+  auto factor = (source_vector * target_vector) / (target_vector * target_vector);
+  return std::move(target_vector) * factor;
+}
+
 /**
  * @brief Rejects a source vector from a target vector.
  *
@@ -180,6 +495,86 @@ template <vector_type T, vector_type U, std::size_t Length>
   return source_vector - projection(source_vector, target_vector);
 }
 
+/**
+ * @brief Rejects an expiring source vector from a target vector, reusing the source's storage for the result.
+ *
+ * @tparam T The type of the elements in the source vector.
+ * @tparam U The type of the elements in the target vector.
+ * @tparam Length The number of dimensions of the vectors.
+ *
+ * @param source_vector The expiring vector being rejected.
+ * @param target_vector The vector from which the source_vector is rejected.
+ *
+ * @return The component of source_vector orthogonal to target_vector.
+ */
+template <vector_type T, vector_type U, std::size_t Length>
+[[nodiscard]] constexpr auto rejection(firefly::vector<T, Length> &&source_vector,
+                                       firefly::vector<U, Length> const &target_vector) {
+  auto projected = projection(source_vector, target_vector);
+  return std::move(source_vector) - projected;
+}
+
+/**
+ * @brief Computes the squared Euclidean distance between two vectors.
+ *
+ * The differences are squared and summed in one pass without building a difference vector or taking a square root,
+ * which is all that ranking by distance needs.
+ *
+ * @tparam T The type of the elements in the first vector.
+ * @tparam U The type of the elements in the second vector.
+ * @tparam Length The number of dimensions of the vectors.
+ *
+ * @param vector_a The first vector.
+ * @param vector_b The second vector.
+ *
+ * @return The squared distance, of type `common_type_t<T, U>` for real vectors and `double` for complex vectors.
+ */
+template <vector_type T, vector_type U, std::size_t Length>
+[[nodiscard]] constexpr auto squared_distance(firefly::vector<T, Length> const &vector_a,
+                                              firefly::vector<U, Length> const &vector_b) {
+  using R = common_type_t<T, U>;
+  if constexpr (is_complex_v<R>) {
+    return detail::reduce_n(
+        vector_a.data(), vector_b.data(), Length, 0.0,
+        [](T const &a, U const &b) {
+          auto const d = detail::element_cast<R>(a) - detail::element_cast<R>(b);
+          return double(d.real()) * double(d.real()) + double(d.imag()) * double(d.imag());
+        },
+        std::plus<>());
+  } else {
+    return detail::reduce_n(vector_a.data(), vector_b.data(), Length, R(0), detail::squared_difference<R>(),
+                            std::plus<>());
+  }
+}
+
+/**
+ * @brief Computes the squared Euclidean distance between two vectors, giving up once it exceeds a bound.
+ *
+ * The partial sum is compared with the bound every few vector blocks, so candidates that are already worse than the
+ * current k-th best in a nearest-neighbour scan cost only a fraction of a full distance.
+ *
+ * @tparam T The type of the elements in the first vector.
+ * @tparam U The type of the elements in the second vector.
+ * @tparam Length The number of dimensions of the vectors.
+ *
+ * @param vector_a The first vector.
+ * @param vector_b The second vector.
+ * @param bound The largest squared distance of interest.
+ *
+ * @return The squared distance if it does not exceed `bound`, otherwise some value greater than `bound`.
+ *
+ * @note Only arithmetic types are allowed for T and U.
+ */
+template <vector_type T, vector_type U, std::size_t Length>
+[[nodiscard]] constexpr auto squared_distance(firefly::vector<T, Length> const &vector_a,
+                                              firefly::vector<U, Length> const &vector_b,
+                                              common_type_t<T, U> const bound) {
+  static_assert(std::is_arithmetic_v<T> && std::is_arithmetic_v<U>, "Only arithmetic types are allowed.");
+  using R = common_type_t<T, U>;
+  return detail::bounded_reduce_n(vector_a.data(), vector_b.data(), Length, R(0), detail::squared_difference<R>(),
+                                  std::plus<>(), bound);
+}
+
 /**
  * @brief Computes the Euclidean distance between two vectors.
  *
@@ -195,7 +590,177 @@ template <vector_type T, vector_type U, std::size_t Length>
 template <vector_type T, vector_type U, std::size_t Length>
 [[nodiscard]] constexpr auto distance(firefly::vector<T, Length> const &vector_a,
                                       firefly::vector<U, Length> const &vector_b) {
-  return (vector_a - vector_b).norm();
+  return math::sqrt(squared_distance(vector_a, vector_b));
+}
+
+/**
+ * @brief Computes the Euclidean distance between an expiring vector and another vector.
+ *
+ * The distance no longer builds a difference vector, so there is no storage to reuse; this overload forwards to the
+ * const& overload and keeps calls with temporaries resolving the same way.
+ *
+ * @tparam T The type of the elements in the first vector.
+ * @tparam U The type of the elements in the second vector.
+ * @tparam Length The number of dimensions of the vectors.
+ *
+ * @param vector_a The expiring first vector.
+ * @param vector_b The second vector.
+ *
+ * @return The distance between vector_a and vector_b.
+ */
+template <vector_type T, vector_type U, std::size_t Length>
+[[nodiscard]] constexpr auto distance(firefly::vector<T, Length> &&vector_a,
+                                      firefly::vector<U, Length> const &vector_b) {
+  return distance(static_cast<firefly::vector<T, Length> const &>(vector_a), vector_b);
+}
+
+/**
+ * @brief Computes the Manhattan (L1) distance between two vectors.
+ *
+ * @tparam T The type of the elements in the first vector.
+ * @tparam U The type of the elements in the second vector.
+ * @tparam Length The number of dimensions of the vectors.
+ *
+ * @param vector_a The first vector.
+ * @param vector_b The second vector.
+ *
+ * @return The sum of the absolute differences, of type `common_type_t<T, U>`.
+ *
+ * @note Only arithmetic types are allowed for T and U.
+ */
+template <vector_type T, vector_type U, std::size_t Length>
+[[nodiscard]] constexpr auto manhattan_distance(firefly::vector<T, Length> const &vector_a,
+                                                firefly::vector<U, Length> const &vector_b) {
+  static_assert(std::is_arithmetic_v<T> && std::is_arithmetic_v<U>, "Only arithmetic types are allowed.");
+  using R = common_type_t<T, U>;
+  return detail::reduce_n(vector_a.data(), vector_b.data(), Length, R(0), detail::absolute_difference<R>(),
+                          std::plus<>());
+}
+
+/**
+ * @brief Computes the Manhattan (L1) distance between two vectors, giving up once it exceeds a bound.
+ *
+ * @tparam T The type of the elements in the first vector.
+ * @tparam U The type of the elements in the second vector.
+ * @tparam Length The number of dimensions of the vectors.
+ *
+ * @param vector_a The first vector.
+ * @param vector_b The second vector.
+ * @param bound The largest distance of interest.
+ *
+ * @return The distance if it does not exceed `bound`, otherwise some value greater than `bound`.
+ *
+ * @note Only arithmetic types are allowed for T and U.
+ */
+template <vector_type T, vector_type U, std::size_t Length>
+[[nodiscard]] constexpr auto manhattan_distance(firefly::vector<T, Length> const &vector_a,
+                                                firefly::vector<U, Length> const &vector_b,
+                                                common_type_t<T, U> const bound) {
+  static_assert(std::is_arithmetic_v<T> && std::is_arithmetic_v<U>, "Only arithmetic types are allowed.");
+  using R = common_type_t<T, U>;
+  return detail::bounded_reduce_n(vector_a.data(), vector_b.data(), Length, R(0), detail::absolute_difference<R>(),
+                                  std::plus<>(), bound);
+}
+
+/**
+ * @brief Computes the Chebyshev (L∞) distance between two vectors.
+ *
+ * @tparam T The type of the elements in the first vector.
+ * @tparam U The type of the elements in the second vector.
+ * @tparam Length The number of dimensions of the vectors.
+ *
+ * @param vector_a The first vector.
+ * @param vector_b The second vector.
+ *
+ * @return The largest absolute difference, of type `common_type_t<T, U>`. NaN differences propagate.
+ *
+ * @note Only arithmetic types are allowed for T and U.
+ */
+template <vector_type T, vector_type U, std::size_t Length>
+[[nodiscard]] constexpr auto chebyshev_distance(firefly::vector<T, Length> const &vector_a,
+                                                firefly::vector<U, Length> const &vector_b) {
+  static_assert(std::is_arithmetic_v<T> && std::is_arithmetic_v<U>, "Only arithmetic types are allowed.");
+  using R = common_type_t<T, U>;
+  return detail::reduce_n(vector_a.data(), vector_b.data(), Length, R(0), detail::absolute_difference<R>(),
+                          detail::propagating_max());
+}
+
+/**
+ * @brief Computes the Chebyshev (L∞) distance between two vectors, giving up once it exceeds a bound.
+ *
+ * @tparam T The type of the elements in the first vector.
+ * @tparam U The type of the elements in the second vector.
+ * @tparam Length The number of dimensions of the vectors.
+ *
+ * @param vector_a The first vector.
+ * @param vector_b The second vector.
+ * @param bound The largest distance of interest.
+ *
+ * @return The distance if it does not exceed `bound`, otherwise some value greater than `bound`.
+ *
+ * @note Only arithmetic types are allowed for T and U.
+ */
+template <vector_type T, vector_type U, std::size_t Length>
+[[nodiscard]] constexpr auto chebyshev_distance(firefly::vector<T, Length> const &vector_a,
+                                                firefly::vector<U, Length> const &vector_b,
+                                                common_type_t<T, U> const bound) {
+  static_assert(std::is_arithmetic_v<T> && std::is_arithmetic_v<U>, "Only arithmetic types are allowed.");
+  using R = common_type_t<T, U>;
+  return detail::bounded_reduce_n(vector_a.data(), vector_b.data(), Length, R(0), detail::absolute_difference<R>(),
+                                  detail::propagating_max(), bound);
+}
+
+/**
+ * @brief Finds the `k` vectors closest to a query in Euclidean distance by scanning every candidate.
+ *
+ * Candidates are compared with the bounded squared distance against the current k-th best, so most of them are
+ * rejected after a few blocks of elements once the first `k` have been seen.
+ *
+ * @tparam T The type of the elements in the query.
+ * @tparam Length The number of dimensions of the vectors.
+ * @tparam Candidates A range of `firefly::vector<U, Length>` with arithmetic `U`.
+ *
+ * @param query The query vector.
+ * @param candidates The vectors to search.
+ * @param k The number of neighbours.
+ *
+ * @return Up to `k` pairs of (candidate index, squared distance), closest first. Ties are broken by the lower index.
+ */
+template <vector_type T, std::size_t Length, std::ranges::input_range Candidates>
+  requires std::is_same_v<std::ranges::range_value_t<Candidates>,
+                          firefly::vector<typename std::ranges::range_value_t<Candidates>::value_type, Length>>
+[[nodiscard]] auto k_nearest(firefly::vector<T, Length> const &query, Candidates const &candidates, std::size_t k) {
+  using U = typename std::ranges::range_value_t<Candidates>::value_type;
+  using R = common_type_t<T, U>;
+  using entry = std::pair<std::size_t, R>;
+
+  auto const closer = [](entry const &a, entry const &b) {
+    return a.second < b.second || (a.second == b.second && a.first < b.first);
+  };
+  std::vector<entry> best;
+  if (k == 0) {
+    return best;
+  }
+  best.reserve(k);
+
+  std::size_t index = 0;
+  for (auto const &candidate : candidates) {
+    if (best.size() < k) {
+      best.emplace_back(index, squared_distance(query, candidate));
+      std::push_heap(best.begin(), best.end(), closer);
+    } else {
+      R const d = squared_distance(query, candidate, best.front().second);
+      if (d < best.front().second) {
+        std::pop_heap(best.begin(), best.end(), closer);
+        best.back() = {index, d};
+        std::push_heap(best.begin(), best.end(), closer);
+      }
+    }
+    ++index;
+  }
+
+  std::sort_heap(best.begin(), best.end(), closer);
+  return best;
 }
 
 /**
@@ -228,11 +793,34 @@ template <vector_type T, vector_type U, std::size_t Length>
  */
 template <vector_type T>
 [[nodiscard]] constexpr auto rotate_2d(firefly::vector<T, 2> const &vector, double angle_rad) {
-  T x = vector[0] * std::cos(angle_rad) - vector[1] * std::sin(angle_rad);
-  T y = vector[0] * std::sin(angle_rad) + vector[1] * std::cos(angle_rad);
+  auto const c = math::cos(angle_rad);
+  auto const s = math::sin(angle_rad);
+  T x = vector[0] * c - vector[1] * s;
+  T y = vector[0] * s + vector[1] * c;
   return firefly::vector<T, 2>{x, y};
 }
 
+/**
+ * @brief Rotates an expiring 2D vector in place by a given angle (in radians) and returns it.
+ *
+ * @tparam T The type of the elements in the vector.
+ *
+ * @param vector The expiring 2D vector to rotate.
+ * @param angle_rad The angle in radians to rotate the vector.
+ *
+ * @return The rotated vector.
+ */
+template <vector_type T>
+[[nodiscard]] constexpr auto rotate_2d(firefly::vector<T, 2> &&vector, double angle_rad) {
+  auto const c = math::cos(angle_rad);
+  auto const s = math::sin(angle_rad);
+  T x = vector[0] * c - vector[1] * s;
+  T y = vector[0] * s + vector[1] * c;
+  vector[0] = x;
+  vector[1] = y;
+  return std::move(vector);
+}
+
 /**
  * @brief Computes the scalar projection of a source vector onto a target
  * vector.
@@ -271,4 +859,23 @@ template <vector_type T, vector_type U, std::size_t Length>
   return vector_a * (1 - t) + vector_b * t;
 }
 
+/**
+ * @brief Performs linear interpolation (Lerp) between two vectors, reusing the storage of the expiring first vector.
+ *
+ * @tparam T The type of the elements in the first vector.
+ * @tparam U The type of the elements in the second vector.
+ * @tparam Length The number of dimensions of the vectors.
+ *
+ * @param vector_a The expiring first vector.
+ * @param vector_b The second vector.
+ * @param t The interpolation parameter, typically in the range [0, 1].
+ *
+ * @return The interpolated vector between vector_a and vector_b.
+ */
+template <vector_type T, vector_type U, std::size_t Length>
+[[nodiscard]] constexpr auto lerp(firefly::vector<T, Length> &&vector_a, firefly::vector<U, Length> const &vector_b,
+                                  double t) {
+  return std::move(vector_a) * (1 - t) + vector_b * t;
+}
+
 } // namespace firefly::utilities::vector
\ No newline at end of file
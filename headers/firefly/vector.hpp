@@ -2,16 +2,25 @@
 
 #include <algorithm>
 #include <array>
+#include <bit>
 #include <cassert>
 #include <cmath>
 #include <complex>
 #include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <initializer_list>
 #include <iomanip>
+#include <limits>
 #include <numeric>
 #include <sstream>
 #include <stdexcept>
 #include <type_traits>
+#include <utility>
+
+#include "firefly/detail/kernels.hpp"
+#include "firefly/mask.hpp"
+#include "firefly/math.hpp"
 
 namespace firefly {
 
@@ -73,6 +82,29 @@ struct common_type<std::complex<T1>, std::complex<T2>> {
   using type = std::complex<typename std::common_type_t<T1, T2>>;
 };
 
+#if defined(FIREFLY_HAS_FLOAT16) && defined(FIREFLY_HAS_BFLOAT16)
+/**
+ * @brief Specialisation of common_type for mixing `std::float16_t` and `std::bfloat16_t`.
+ *
+ * Neither type can represent every value of the other, so std::common_type is undefined for the pair. Both convert
+ * exactly to `float`, which is used instead.
+ */
+template <>
+struct common_type<std::float16_t, std::bfloat16_t> {
+  /// @brief The resulting type is float.
+  using type = float;
+};
+
+/**
+ * @brief Specialisation of common_type for mixing `std::bfloat16_t` and `std::float16_t`.
+ */
+template <>
+struct common_type<std::bfloat16_t, std::float16_t> {
+  /// @brief The resulting type is float.
+  using type = float;
+};
+#endif
+
 /**
  * @brief Helper alias template for the common_type structure, similar to std::common_type_t.
  *
@@ -102,12 +134,14 @@ concept complex_type = std::is_same_v<std::decay_t<T>, std::complex<typename T::
  *
  * This concept is satisfied if the type `T` is either an arithmetic type
  * (such as `int`, `float`, etc.) or a complex type (i.e., a specialization of `std::complex` with an arithmetic value
- * type). It is used to ensure that operations work with both real numbers and complex numbers.
+ * type). It is used to ensure that operations work with both real numbers and complex numbers. The C++23 16-bit
+ * floating point types `std::float16_t` and `std::bfloat16_t` are accepted as storage types where the implementation
+ * provides them; arithmetic on them is evaluated in `float`.
  *
  * @tparam T The type to check.
  */
 template <typename T>
-concept vector_type = std::is_arithmetic_v<T> || complex_type<T>;
+concept vector_type = std::is_arithmetic_v<T> || complex_type<T> || detail::is_half_v<T>;
 
 /**
  * @brief Trait to determine if a type is a std::complex type.
@@ -159,6 +193,7 @@ public:
   using std::array<T, Length>::crend;
   using std::array<T, Length>::empty;
   using std::array<T, Length>::size;
+  using std::array<T, Length>::data;
   using std::array<T, Length>::operator[];
 
   /**
@@ -207,14 +242,30 @@ public:
    * @return A new vector containing the element-wise sum of the two vectors.
    */
   template <vector_type U>
-  [[nodiscard]] constexpr auto add(vector<U, Length> const &other) const {
+  [[nodiscard]] constexpr auto add(vector<U, Length> const &other) const & {
     vector<common_type_t<T, U>, Length> result;
-    std::transform(cbegin(), cend(), other.cbegin(), result.begin(),
-                   [](auto const &a, auto const &b) { return common_type_t<T, U>(a) + common_type_t<T, U>(b); });
+    detail::binary_n<common_type_t<T, U>>(data(), other.data(), result.data(), Length, std::plus<>());
 
     return result;
   }
 
+  /**
+   * @brief Adds two vectors element-wise, reusing the storage of this expiring vector.
+   *
+   * This overload is selected when the current vector is an rvalue and the result type matches its own type. The
+   * sum is accumulated in place and the vector is moved into the result, avoiding a fresh temporary.
+   *
+   * @tparam U The type of elements in the other vector being added.
+   * @param other The vector to add to the current vector.
+   * @return The current vector holding the element-wise sum of the two vectors.
+   */
+  template <vector_type U>
+    requires std::is_same_v<common_type_t<T, U>, T>
+  [[nodiscard]] constexpr vector add(vector<U, Length> const &other) && {
+    *this += other;
+    return std::move(*this);
+  }
+
   /**
    * @brief Adds a scalar to each element of the vector and returns the result.
    *
@@ -227,13 +278,31 @@ public:
    * @return A new vector where each element is the result of adding the scalar to the corresponding element.
    */
   template <typename U>
-  [[nodiscard]] constexpr auto add(U const scalar) const {
-    vector<common_type_t<T, U>, Length> result;
-    std::transform(cbegin(), cend(), result.begin(),
-                   [scalar](auto const &a) { return common_type_t<T, U>(a) + common_type_t<T, U>(scalar); });
+  [[nodiscard]] constexpr auto add(U const scalar) const & {
+    using R = common_type_t<T, U>;
+    using C = detail::compute_type_t<R>;
+    vector<R, Length> result;
+    detail::unary_n<C>(data(), result.data(), Length,
+                       [scalar = detail::element_cast<C>(scalar)](C const &a) { return a + scalar; });
     return result;
   }
 
+  /**
+   * @brief Adds a scalar to each element of this expiring vector in place and returns it.
+   *
+   * This overload is selected when the current vector is an rvalue and the result type matches its own type.
+   *
+   * @tparam U The type of the scalar value being added.
+   * @param scalar The scalar value to add to each element of the vector.
+   * @return The current vector with the scalar added to each element.
+   */
+  template <vector_type U>
+    requires std::is_same_v<common_type_t<T, U>, T>
+  [[nodiscard]] constexpr vector add(U const scalar) && {
+    *this += scalar;
+    return std::move(*this);
+  }
+
   /**
    * @brief Adds two vectors element-wise using the `+` operator.
    *
@@ -245,10 +314,22 @@ public:
    * @return A new vector containing the element-wise sum of the two vectors.
    */
   template <vector_type U>
-  [[nodiscard]] constexpr auto operator+(vector<U, Length> const &other) const {
+  [[nodiscard]] constexpr auto operator+(vector<U, Length> const &other) const & {
     return add(other);
   }
 
+  /**
+   * @brief Adds two vectors element-wise using the `+` operator, reusing this expiring vector when possible.
+   *
+   * @tparam U The type of elements in the other vector being added.
+   * @param other The vector to add to the current vector.
+   * @return A vector containing the element-wise sum of the two vectors.
+   */
+  template <vector_type U>
+  [[nodiscard]] constexpr auto operator+(vector<U, Length> const &other) && {
+    return std::move(*this).add(other);
+  }
+
   /**
    * @brief Adds a scalar to each element of the vector using the `+` operator.
    *
@@ -260,10 +341,22 @@ public:
    * @return A new vector where each element is the result of adding the scalar to the corresponding element.
    */
   template <vector_type U>
-  [[nodiscard]] constexpr auto operator+(U const scalar) const {
+  [[nodiscard]] constexpr auto operator+(U const scalar) const & {
     return add(scalar);
   }
 
+  /**
+   * @brief Adds a scalar to each element using the `+` operator, reusing this expiring vector when possible.
+   *
+   * @tparam U The type of the scalar value being added.
+   * @param scalar The scalar value to add to each element of the vector.
+   * @return A vector where each element is the result of adding the scalar to the corresponding element.
+   */
+  template <vector_type U>
+  [[nodiscard]] constexpr auto operator+(U const scalar) && {
+    return std::move(*this).add(scalar);
+  }
+
   /**
    * @brief Adds a scalar to a vector.
    *
@@ -281,6 +374,20 @@ public:
     return vec + scalar;
   }
 
+  /**
+   * @brief Adds a scalar to an expiring vector, reusing its storage when the result type matches.
+   *
+   * @tparam U The type of the scalar.
+   * @param scalar The scalar value to add.
+   * @param vec The expiring vector to add the scalar to.
+   *
+   * @return A vector with the result of the addition.
+   */
+  template <vector_type U>
+  friend constexpr auto operator+(U const scalar, vector<T, Length> &&vec) {
+    return std::move(vec) + scalar;
+  }
+
   /**
    * @brief Performs element-wise addition of two vectors using the `+=` operator.
    *
@@ -293,8 +400,7 @@ public:
    */
   template <vector_type U>
   constexpr auto &operator+=(vector<U, Length> const &other) {
-    std::transform(cbegin(), cend(), other.cbegin(), begin(),
-                   [](auto const &a, auto const &b) { return common_type_t<T, U>(a) + common_type_t<T, U>(b); });
+    detail::binary_n<common_type_t<T, U>>(data(), other.data(), data(), Length, std::plus<>());
     return *this;
   }
 
@@ -310,8 +416,10 @@ public:
    */
   template <vector_type U>
   constexpr auto &operator+=(U const scalar) {
-    std::transform(cbegin(), cend(), begin(),
-                   [scalar](T const &el) { return common_type_t<T, U>(el) + common_type_t<T, U>(scalar); });
+    using R = common_type_t<T, U>;
+    using C = detail::compute_type_t<R>;
+    detail::unary_n<C>(data(), data(), Length,
+                       [scalar = detail::element_cast<C>(scalar)](C const &el) { return el + scalar; });
     return *this;
   }
 
@@ -326,10 +434,26 @@ public:
    * @return A new vector containing the result of the element-wise subtraction.
    */
   template <vector_type U>
-  [[nodiscard]] constexpr auto subtract(vector<U, Length> const &other) const {
+  [[nodiscard]] constexpr auto subtract(vector<U, Length> const &other) const & {
     return add(-other);
   }
 
+  /**
+   * @brief Subtracts another vector from this expiring vector in place and returns it.
+   *
+   * This overload is selected when the current vector is an rvalue and the result type matches its own type.
+   *
+   * @tparam U The type of elements in the other vector being subtracted.
+   * @param other The vector to subtract from the current vector.
+   * @return The current vector holding the result of the element-wise subtraction.
+   */
+  template <vector_type U>
+    requires std::is_same_v<common_type_t<T, U>, T>
+  [[nodiscard]] constexpr vector subtract(vector<U, Length> const &other) && {
+    *this -= other;
+    return std::move(*this);
+  }
+
   /**
    * @brief Subtracts a scalar from each element of the vector.
    *
@@ -341,10 +465,26 @@ public:
    * @return A new vector where each element is the result of subtracting the scalar from the corresponding element.
    */
   template <vector_type U>
-  [[nodiscard]] constexpr auto subtract(U const scalar) const {
+  [[nodiscard]] constexpr auto subtract(U const scalar) const & {
     return add(-scalar);
   }
 
+  /**
+   * @brief Subtracts a scalar from each element of this expiring vector in place and returns it.
+   *
+   * This overload is selected when the current vector is an rvalue and the result type matches its own type.
+   *
+   * @tparam U The type of the scalar value being subtracted.
+   * @param scalar The scalar value to subtract from each element of the vector.
+   * @return The current vector with the scalar subtracted from each element.
+   */
+  template <vector_type U>
+    requires std::is_same_v<common_type_t<T, U>, T>
+  [[nodiscard]] constexpr vector subtract(U const scalar) && {
+    *this -= scalar;
+    return std::move(*this);
+  }
+
   /**
    * @brief Subtracts another vector from this vector using the `-` operator.
    *
@@ -356,10 +496,22 @@ public:
    * @return A new vector containing the result of the element-wise subtraction.
    */
   template <vector_type U>
-  [[nodiscard]] constexpr auto operator-(vector<U, Length> const &other) const {
+  [[nodiscard]] constexpr auto operator-(vector<U, Length> const &other) const & {
     return subtract(other);
   }
 
+  /**
+   * @brief Subtracts another vector using the `-` operator, reusing this expiring vector when possible.
+   *
+   * @tparam U The type of elements in the other vector being subtracted.
+   * @param other The vector to subtract from the current vector.
+   * @return A vector containing the result of the element-wise subtraction.
+   */
+  template <vector_type U>
+  [[nodiscard]] constexpr auto operator-(vector<U, Length> const &other) && {
+    return std::move(*this).subtract(other);
+  }
+
   /**
    * @brief Subtracts a scalar from each element of the vector using the `-` operator.
    *
@@ -371,10 +523,22 @@ public:
    * @return A new vector where each element is the result of subtracting the scalar from the corresponding element.
    */
   template <vector_type U>
-  [[nodiscard]] constexpr auto operator-(U const scalar) const {
+  [[nodiscard]] constexpr auto operator-(U const scalar) const & {
     return subtract(scalar);
   }
 
+  /**
+   * @brief Subtracts a scalar from each element using the `-` operator, reusing this expiring vector when possible.
+   *
+   * @tparam U The type of the scalar value being subtracted.
+   * @param scalar The scalar value to subtract from each element of the vector.
+   * @return A vector where each element is the result of subtracting the scalar from the corresponding element.
+   */
+  template <vector_type U>
+  [[nodiscard]] constexpr auto operator-(U const scalar) && {
+    return std::move(*this).subtract(scalar);
+  }
+
   /**
    * @brief Subtracts a scalar to a vector.
    *
@@ -392,6 +556,20 @@ public:
     return vec - scalar;
   }
 
+  /**
+   * @brief Subtracts a scalar from an expiring vector, reusing its storage when the result type matches.
+   *
+   * @tparam U The type of the scalar.
+   * @param scalar The scalar value to subtract.
+   * @param vec The expiring vector to subtract the scalar from.
+   *
+   * @return A vector with the result of the subtraction.
+   */
+  template <vector_type U>
+  friend constexpr auto operator-(U const scalar, vector<T, Length> &&vec) {
+    return std::move(vec) - scalar;
+  }
+
   /**
    * @brief Performs element-wise subtraction of another vector using the `-=` operator.
    *
@@ -404,8 +582,7 @@ public:
    */
   template <vector_type U>
   constexpr auto &operator-=(vector<U, Length> const &other) {
-    std::transform(cbegin(), cend(), other.cbegin(), begin(),
-                   [](auto const &a, auto const &b) { return common_type_t<T, U>(a) - common_type_t<T, U>(b); });
+    detail::binary_n<common_type_t<T, U>>(data(), other.data(), data(), Length, std::minus<>());
     return *this;
   }
 
@@ -421,8 +598,10 @@ public:
    */
   template <vector_type U>
   constexpr auto &operator-=(U const scalar) {
-    std::transform(cbegin(), cend(), begin(),
-                   [scalar](auto const &el) { return common_type_t<T, U>(el) - common_type_t<T, U>(scalar); });
+    using R = common_type_t<T, U>;
+    using C = detail::compute_type_t<R>;
+    detail::unary_n<C>(data(), data(), Length,
+                       [scalar = detail::element_cast<C>(scalar)](C const &el) { return el - scalar; });
     return *this;
   }
 
@@ -439,15 +618,18 @@ public:
    * @tparam U The type of the elements in the other vector.
    * @param other The vector with which the dot product is computed. This vector must have the same Length as the
    * current vector.
-   * @return The scalar result of the dot product, with type `common_type_t<T, U>`.
+   * @return The scalar result of the dot product, with type `common_type_t<T, U>`, or `float` when that is a 16-bit
+   * floating point type, so that the accumulated value is not rounded back to 16 bits.
    *
    * @throws std::invalid_argument if the vectors have different sizes (if this condition is checked elsewhere).
    */
   template <typename U>
   [[nodiscard]] constexpr auto dot(vector<U, Length> const &other) const {
-    return std::transform_reduce(
-        cbegin(), cend(), other.cbegin(), common_type_t<T, U>(0), std::plus<>(),
-        [](auto const &a, auto const &b) { return common_type_t<T, U>(a) * common_type_t<T, U>(b); });
+    using C = detail::compute_type_t<common_type_t<T, U>>;
+    return std::transform_reduce(cbegin(), cend(), other.cbegin(), C(0), std::plus<>(),
+                                 [](auto const &a, auto const &b) {
+                                   return detail::element_cast<C>(a) * detail::element_cast<C>(b);
+                                 });
   }
 
   /**
@@ -464,11 +646,14 @@ public:
   template <vector_type U>
   [[nodiscard]] constexpr auto cross(vector<U, Length> const &other) const {
     static_assert(Length == 3, "Cross product is only allowed for 3D vectors.");
-    vector<common_type_t<T, U>, Length> cross;
+    using R = common_type_t<T, U>;
+    vector<R, Length> cross;
+    auto const a = as_type<R>();
+    auto const b = other.template as_type<R>();
 
-    cross[0] = (*this)[1] * other[2] - (*this)[2] * other[1];
-    cross[1] = (*this)[2] * other[0] - (*this)[0] * other[2];
-    cross[2] = (*this)[0] * other[1] - (*this)[1] * other[0];
+    cross[0] = a[1] * b[2] - a[2] * b[1];
+    cross[1] = a[2] * b[0] - a[0] * b[2];
+    cross[2] = a[0] * b[1] - a[1] * b[0];
 
     return cross;
   }
@@ -484,13 +669,31 @@ public:
    * @return A new vector where each element is scaled by the scalar.
    */
   template <vector_type U>
-  [[nodiscard]] constexpr auto scale(U const scalar) const {
-    vector<common_type_t<T, U>, Length> result;
-    std::transform(cbegin(), cend(), result.begin(),
-                   [scalar](auto const &el) { return common_type_t<T, U>(el) * common_type_t<T, U>(scalar); });
+  [[nodiscard]] constexpr auto scale(U const scalar) const & {
+    using R = common_type_t<T, U>;
+    using C = detail::compute_type_t<R>;
+    vector<R, Length> result;
+    detail::unary_n<C>(data(), result.data(), Length,
+                       [scalar = detail::element_cast<C>(scalar)](C const &el) { return el * scalar; });
     return result;
   }
 
+  /**
+   * @brief Scales this expiring vector in place by a given scalar and returns it.
+   *
+   * This overload is selected when the current vector is an rvalue and the result type matches its own type.
+   *
+   * @tparam U The type of the scalar value.
+   * @param scalar The scalar value to scale the vector by.
+   * @return The current vector with each element scaled by the scalar.
+   */
+  template <vector_type U>
+    requires std::is_same_v<common_type_t<T, U>, T>
+  [[nodiscard]] constexpr vector scale(U const scalar) && {
+    *this *= scalar;
+    return std::move(*this);
+  }
+
   /**
    * @brief Calculates the dot product using the `*` operator.
    *
@@ -516,10 +719,22 @@ public:
    * @return A new vector where each element is scaled by the scalar.
    */
   template <vector_type U>
-  [[nodiscard]] constexpr auto operator*(U const scalar) const {
+  [[nodiscard]] constexpr auto operator*(U const scalar) const & {
     return scale(scalar);
   }
 
+  /**
+   * @brief Scales the vector using the `*` operator, reusing this expiring vector when possible.
+   *
+   * @tparam U The type of the scalar value.
+   * @param scalar The scalar value to scale the vector by.
+   * @return A vector where each element is scaled by the scalar.
+   */
+  template <vector_type U>
+  [[nodiscard]] constexpr auto operator*(U const scalar) && {
+    return std::move(*this).scale(scalar);
+  }
+
   /**
    * @brief Scales a vector by a scalar.
    *
@@ -537,6 +752,20 @@ public:
     return vec * scalar;
   }
 
+  /**
+   * @brief Scales an expiring vector by a scalar, reusing its storage when the result type matches.
+   *
+   * @tparam U The type of the scalar.
+   * @param scalar The scalar value to scale by.
+   * @param vec The expiring vector to scale.
+   *
+   * @return A vector with the result of the scaling.
+   */
+  template <vector_type U>
+  friend constexpr auto operator*(U const scalar, vector<T, Length> &&vec) {
+    return std::move(vec) * scalar;
+  }
+
   /**
    * @brief Scales the vector in place using the `*=` operator.
    *
@@ -548,8 +777,10 @@ public:
    */
   template <vector_type U>
   constexpr auto &operator*=(U const scalar) {
-    std::transform(cbegin(), cend(), begin(),
-                   [scalar](auto const &el) { return common_type_t<T, U>(el) * common_type_t<T, U>(scalar); });
+    using R = common_type_t<T, U>;
+    using C = detail::compute_type_t<R>;
+    detail::unary_n<C>(data(), data(), Length,
+                       [scalar = detail::element_cast<C>(scalar)](C const &el) { return el * scalar; });
     return *this;
   }
 
@@ -563,10 +794,22 @@ public:
    * @return A new vector where each element is scaled by the reciprocal of the scalar.
    */
   template <vector_type U>
-  [[nodiscard]] constexpr auto operator/(U const scalar) const {
+  [[nodiscard]] constexpr auto operator/(U const scalar) const & {
     return scale(1 / scalar);
   }
 
+  /**
+   * @brief Scales the vector by the inverse of a scalar, reusing this expiring vector when possible.
+   *
+   * @tparam U The type of the scalar value.
+   * @param scalar The scalar value to scale the vector by.
+   * @return A vector where each element is scaled by the reciprocal of the scalar.
+   */
+  template <vector_type U>
+  [[nodiscard]] constexpr auto operator/(U const scalar) && {
+    return std::move(*this).scale(1 / scalar);
+  }
+
   /**
    * @brief Performs inverse scaling of a vector by a scalar.
    *
@@ -584,6 +827,20 @@ public:
     return vec / scalar;
   }
 
+  /**
+   * @brief Performs inverse scaling of an expiring vector, reusing its storage when the result type matches.
+   *
+   * @tparam U The type of the scalar.
+   * @param scalar The scalar value to inversely scale by.
+   * @param vec The expiring vector to scale.
+   *
+   * @return A vector with the result of the inverse scaling.
+   */
+  template <vector_type U>
+  friend constexpr auto operator/(U const scalar, vector<T, Length> &&vec) {
+    return std::move(vec) / scalar;
+  }
+
   /**
    * @brief Scales the vector in place using the `/=` operator.
    *
@@ -595,8 +852,10 @@ public:
    */
   template <vector_type U>
   constexpr auto &operator/=(U const scalar) {
-    std::transform(cbegin(), cend(), begin(),
-                   [scalar](T const &el) { return common_type_t<T, U>(el) * (1 / common_type_t<T, U>(scalar)); });
+    using R = common_type_t<T, U>;
+    using C = detail::compute_type_t<R>;
+    detail::unary_n<C>(data(), data(), Length,
+                       [inverse = 1 / detail::element_cast<C>(scalar)](C const &el) { return el * inverse; });
     return *this;
   }
 
@@ -607,33 +866,207 @@ public:
    *
    * @return A new vector representing the negated value of the current vector.
    */
-  [[nodiscard]] constexpr auto operator-() const {
+  [[nodiscard]] constexpr auto operator-() const & {
     return scale(-1);
   }
 
+  /**
+   * @brief Negates this expiring vector, reusing its storage when the result type matches.
+   *
+   * @return A vector representing the negated value of the current vector.
+   */
+  [[nodiscard]] constexpr auto operator-() && {
+    return std::move(*this).scale(-1);
+  }
+
+  /**
+   * @brief Computes the sum of all elements of the vector.
+   *
+   * The reduction uses several independent accumulators, so floating point results may differ from a strictly
+   * sequential sum in the last bits.
+   *
+   * @return The sum of the elements, of the element type, or `float` for 16-bit floating point elements.
+   */
+  [[nodiscard]] constexpr detail::compute_type_t<T> sum() const {
+    using C = detail::compute_type_t<T>;
+    return detail::reduce_n(data(), Length, C(0), detail::element_cast<C, T>, std::plus<>());
+  }
+
+  /**
+   * @brief Computes the product of all elements of the vector.
+   *
+   * @return The product of the elements, of the element type, or `float` for 16-bit floating point elements. The
+   * product of an empty vector is one.
+   */
+  [[nodiscard]] constexpr detail::compute_type_t<T> product() const {
+    using C = detail::compute_type_t<T>;
+    return detail::reduce_n(data(), Length, C(1), detail::element_cast<C, T>, std::multiplies<>());
+  }
+
+  /**
+   * @brief Finds the smallest element of the vector.
+   *
+   * NaN elements propagate: if any element is NaN, the result is NaN.
+   *
+   * @return The smallest element.
+   */
+  [[nodiscard]] constexpr T min() const
+    requires std::is_arithmetic_v<T>
+  {
+    static_assert(Length > 0, "min is not defined for empty vectors.");
+    return detail::reduce_n(data(), Length, (*this)[0], std::identity(), detail::propagating_min());
+  }
+
+  /**
+   * @brief Finds the largest element of the vector.
+   *
+   * NaN elements propagate: if any element is NaN, the result is NaN.
+   *
+   * @return The largest element.
+   */
+  [[nodiscard]] constexpr T max() const
+    requires std::is_arithmetic_v<T>
+  {
+    static_assert(Length > 0, "max is not defined for empty vectors.");
+    return detail::reduce_n(data(), Length, (*this)[0], std::identity(), detail::propagating_max());
+  }
+
+  /**
+   * @brief Finds the index of the smallest element of the vector.
+   *
+   * When several elements are equal to the minimum, the lowest index is returned. If the vector contains NaN, the
+   * index of the first NaN is returned, consistent with min().
+   *
+   * @return The index of the smallest element.
+   */
+  [[nodiscard]] constexpr std::size_t argmin() const
+    requires std::is_arithmetic_v<T>
+  {
+    static_assert(Length > 0, "argmin is not defined for empty vectors.");
+    return detail::arg_extremum_n<false>(data(), Length);
+  }
+
+  /**
+   * @brief Finds the index of the largest element of the vector.
+   *
+   * When several elements are equal to the maximum, the lowest index is returned. If the vector contains NaN, the
+   * index of the first NaN is returned, consistent with max().
+   *
+   * @return The index of the largest element.
+   */
+  [[nodiscard]] constexpr std::size_t argmax() const
+    requires std::is_arithmetic_v<T>
+  {
+    static_assert(Length > 0, "argmax is not defined for empty vectors.");
+    return detail::arg_extremum_n<true>(data(), Length);
+  }
+
+  /**
+   * @brief Computes the squared Euclidean magnitude of the vector, without taking the square root.
+   *
+   * For real vectors this is the dot product of the vector with itself and has the element type, or `float` for 16-bit
+   * floating point elements, whose squares soon exceed the 16-bit range. For complex vectors it is the sum of the
+   * squared moduli of the elements, accumulated in `double`.
+   *
+   * @return The squared magnitude of the vector.
+   */
+  [[nodiscard]] constexpr auto squared_norm() const {
+    if constexpr (is_complex_v<T>) {
+      return detail::reduce_n(
+          data(), Length, 0.0,
+          [](T const &val) { return double(val.real()) * double(val.real()) + double(val.imag()) * double(val.imag()); },
+          std::plus<>());
+    } else {
+      using C = detail::compute_type_t<T>;
+      return detail::reduce_n(
+          data(), Length, C(0), [](T const &val) { return detail::element_cast<C>(val) * detail::element_cast<C>(val); },
+          std::plus<>());
+    }
+  }
+
   /**
    * @brief Computes the Euclidean magnitude (Length) of the vector.
    *
-   * This function calculates the Euclidean magnitude of the vector.
-   * For real number vectors, the magnitude is computed as the square root
-   * of the dot product of the vector with itself. For complex number vectors,
-   * the magnitude is calculated as the square root of the sum of the squared
-   * magnitudes of each element (using `std::norm` for the squared modulus).
+   * This function calculates the Euclidean magnitude of the vector as the square root of squared_norm(). For real
+   * number vectors this is the square root of the dot product of the vector with itself. For complex number vectors,
+   * the magnitude is calculated as the square root of the sum of the squared magnitudes of each element.
    *
-   * If the vector contains complex numbers, the function uses
-   * `std::transform_reduce` to compute the sum of the squared magnitudes
-   * of each element. For real numbers, the function uses the `dot` product
-   * of the vector with itself and returns the square root of that result.
+   * The square root is taken with `firefly::math::sqrt`, so the norm can also be computed in constant expressions.
    *
    * @return The magnitude of the vector as a scalar value.
    */
   [[nodiscard]] constexpr auto norm() const {
+    return math::sqrt(squared_norm());
+  }
+
+  /**
+   * @brief Computes the L1 (Manhattan) norm of the vector, the sum of the absolute values of its elements.
+   *
+   * @return The L1 norm. Real vectors return the element type, or `float` for 16-bit floating point elements, and
+   * complex vectors return `double`.
+   */
+  [[nodiscard]] constexpr auto l1_norm() const {
     if constexpr (is_complex_v<T>) {
-      return std::sqrt(std::transform_reduce(cbegin(), cend(), 0.0, std::plus<>(), [](const auto &val) {
-        return std::norm(val); // |val|^2 = val * conj(val)
-      }));
+      return detail::reduce_n(data(), Length, 0.0, [](T const &val) { return std::abs(val); }, std::plus<>());
+    } else {
+      using C = detail::compute_type_t<T>;
+      return detail::reduce_n(
+          data(), Length, C(0), [](T const &val) { return detail::element_cast<C>(magnitude(val)); }, std::plus<>());
+    }
+  }
+
+  /**
+   * @brief Computes the L-infinity (Chebyshev) norm of the vector, the largest absolute value of its elements.
+   *
+   * NaN elements propagate to the result.
+   *
+   * @return The L-infinity norm. Real vectors return the element type, complex vectors return `double`.
+   */
+  [[nodiscard]] constexpr auto linf_norm() const {
+    if constexpr (is_complex_v<T>) {
+      return detail::reduce_n(data(), Length, 0.0, [](T const &val) { return std::abs(val); },
+                              detail::propagating_max());
+    } else {
+      return detail::reduce_n(data(), Length, T(0), magnitude, detail::propagating_max());
+    }
+  }
+
+  /**
+   * @brief Computes the general Lp norm of the vector, `(sum |x|^P)^(1/P)`.
+   *
+   * P = 1 and P = 2 are forwarded to l1_norm() and norm(). Other orders raise each magnitude to the power P with
+   * repeated multiplication before taking the P-th root.
+   *
+   * @tparam P The order of the norm, at least one.
+   * @return The Lp norm as a floating point value.
+   */
+  template <unsigned P>
+  [[nodiscard]] constexpr auto lp_norm() const {
+    static_assert(P >= 1, "Lp norm requires P >= 1.");
+    using R = math::float_type_t<decltype(l1_norm())>;
+
+    if constexpr (P == 1) {
+      return static_cast<R>(l1_norm());
+    } else if constexpr (P == 2) {
+      return static_cast<R>(norm());
     } else {
-      return std::sqrt(dot(*this));
+      auto const powered = detail::reduce_n(
+          data(), Length, R(0),
+          [](T const &val) {
+            R m;
+            if constexpr (is_complex_v<T>) {
+              m = static_cast<R>(std::abs(val));
+            } else {
+              m = static_cast<R>(magnitude(val));
+            }
+            R result = 1;
+            for (unsigned i = 0; i < P; ++i) {
+              result *= m;
+            }
+            return result;
+          },
+          std::plus<>());
+      return static_cast<R>(std::pow(powered, R(1) / R(P)));
     }
   }
 
@@ -651,7 +1084,14 @@ public:
     if (_norm == 0) {
       throw std::logic_error("zero norm results in divide by zero");
     }
-    return scale(1 / norm());
+    if constexpr (detail::is_half_v<T>) {
+      // The norm is a float; scaling by it directly would promote the result to a float vector.
+      vector result;
+      detail::unary_n<T>(data(), result.data(), Length, [inverse = 1 / _norm](float const el) { return el * inverse; });
+      return result;
+    } else {
+      return scale(1 / _norm);
+    }
   }
 
   /**
@@ -678,11 +1118,187 @@ public:
     return is_equal(other);
   }
 
+  /**
+   * @brief Element-wise equality comparison.
+   *
+   * Both operands are promoted to their common type before comparing.
+   *
+   * @tparam U The type of elements in the other vector, or the type of a scalar to compare every element with.
+   * @param other The vector or scalar to compare with.
+   * @return A mask set where the elements compare equal.
+   */
+  template <vector_type U>
+  [[nodiscard]] constexpr auto eq(U const &other) const {
+    return compare(other, std::equal_to<>());
+  }
+
+  /// @copydoc eq(U const &) const
+  template <vector_type U>
+  [[nodiscard]] constexpr auto eq(vector<U, Length> const &other) const {
+    return compare(other, std::equal_to<>());
+  }
+
+  /**
+   * @brief Element-wise inequality comparison.
+   *
+   * @tparam U The type of elements in the other vector, or the type of a scalar to compare every element with.
+   * @param other The vector or scalar to compare with.
+   * @return A mask set where the elements do not compare equal.
+   */
+  template <vector_type U>
+  [[nodiscard]] constexpr auto ne(U const &other) const {
+    return compare(other, std::not_equal_to<>());
+  }
+
+  /// @copydoc ne(U const &) const
+  template <vector_type U>
+  [[nodiscard]] constexpr auto ne(vector<U, Length> const &other) const {
+    return compare(other, std::not_equal_to<>());
+  }
+
+  /**
+   * @brief Element-wise less-than comparison. Only arithmetic element types are ordered.
+   *
+   * @tparam U The type of elements in the other vector, or the type of a scalar to compare every element with.
+   * @param other The vector or scalar to compare with.
+   * @return A mask set where this vector's element is less than the other.
+   */
+  template <vector_type U>
+    requires std::is_arithmetic_v<T> && std::is_arithmetic_v<U>
+  [[nodiscard]] constexpr auto lt(U const &other) const {
+    return compare(other, std::less<>());
+  }
+
+  /// @copydoc lt(U const &) const
+  template <vector_type U>
+    requires std::is_arithmetic_v<T> && std::is_arithmetic_v<U>
+  [[nodiscard]] constexpr auto lt(vector<U, Length> const &other) const {
+    return compare(other, std::less<>());
+  }
+
+  /**
+   * @brief Element-wise less-than-or-equal comparison. Only arithmetic element types are ordered.
+   *
+   * @tparam U The type of elements in the other vector, or the type of a scalar to compare every element with.
+   * @param other The vector or scalar to compare with.
+   * @return A mask set where this vector's element is less than or equal to the other.
+   */
+  template <vector_type U>
+    requires std::is_arithmetic_v<T> && std::is_arithmetic_v<U>
+  [[nodiscard]] constexpr auto le(U const &other) const {
+    return compare(other, std::less_equal<>());
+  }
+
+  /// @copydoc le(U const &) const
+  template <vector_type U>
+    requires std::is_arithmetic_v<T> && std::is_arithmetic_v<U>
+  [[nodiscard]] constexpr auto le(vector<U, Length> const &other) const {
+    return compare(other, std::less_equal<>());
+  }
+
+  /**
+   * @brief Element-wise greater-than comparison. Only arithmetic element types are ordered.
+   *
+   * @tparam U The type of elements in the other vector, or the type of a scalar to compare every element with.
+   * @param other The vector or scalar to compare with.
+   * @return A mask set where this vector's element is greater than the other.
+   */
+  template <vector_type U>
+    requires std::is_arithmetic_v<T> && std::is_arithmetic_v<U>
+  [[nodiscard]] constexpr auto gt(U const &other) const {
+    return compare(other, std::greater<>());
+  }
+
+  /// @copydoc gt(U const &) const
+  template <vector_type U>
+    requires std::is_arithmetic_v<T> && std::is_arithmetic_v<U>
+  [[nodiscard]] constexpr auto gt(vector<U, Length> const &other) const {
+    return compare(other, std::greater<>());
+  }
+
+  /**
+   * @brief Element-wise greater-than-or-equal comparison. Only arithmetic element types are ordered.
+   *
+   * @tparam U The type of elements in the other vector, or the type of a scalar to compare every element with.
+   * @param other The vector or scalar to compare with.
+   * @return A mask set where this vector's element is greater than or equal to the other.
+   */
+  template <vector_type U>
+    requires std::is_arithmetic_v<T> && std::is_arithmetic_v<U>
+  [[nodiscard]] constexpr auto ge(U const &other) const {
+    return compare(other, std::greater_equal<>());
+  }
+
+  /// @copydoc ge(U const &) const
+  template <vector_type U>
+    requires std::is_arithmetic_v<T> && std::is_arithmetic_v<U>
+  [[nodiscard]] constexpr auto ge(vector<U, Length> const &other) const {
+    return compare(other, std::greater_equal<>());
+  }
+
+  /**
+   * @brief Element-wise approximate equality with an absolute tolerance.
+   *
+   * Elements are considered equal when `|a - b| <= tolerance`, computed in the common type. NaN never compares equal.
+   *
+   * @tparam U The type of elements in the other vector.
+   * @param other The vector to compare with.
+   * @param tolerance The largest absolute difference considered equal.
+   * @return A mask set where the elements are within the tolerance.
+   */
+  template <vector_type U>
+  [[nodiscard]] constexpr auto approx_eq(vector<U, Length> const &other, double tolerance) const {
+    using R = common_type_t<T, U>;
+    mask<Length> result;
+    detail::binary_n<R>(data(), other.data(), result.data(), Length, [tolerance](R const &a, R const &b) {
+      if constexpr (is_complex_v<R>) {
+        return std::abs(a - b) <= tolerance;
+      } else {
+        // Subtracting the smaller value keeps unsigned differences from wrapping around.
+        return (a < b ? R(b - a) : R(a - b)) <= tolerance;
+      }
+    });
+    return result;
+  }
+
+  /**
+   * @brief Element-wise approximate equality measured in units in the last place (ULP).
+   *
+   * Elements are considered equal when at most `max_ulps` representable values lie between them. Values of opposite
+   * sign are measured across zero, so `-0.0` and `0.0` are equal. NaN never compares equal.
+   *
+   * @param other The vector to compare with, of the same floating point element type.
+   * @param max_ulps The largest distance in ULPs considered equal.
+   * @return A mask set where the elements are within the given number of ULPs.
+   */
+  [[nodiscard]] constexpr auto approx_eq_ulp(vector<T, Length> const &other, std::uint64_t max_ulps = 4) const
+    requires(std::is_same_v<T, float> || std::is_same_v<T, double>)
+  {
+    using I = std::conditional_t<sizeof(T) == 8, std::int64_t, std::int32_t>;
+    using UI = std::make_unsigned_t<I>;
+    auto const ordered = [](T const &value) {
+      auto const bits = std::bit_cast<I>(value);
+      return bits < 0 ? UI(UI(0) - UI(bits)) : UI(UI(bits) + UI(std::numeric_limits<I>::min()));
+    };
+
+    mask<Length> result;
+    detail::binary_n<T>(data(), other.data(), result.data(), Length, [&](T const &a, T const &b) {
+      auto const ia = ordered(a);
+      auto const ib = ordered(b);
+      return a == a && b == b && (ia > ib ? ia - ib : ib - ia) <= max_ulps;
+    });
+    return result;
+  }
+
   /**
    * @brief Converts the vector elements to a different type, handling complex numbers.
    *
-   * If the elements are of type `std::complex`, it multiplies the element by its conjugate and
-   * then casts the result to the specified type. For other types, it performs a direct cast.
+   * If the elements are of type `std::complex` and `AsType` is not, it multiplies the element by its conjugate and
+   * then casts the result to the specified type. Complex to complex conversions are done component-wise and other
+   * types perform a direct cast.
+   *
+   * The conversion runs as a single bulk kernel over the contiguous storage, so int/float and float/double
+   * conversions compile to packed conversion instructions.
    *
    * @tparam AsType The type to which the elements will be cast.
    * @return A new vector with elements of the specified type.
@@ -690,15 +1306,7 @@ public:
   template <vector_type AsType>
   [[nodiscard]] vector<AsType, Length> constexpr const as_type() const {
     vector<AsType, Length> result;
-
-    std::transform(cbegin(), cend(), result.begin(), [](T el) {
-      if constexpr (std::is_same_v<T, std::complex<typename T::value_type>>) {
-        return static_cast<AsType>(el.real() * el.real() + el.imag() * el.imag());
-      } else {
-        return static_cast<AsType>(el);
-      }
-    });
-
+    detail::convert_n(data(), result.data(), Length);
     return result;
   }
 
@@ -743,6 +1351,201 @@ public:
     os << other.view();
     return os;
   }
+
+private:
+  template <vector_type U, typename Op>
+  constexpr auto compare(vector<U, Length> const &other, Op op) const {
+    mask<Length> result;
+    detail::binary_n<common_type_t<T, U>>(data(), other.data(), result.data(), Length, op);
+    return result;
+  }
+
+  template <vector_type U, typename Op>
+  constexpr auto compare(U const &scalar, Op op) const {
+    using R = common_type_t<T, U>;
+    using C = detail::compute_type_t<R>;
+    mask<Length> result;
+    detail::unary_n<C>(data(), result.data(), Length,
+                       [op, scalar = detail::element_cast<C>(scalar)](C const &el) { return op(el, scalar); });
+    return result;
+  }
+
+  /**
+   * @brief Absolute value of a real element, usable in constant expressions.
+   *
+   * @param val The element.
+   * @return The absolute value of the element.
+   */
+  static constexpr T magnitude(T const &val) {
+    if constexpr (std::is_unsigned_v<T>) {
+      return val;
+    } else {
+      return val < T(0) ? T(-val) : val;
+    }
+  }
 };
 
+namespace detail {
+
+/**
+ * @brief Checks whether `V` is a firefly::vector, used to constrain batched functions over ranges of vectors.
+ *
+ * @tparam V The type to check.
+ */
+template <typename V>
+inline constexpr bool is_vector_v = false;
+
+template <vector_type T, std::size_t Length>
+inline constexpr bool is_vector_v<vector<T, Length>> = true;
+
+/**
+ * @brief The number of elements of the firefly::vector type `V`.
+ *
+ * @tparam V The vector type.
+ */
+template <typename V>
+inline constexpr std::size_t vector_length_v = 0;
+
+template <vector_type T, std::size_t Length>
+inline constexpr std::size_t vector_length_v<vector<T, Length>> = Length;
+
+} // namespace detail
+
+/**
+ * @brief Branchless element-wise selection between two vectors.
+ *
+ * Each element of the result is taken from `a` where the mask is set and from `b` otherwise. Both operands are
+ * promoted to their common type, and the loop compiles to blend instructions instead of branches.
+ *
+ * @tparam T The type of elements in the first vector.
+ * @tparam U The type of elements in the second vector.
+ * @tparam Length The number of elements.
+ * @param m The mask choosing between the vectors.
+ * @param a The vector selected where the mask is set.
+ * @param b The vector selected where the mask is clear.
+ * @return A new vector holding the selected elements.
+ */
+template <vector_type T, vector_type U, std::size_t Length>
+[[nodiscard]] constexpr auto select(mask<Length> const &m, vector<T, Length> const &a, vector<U, Length> const &b) {
+  using R = common_type_t<T, U>;
+  vector<R, Length> result;
+  for (std::size_t i = 0; i < Length; ++i) {
+    auto const x = detail::element_cast<R>(a[i]);
+    auto const y = detail::element_cast<R>(b[i]);
+    result[i] = m[i] ? x : y;
+  }
+  return result;
+}
+
+/**
+ * @brief Branchless element-wise selection between a vector and a scalar.
+ *
+ * @tparam T The type of elements in the vector.
+ * @tparam U The type of the scalar.
+ * @tparam Length The number of elements.
+ * @param m The mask choosing between the vector and the scalar.
+ * @param a The vector selected where the mask is set.
+ * @param scalar The value selected where the mask is clear.
+ * @return A new vector holding the selected elements.
+ */
+template <vector_type T, vector_type U, std::size_t Length>
+[[nodiscard]] constexpr auto select(mask<Length> const &m, vector<T, Length> const &a, U const scalar) {
+  return select(m, a, vector<U, Length>(scalar));
+}
+
+/**
+ * @class where_expression
+ * @brief Proxy returned by firefly::where that applies compound assignments only to the masked elements.
+ *
+ * @tparam T The type of elements in the vector.
+ * @tparam Length The number of elements.
+ */
+template <vector_type T, std::size_t Length>
+class where_expression {
+public:
+  /**
+   * @brief Binds a mask to the vector it updates.
+   *
+   * @param m The mask choosing the elements to update.
+   * @param target The vector to update.
+   */
+  constexpr where_expression(mask<Length> const &m, vector<T, Length> &target) : m_(m), target_(target) {}
+
+  /// @brief Assigns `value` to the masked elements.
+  template <typename V>
+  constexpr vector<T, Length> &operator=(V const &value) {
+    return apply<0>(value, [](T const &, auto const &b) { return b; });
+  }
+
+  /// @brief Adds `value` to the masked elements.
+  template <typename V>
+  constexpr vector<T, Length> &operator+=(V const &value) {
+    return apply<0>(value, [](auto const &a, auto const &b) { return a + b; });
+  }
+
+  /// @brief Subtracts `value` from the masked elements.
+  template <typename V>
+  constexpr vector<T, Length> &operator-=(V const &value) {
+    return apply<0>(value, [](auto const &a, auto const &b) { return a - b; });
+  }
+
+  /// @brief Multiplies the masked elements by `value`.
+  template <typename V>
+  constexpr vector<T, Length> &operator*=(V const &value) {
+    return apply<1>(value, [](auto const &a, auto const &b) { return a * b; });
+  }
+
+  /// @brief Divides the masked elements by `value`.
+  template <typename V>
+  constexpr vector<T, Length> &operator/=(V const &value) {
+    return apply<1>(value, [](auto const &a, auto const &b) { return a / b; });
+  }
+
+private:
+  template <typename V>
+  static constexpr auto element(V const &value, std::size_t i) {
+    if constexpr (requires { value[i]; }) {
+      return value[i];
+    } else {
+      return value;
+    }
+  }
+
+  /**
+   * @brief Runs `op` on every lane and blends the masked lanes back. Unmasked lanes get the `Neutral` operand of the
+   * operation instead of `value`, so they cannot divide by zero or overflow.
+   */
+  template <int Neutral, typename V, typename Op>
+  constexpr vector<T, Length> &apply(V const &value, Op op) {
+    for (std::size_t i = 0; i < Length; ++i) {
+      using R = common_type_t<T, std::remove_cvref_t<decltype(element(value, i))>>;
+      R const operand = m_[i] ? detail::element_cast<R>(element(value, i)) : detail::element_cast<R>(Neutral);
+      auto const updated = detail::element_cast<T>(op(detail::element_cast<R>(target_[i]), operand));
+      target_[i] = m_[i] ? updated : target_[i];
+    }
+    return target_;
+  }
+
+  mask<Length> m_;
+  vector<T, Length> &target_;
+};
+
+/**
+ * @brief Starts a masked update of a vector, e.g. `where(v.gt(hi), v) = hi`.
+ *
+ * The operation runs on every lane and the masked lanes are blended back, so the update has no data-dependent
+ * branches. Unmasked lanes operate on a neutral operand (0 for `+=` and `-=`, 1 for `*=` and `/=`), so a masked
+ * update such as `where(d.ne(0), x) /= d` never divides by zero.
+ *
+ * @tparam T The type of elements in the vector.
+ * @tparam Length The number of elements.
+ * @param m The mask choosing the elements to update.
+ * @param target The vector to update.
+ * @return A proxy that applies assignments to the masked elements of `target`.
+ */
+template <vector_type T, std::size_t Length>
+[[nodiscard]] constexpr auto where(mask<Length> const &m, vector<T, Length> &target) {
+  return where_expression<T, Length>(m, target);
+}
+
 } // namespace firefly
@@ -0,0 +1,41 @@
+#include <stdexcept>
+#include <vector>
+
+#include "firefly/batch.hpp"
+#include "firefly/vector.hpp"
+#include "gtest/gtest.h"
+
+TEST(vector_batch, constructor__from_vectors) {
+  std::vector<firefly::vector<int, 3>> vectors{{1, 2, 3}, {4, 5, 6}};
+  firefly::vector_batch<int, 3> batch(vectors);
+
+  ASSERT_EQ(batch.size(), 2);
+  ASSERT_FALSE(batch.empty());
+  ASSERT_EQ(batch.component(1)[0], 2);
+  ASSERT_EQ(batch.component(1)[1], 5);
+  ASSERT_EQ(batch.get(1), (firefly::vector<int, 3>{4, 5, 6}));
+  ASSERT_EQ(batch.to_vectors(), vectors);
+}
+
+TEST(vector_batch, resize__zero_fills) {
+  firefly::vector_batch<float, 2> batch(3);
+  ASSERT_EQ(batch.size(), 3);
+  ASSERT_EQ(batch.get(2), (firefly::vector<float, 2>{0, 0}));
+
+  batch.set(1, {1.5f, -2.0f});
+  batch.push_back({7.0f, 8.0f});
+  ASSERT_EQ(batch.size(), 4);
+  ASSERT_EQ(batch.get(1), (firefly::vector<float, 2>{1.5f, -2.0f}));
+  ASSERT_EQ(batch.component(0)[3], 7.0f);
+
+  batch.clear();
+  ASSERT_TRUE(batch.empty());
+  ASSERT_EQ(batch, (firefly::vector_batch<float, 2>()));
+}
+
+TEST(vector_batch, access__out_of_range_throws) {
+  firefly::vector_batch<double, 2> batch(2);
+  ASSERT_THROW((void)batch.get(2), std::out_of_range);
+  ASSERT_THROW(batch.set(2, {}), std::out_of_range);
+  ASSERT_THROW((void)batch.component(2), std::out_of_range);
+}
@@ -0,0 +1,102 @@
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "firefly/bit_vector.hpp"
+#include "firefly/vector.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+template <std::size_t Bits>
+firefly::bit_vector<Bits> make_signature(std::uint64_t seed) {
+  firefly::bit_vector<Bits> result;
+  for (std::size_t i = 0; i < Bits; ++i) {
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    result.set(i, (seed >> 63) != 0);
+  }
+  return result;
+}
+
+} // namespace
+
+TEST(bit_vector, constructor__packs_bits) {
+  firefly::bit_vector<70> v1{true, false, true};
+  v1.set(69);
+
+  ASSERT_EQ(v1.word_count, 2);
+  ASSERT_EQ(v1.words()[0], 0b101u);
+  ASSERT_EQ(v1.words()[1], std::uint64_t(1) << 5);
+  ASSERT_TRUE(v1.test(69));
+  ASSERT_FALSE(v1.test(68));
+  ASSERT_EQ(v1.popcount(), 3);
+  ASSERT_THROW(({ (void)v1.test(70); }), std::out_of_range);
+}
+
+TEST(bit_vector, from_signs__binarises) {
+  firefly::vector<float, 5> v1{0.5f, -1.0f, 0.0f, 2.0f, -0.1f};
+
+  ASSERT_EQ(firefly::bit_vector<5>::from_signs(v1).view(), "10010");
+  ASSERT_EQ(firefly::bit_vector<5>::from_signs(v1, -0.5f).view(), "10111");
+}
+
+TEST(bit_vector, operators__bitwise) {
+  firefly::bit_vector<4> v1{true, true, false, false};
+  firefly::bit_vector<4> v2{true, false, true, false};
+
+  ASSERT_EQ((v1 & v2).view(), "1000");
+  ASSERT_EQ((v1 | v2).view(), "1110");
+  ASSERT_EQ((v1 ^ v2).view(), "0110");
+  ASSERT_EQ((~v1).view(), "0011");
+  ASSERT_EQ((~v1).popcount(), 2);
+}
+
+TEST(bit_vector, hamming__and_jaccard) {
+  auto v1 = make_signature<1024>(1);
+  auto v2 = make_signature<1024>(2);
+
+  std::size_t expected = 0;
+  for (std::size_t i = 0; i < 1024; ++i) {
+    expected += v1.test(i) != v2.test(i);
+  }
+  ASSERT_EQ(v1.hamming(v2), expected);
+  ASSERT_EQ(v1.hamming(v1), 0);
+  ASSERT_DOUBLE_EQ(v1.jaccard(v2), double((v1 & v2).popcount()) / double((v1 | v2).popcount()));
+  ASSERT_DOUBLE_EQ(firefly::bit_vector<8>().jaccard(firefly::bit_vector<8>()), 1.0);
+}
+
+TEST(bit_vector, constexpr__hamming) {
+  constexpr firefly::bit_vector<3> v1{true, false, true};
+  constexpr firefly::bit_vector<3> v2{false, false, true};
+
+  static_assert(v1.hamming(v2) == 1);
+  ASSERT_EQ(v1.hamming(v2), 1);
+}
+
+TEST(bit_vector, hamming_top_k__selects_closest) {
+  std::vector<firefly::bit_vector<256>> candidates;
+  for (std::uint64_t seed = 0; seed < 200; ++seed) {
+    candidates.push_back(make_signature<256>(seed + 10));
+  }
+  auto query = make_signature<256>(999);
+  candidates[17] = query;
+  candidates[50] = query;
+
+  auto distances = firefly::hamming_scan(query, candidates);
+  auto top = firefly::hamming_top_k(query, candidates, 5);
+
+  ASSERT_EQ(top.size(), 5);
+  ASSERT_EQ(top[0], (std::pair<std::size_t, std::size_t>{17, 0}));
+  ASSERT_EQ(top[1], (std::pair<std::size_t, std::size_t>{50, 0}));
+  for (std::size_t i = 1; i < top.size(); ++i) {
+    ASSERT_LE(top[i - 1].second, top[i].second);
+    ASSERT_EQ(distances[top[i].first], top[i].second);
+  }
+  std::size_t closer = 0;
+  for (auto const distance : distances) {
+    closer += distance < top.back().second;
+  }
+  ASSERT_LT(closer, 5);
+  ASSERT_TRUE(firefly::hamming_top_k(query, std::vector<firefly::bit_vector<256>>(), 3).empty());
+}
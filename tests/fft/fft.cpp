@@ -0,0 +1,161 @@
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <numbers>
+#include <stdexcept>
+#include <vector>
+
+#include "firefly/fft.hpp"
+#include "firefly/vector.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+std::vector<std::complex<double>> make_signal(std::size_t n) {
+  std::vector<std::complex<double>> signal(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    signal[i] = {std::sin(double(i) * 0.7) + 0.25, std::cos(double(i * i) * 0.13)};
+  }
+  return signal;
+}
+
+template <typename U>
+std::vector<U> naive_convolution(std::vector<U> const &a, std::vector<U> const &b) {
+  std::vector<U> result(a.size() + b.size() - 1);
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    for (std::size_t j = 0; j < b.size(); ++j) {
+      result[i + j] += a[i] * b[j];
+    }
+  }
+  return result;
+}
+
+} // namespace
+
+TEST(fft, fft__matches_naive_dft_for_mixed_radix_lengths) {
+  for (std::size_t const n : {1, 2, 3, 4, 5, 6, 7, 8, 12, 16, 30, 49, 60, 64, 97, 100, 128, 243, 360}) {
+    auto const x = make_signal(n);
+    std::vector<std::complex<double>> expected(n);
+    for (std::size_t k = 0; k < n; ++k) {
+      for (std::size_t i = 0; i < n; ++i) {
+        expected[k] += x[i] * std::polar(1.0, -2 * std::numbers::pi * double(k * i % n) / double(n));
+      }
+    }
+    std::vector<std::complex<double>> spectrum(n);
+    firefly::fft(x, spectrum);
+    for (std::size_t k = 0; k < n; ++k) {
+      ASSERT_NEAR(std::abs(spectrum[k] - expected[k]), 0.0, 1e-11 * double(n)) << "n = " << n << ", k = " << k;
+    }
+
+    firefly::ifft(spectrum, spectrum);
+    for (std::size_t i = 0; i < n; ++i) {
+      ASSERT_NEAR(std::abs(spectrum[i] - x[i]), 0.0, 1e-13 * double(n));
+    }
+  }
+}
+
+TEST(fft, fft__float_round_trip) {
+  std::vector<std::complex<float>> x(1024);
+  for (std::size_t i = 0; i < x.size(); ++i) {
+    x[i] = {float(std::sin(double(i))), float(i % 7)};
+  }
+  std::vector<std::complex<float>> y(x.size());
+  firefly::fft_plan<float> const plan(x.size());
+  plan.forward(x, y);
+  plan.inverse(y, y);
+  for (std::size_t i = 0; i < x.size(); ++i) {
+    ASSERT_NEAR(y[i].real(), x[i].real(), 1e-4f);
+    ASSERT_NEAR(y[i].imag(), x[i].imag(), 1e-4f);
+  }
+}
+
+TEST(fft, fft__vectors) {
+  firefly::vector<double, 4> const real{1, 2, 3, 4};
+  auto const spectrum = firefly::fft(real);
+  ASSERT_NEAR(spectrum[0].real(), 10.0, 1e-12);
+  ASSERT_NEAR(spectrum[1].real(), -2.0, 1e-12);
+  ASSERT_NEAR(spectrum[1].imag(), 2.0, 1e-12);
+  ASSERT_NEAR(spectrum[2].real(), -2.0, 1e-12);
+
+  auto const signal = firefly::ifft(spectrum);
+  for (std::size_t i = 0; i < 4; ++i) {
+    ASSERT_NEAR(signal[i].real(), real[i], 1e-12);
+    ASSERT_NEAR(signal[i].imag(), 0.0, 1e-12);
+  }
+}
+
+TEST(fft, fft_plan__cached_per_length) {
+  auto const a = firefly::fft_plan<double>::cached(48);
+  auto const b = firefly::fft_plan<double>::cached(48);
+  ASSERT_EQ(a, b);
+  ASSERT_EQ(a->size(), 48);
+  ASSERT_NE(a, firefly::fft_plan<double>::cached(50));
+
+  std::vector<std::complex<double>> wrong(47);
+  ASSERT_THROW(a->forward(wrong, wrong), std::invalid_argument);
+  ASSERT_THROW(firefly::fft_plan<double>(0), std::invalid_argument);
+}
+
+TEST(fft, convolve__direct_and_fft_match_naive) {
+  for (std::size_t const nb : {5, 40, 300}) {
+    std::vector<double> a(500);
+    std::vector<double> b(nb);
+    for (std::size_t i = 0; i < a.size(); ++i) {
+      a[i] = std::sin(double(i) * 0.1);
+    }
+    for (std::size_t i = 0; i < b.size(); ++i) {
+      b[i] = std::cos(double(i) * 0.37) - 0.2;
+    }
+    std::vector<double> out(a.size() + b.size() - 1);
+    firefly::convolve(a, b, out);
+    auto const expected = naive_convolution(a, b);
+    for (std::size_t i = 0; i < out.size(); ++i) {
+      ASSERT_NEAR(out[i], expected[i], 1e-9);
+    }
+  }
+
+  auto const a = make_signal(200);
+  auto const b = make_signal(77);
+  std::vector<std::complex<double>> out(a.size() + b.size() - 1);
+  firefly::convolve(a, b, out);
+  auto const expected = naive_convolution(a, b);
+  for (std::size_t i = 0; i < out.size(); ++i) {
+    ASSERT_NEAR(std::abs(out[i] - expected[i]), 0.0, 1e-9);
+  }
+
+  std::vector<double> small(3);
+  std::vector<double> empty;
+  ASSERT_THROW(firefly::convolve(small, small, small), std::invalid_argument);
+  ASSERT_THROW(firefly::convolve(empty, small, small), std::invalid_argument);
+}
+
+TEST(fft, correlate__lags_of_shifted_signal) {
+  // b is a delayed by 3 samples, so the correlation peaks at lag -3.
+  std::vector<double> a(100);
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    a[i] = std::sin(double(i * i) * 0.05);
+  }
+  std::vector<double> b(a.size(), 0.0);
+  std::copy(a.begin(), a.end() - 3, b.begin() + 3);
+  std::vector<double> out(a.size() + b.size() - 1);
+  firefly::correlate(a, b, out);
+
+  std::size_t peak = 0;
+  for (std::size_t i = 1; i < out.size(); ++i) {
+    if (out[i] > out[peak]) {
+      peak = i;
+    }
+  }
+  ASSERT_EQ(int(peak) - int(b.size() - 1), -3);
+
+  firefly::vector<std::complex<double>, 2> const x{{1, 1}, {2, 0}};
+  firefly::vector<std::complex<double>, 2> const y{{0, 1}, {1, 0}};
+  auto const c = firefly::correlate(x, y);
+  // Lags -1, 0 and 1: x0·conj(y1), x0·conj(y0) + x1·conj(y1), x1·conj(y0).
+  ASSERT_EQ(c[0], (std::complex<double>(1, 1)));
+  ASSERT_EQ(c[1], (std::complex<double>(1, -1) + std::complex<double>(2, 0)));
+  ASSERT_EQ(c[2], (std::complex<double>(0, -2)));
+
+  auto const v = firefly::convolve(firefly::vector<float, 3>{1, 2, 3}, firefly::vector<float, 2>{1, -1});
+  ASSERT_EQ(v, (firefly::vector<float, 4>{1, 1, 1, -3}));
+}
@@ -0,0 +1,98 @@
+#include <cmath>
+#include <complex>
+
+#include "firefly/functional.hpp"
+#include "firefly/vector.hpp"
+#include "gtest/gtest.h"
+
+TEST(functional, common_type_of__folds_promotion_rules) {
+  ASSERT_TRUE((std::is_same_v<firefly::common_type_of_t<int, float, double>, double>));
+  ASSERT_TRUE((std::is_same_v<firefly::common_type_of_t<int, std::complex<float>>, std::complex<float>>));
+  ASSERT_TRUE((std::is_same_v<firefly::common_type_of_t<short>, short>));
+}
+
+TEST(functional, map__unary_lambda) {
+  firefly::vector<int, 3> v1{1, -2, 3};
+  auto v2 = firefly::map([](int a) { return a * a; }, v1);
+
+  ASSERT_TRUE((std::is_same_v<decltype(v2), firefly::vector<int, 3>>));
+
+  ASSERT_EQ(v2[0], 1);
+  ASSERT_EQ(v2[1], 4);
+  ASSERT_EQ(v2[2], 9);
+}
+
+TEST(functional, map__primitive_ops) {
+  firefly::vector<double, 3> v1{-4, 9, -16};
+  auto v2 = firefly::map(firefly::ops::abs{}, v1);
+  auto v3 = firefly::map(firefly::ops::sqrt{}, v2);
+  auto v4 = firefly::map(firefly::ops::exp{}, firefly::vector<double, 1>{1});
+
+  ASSERT_DOUBLE_EQ(v2[0], 4);
+  ASSERT_DOUBLE_EQ(v2[1], 9);
+  ASSERT_DOUBLE_EQ(v2[2], 16);
+  ASSERT_DOUBLE_EQ(v3[0], 2);
+  ASSERT_DOUBLE_EQ(v3[1], 3);
+  ASSERT_DOUBLE_EQ(v3[2], 4);
+  ASSERT_DOUBLE_EQ(v4[0], std::exp(1.0));
+}
+
+TEST(functional, map__abs_of_complex_is_real) {
+  firefly::vector<std::complex<double>, 2> v1{{3, 4}, {0, -2}};
+  auto v2 = firefly::map(firefly::ops::abs{}, v1);
+
+  ASSERT_TRUE((std::is_same_v<decltype(v2), firefly::vector<double, 2>>));
+
+  ASSERT_DOUBLE_EQ(v2[0], 5);
+  ASSERT_DOUBLE_EQ(v2[1], 2);
+}
+
+TEST(functional, zip_with__promotes_like_operators) {
+  firefly::vector<int, 3> v1{1, 2, 3};
+  firefly::vector<float, 3> v2{0.5f, 0.5f, 2.0f};
+  auto v3 = firefly::zip_with(firefly::ops::multiplies{}, v1, v2);
+  auto v4 = firefly::zip_with(firefly::ops::min{}, v1, v2);
+
+  ASSERT_TRUE((std::is_same_v<decltype(v3), firefly::vector<float, 3>>));
+
+  ASSERT_FLOAT_EQ(v3[0], 0.5f);
+  ASSERT_FLOAT_EQ(v3[1], 1.0f);
+  ASSERT_FLOAT_EQ(v3[2], 6.0f);
+  ASSERT_FLOAT_EQ(v4[0], 0.5f);
+  ASSERT_FLOAT_EQ(v4[1], 0.5f);
+  ASSERT_FLOAT_EQ(v4[2], 2.0f);
+}
+
+TEST(functional, zip_with__fused_clamp_abs_product) {
+  firefly::vector<double, 4> a{1, -2, 3, -4};
+  firefly::vector<double, 4> b{0.5, 3, -0.1, 2};
+  auto kernel =
+      firefly::ops::compose(firefly::ops::clamp<double>{0, 5}, firefly::ops::abs{}, firefly::ops::multiplies{});
+  auto result = firefly::zip_with(kernel, a, b);
+
+  ASSERT_DOUBLE_EQ(result[0], 0.5);
+  ASSERT_DOUBLE_EQ(result[1], 5);
+  ASSERT_DOUBLE_EQ(result[2], 0.3);
+  ASSERT_DOUBLE_EQ(result[3], 5);
+}
+
+TEST(functional, zip_with__three_inputs) {
+  firefly::vector<int, 2> a{1, 2};
+  firefly::vector<int, 2> b{3, 4};
+  firefly::vector<double, 2> c{0.5, 0.25};
+  auto result = firefly::zip_with([](double x, double y, double z) { return x * y + z; }, a, b, c);
+
+  ASSERT_TRUE((std::is_same_v<decltype(result), firefly::vector<double, 2>>));
+
+  ASSERT_DOUBLE_EQ(result[0], 3.5);
+  ASSERT_DOUBLE_EQ(result[1], 8.25);
+}
+
+TEST(functional, map__constant_expression) {
+  constexpr firefly::vector<int, 3> v1{1, -2, 3};
+  constexpr auto v2 = firefly::map(firefly::ops::compose(firefly::ops::negate{}, firefly::ops::abs{}), v1);
+
+  ASSERT_EQ(v2[0], -1);
+  ASSERT_EQ(v2[1], -2);
+  ASSERT_EQ(v2[2], -3);
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "firefly/vector.hpp"
+#include "gtest/gtest.h"
+
+namespace firefly_tests {
+
+/**
+ * @brief Expects every element of `actual` to be within `tolerance` of the matching element of `expected`.
+ */
+template <typename T, std::size_t Length>
+void expect_near(firefly::vector<T, Length> const &actual, firefly::vector<T, Length> const &expected,
+                 double const tolerance = 1e-12) {
+  for (std::size_t i = 0; i < Length; ++i) {
+    EXPECT_NEAR(actual[i], expected[i], tolerance);
+  }
+}
+
+/**
+ * @brief Deterministic pseudo-random test vector with elements in `[-1, 1)`. Vectors with different indices are
+ * linearly independent in practice, and a different `seed` gives a different family.
+ */
+template <typename T, std::size_t Length>
+[[nodiscard]] firefly::vector<T, Length> sample_vector(std::size_t const index, double const seed = 12.9898) {
+  firefly::vector<T, Length> result;
+  for (std::size_t d = 0; d < Length; ++d) {
+    double const x = std::sin(double(index * Length + d + 1) * seed) * 43758.5453;
+    result[d] = T(2 * (x - std::floor(x)) - 1);
+  }
+  return result;
+}
+
+/**
+ * @brief The sample vectors `0` to `count - 1`.
+ */
+template <typename T, std::size_t Length>
+[[nodiscard]] std::vector<firefly::vector<T, Length>> sample_vectors(std::size_t const count,
+                                                                     double const seed = 12.9898) {
+  std::vector<firefly::vector<T, Length>> result(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    result[i] = sample_vector<T, Length>(i, seed);
+  }
+  return result;
+}
+
+} // namespace firefly_tests
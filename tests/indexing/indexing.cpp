@@ -0,0 +1,79 @@
+#include <array>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "firefly/indexing.hpp"
+#include "firefly/vector.hpp"
+#include "gtest/gtest.h"
+
+TEST(indexing, gather__selects_features) {
+  std::vector<float> buffer{10, 11, 12, 13, 14, 15};
+  firefly::vector<std::size_t, 3> indices{5, 0, 3};
+  auto v1 = firefly::gather(buffer, indices);
+
+  ASSERT_TRUE((std::is_same_v<decltype(v1), firefly::vector<float, 3>>));
+
+  ASSERT_FLOAT_EQ(v1[0], 15);
+  ASSERT_FLOAT_EQ(v1[1], 10);
+  ASSERT_FLOAT_EQ(v1[2], 13);
+}
+
+TEST(indexing, gather__prefetching_path_matches) {
+  std::vector<double> buffer(4096);
+  std::iota(buffer.begin(), buffer.end(), 0.0);
+  firefly::vector<std::int32_t, 1024> indices;
+  for (std::size_t i = 0; i < indices.size(); ++i) {
+    indices[i] = static_cast<std::int32_t>((i * 37) % buffer.size());
+  }
+  auto v1 = firefly::gather(buffer, indices);
+
+  for (std::size_t i = 0; i < indices.size(); ++i) {
+    ASSERT_DOUBLE_EQ(v1[i], double((i * 37) % buffer.size()));
+  }
+}
+
+TEST(indexing, gather__out_of_range_throws) {
+  std::array<int, 3> buffer{1, 2, 3};
+
+  ASSERT_THROW(({ (void)firefly::gather(buffer, firefly::vector<int, 2>{0, 3}); }), std::out_of_range);
+  ASSERT_THROW(({ (void)firefly::gather(buffer, firefly::vector<int, 2>{-1, 0}); }), std::out_of_range);
+}
+
+TEST(indexing, scatter__writes_and_converts) {
+  std::vector<double> buffer(5, 0.0);
+  firefly::vector<int, 3> v1{7, 8, 9};
+  firefly::scatter(v1, firefly::vector<std::size_t, 3>{4, 1, 4}, buffer);
+
+  ASSERT_DOUBLE_EQ(buffer[0], 0);
+  ASSERT_DOUBLE_EQ(buffer[1], 8);
+  ASSERT_DOUBLE_EQ(buffer[4], 9);
+}
+
+TEST(indexing, scatter_add__accumulates_repeated_indices) {
+  std::vector<int> buffer(3, 1);
+  firefly::scatter_add(firefly::vector<int, 4>{1, 2, 3, 4}, firefly::vector<std::size_t, 4>{0, 2, 0, 0}, buffer);
+
+  ASSERT_EQ(buffer[0], 9);
+  ASSERT_EQ(buffer[1], 1);
+  ASSERT_EQ(buffer[2], 3);
+}
+
+TEST(indexing, permute__and_inverse_round_trip) {
+  firefly::vector<double, 4> v1{1, 2, 3, 4};
+  firefly::vector<std::size_t, 4> permutation{2, 0, 3, 1};
+  auto v2 = firefly::permute(v1, permutation);
+  auto v3 = firefly::permute(v2, firefly::inverse_permutation(permutation));
+
+  ASSERT_TRUE((v2 == firefly::vector<double, 4>{3, 1, 4, 2}));
+  ASSERT_TRUE(v3 == v1);
+  ASSERT_THROW(({ (void)firefly::inverse_permutation(firefly::vector<int, 3>{0, 0, 1}); }), std::invalid_argument);
+}
+
+TEST(indexing, permute__constant_expression) {
+  constexpr auto v1 = firefly::permute(firefly::vector<int, 3>{1, 2, 3}, firefly::vector<int, 3>{2, 1, 0});
+
+  static_assert(v1[0] == 3 && v1[1] == 2 && v1[2] == 1);
+  ASSERT_EQ(v1[0], 3);
+}
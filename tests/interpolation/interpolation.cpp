@@ -0,0 +1,105 @@
+#include <cmath>
+#include <numbers>
+#include <stdexcept>
+#include <vector>
+
+#include "firefly/interpolation.hpp"
+#include "firefly/utilities.hpp"
+#include "firefly/vector.hpp"
+#include "gtest/gtest.h"
+#include "helpers.hpp"
+
+using vec3 = firefly::vector<double, 3>;
+
+TEST(interpolation, lerp__shared_and_per_element) {
+  std::vector<vec3> as{vec3{0, 0, 0}, vec3{1, 2, 3}, vec3{-4, 0, 4}};
+  std::vector<vec3> bs{vec3{2, 4, 6}, vec3{1, 2, 3}, vec3{4, 0, -4}};
+  std::vector<vec3> out(as.size());
+
+  firefly::lerp(as, bs, 0.25, out);
+  for (std::size_t i = 0; i < as.size(); ++i) {
+    firefly_tests::expect_near(out[i], firefly::utilities::vector::lerp(as[i], bs[i], 0.25));
+  }
+
+  std::vector<double> ts{0.0, 0.5, 1.0};
+  firefly::lerp(as, bs, ts, as, 2);
+  firefly_tests::expect_near(as[0], vec3{0, 0, 0});
+  firefly_tests::expect_near(as[1], vec3{1, 2, 3});
+  firefly_tests::expect_near(as[2], vec3{4, 0, -4});
+
+  std::vector<double> short_ts(1);
+  ASSERT_THROW(firefly::lerp(as, bs, short_ts, out), std::invalid_argument);
+  std::vector<vec3> short_out(1);
+  ASSERT_THROW(firefly::lerp(as, bs, 0.5, short_out), std::invalid_argument);
+}
+
+TEST(interpolation, nlerp__normalises) {
+  std::vector<vec3> as{vec3{1, 0, 0}, vec3{1, 0, 0}};
+  std::vector<vec3> bs{vec3{0, 1, 0}, vec3{-1, 0, 0}};
+  std::vector<vec3> out(as.size());
+
+  firefly::nlerp(as, bs, 0.5, out);
+  firefly_tests::expect_near(out[0], vec3{std::numbers::sqrt2 / 2, std::numbers::sqrt2 / 2, 0});
+  firefly_tests::expect_near(out[1], vec3{0, 0, 0});
+}
+
+TEST(interpolation, slerp__constant_angular_velocity) {
+  std::vector<vec3> as(1000);
+  std::vector<vec3> bs(as.size());
+  std::vector<double> ts(as.size());
+  for (std::size_t i = 0; i < as.size(); ++i) {
+    double const angle = double(i) * 0.01;
+    as[i] = vec3{std::cos(angle), std::sin(angle), 0.0};
+    bs[i] = vec3{std::cos(angle + 1.2), std::sin(angle + 1.2), 0.0};
+    ts[i] = double(i % 11) / 10.0;
+  }
+  std::vector<vec3> shared(as.size());
+  std::vector<vec3> each(as.size());
+
+  firefly::slerp(as, bs, 0.25, shared, 3);
+  firefly::slerp(as, bs, ts, each, 3);
+  for (std::size_t i = 0; i < as.size(); ++i) {
+    double const angle = double(i) * 0.01;
+    firefly_tests::expect_near(shared[i], vec3{std::cos(angle + 0.3), std::sin(angle + 0.3), 0});
+    firefly_tests::expect_near(each[i], vec3{std::cos(angle + 1.2 * ts[i]), std::sin(angle + 1.2 * ts[i]), 0});
+  }
+
+  std::vector<vec3> same{vec3{0, 0, 1}};
+  std::vector<vec3> out(1);
+  firefly::slerp(same, same, 0.7, out);
+  firefly_tests::expect_near(out[0], vec3{0, 0, 1});
+}
+
+TEST(keyframe_track, sample__interpolates_and_clamps) {
+  firefly::keyframe_track<double, 3> track({0.0, 1.0, 3.0}, {vec3{0, 0, 0}, vec3{2, 0, 0}, vec3{2, 4, 0}});
+
+  ASSERT_EQ(track.size(), 3);
+  firefly_tests::expect_near(track.sample(-1.0), vec3{0, 0, 0});
+  firefly_tests::expect_near(track.sample(0.5), vec3{1, 0, 0});
+  firefly_tests::expect_near(track.sample(1.0), vec3{2, 0, 0});
+  firefly_tests::expect_near(track.sample(2.5), vec3{2, 3, 0});
+  firefly_tests::expect_near(track.sample(10.0), vec3{2, 4, 0});
+
+  firefly::keyframe_track<double, 3> single({2.0}, {vec3{1, 2, 3}});
+  firefly_tests::expect_near(single.sample(0.0), vec3{1, 2, 3});
+
+  ASSERT_THROW((firefly::keyframe_track<double, 3>({0.0, 0.0}, {vec3{}, vec3{}})), std::invalid_argument);
+  ASSERT_THROW((firefly::keyframe_track<double, 3>({0.0}, {})), std::invalid_argument);
+}
+
+TEST(keyframe_track, sample__stream_matches_single_samples) {
+  std::vector<double> times;
+  std::vector<vec3> values;
+  for (int i = 0; i < 20; ++i) {
+    times.push_back(i * i * 0.1);
+    values.push_back(vec3{double(i), std::sin(double(i)), -double(i)});
+  }
+  firefly::keyframe_track<double, 3> track(times, values);
+  std::vector<vec3> out(500);
+
+  track.sample(-1.0, 0.1, out);
+  for (std::size_t i = 0; i < out.size(); ++i) {
+    firefly_tests::expect_near(out[i], track.sample(-1.0 + double(i) * 0.1));
+  }
+  ASSERT_THROW(track.sample(0.0, -1.0, out), std::invalid_argument);
+}
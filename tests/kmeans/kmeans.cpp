@@ -0,0 +1,123 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+#include "firefly/kmeans.hpp"
+#include "firefly/vector.hpp"
+#include "gtest/gtest.h"
+#include "helpers.hpp"
+
+using point = firefly::vector<double, 8>;
+
+TEST(kmeans, fit__recovers_separated_blobs) {
+  // Four well separated blobs of 250 points each; point i belongs to blob i % 4.
+  auto centers = firefly_tests::sample_vectors<double, 8>(4);
+  for (auto &center : centers) {
+    center *= 20.0;
+  }
+  std::vector<point> points(1000);
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    points[i] = centers[i % 4] + 1.5 * firefly_tests::sample_vector<double, 8>(i, 78.233);
+  }
+  firefly::kmeans<double, 8> model(4, 42);
+  model.fit(points);
+
+  auto const labels = model.labels();
+  ASSERT_EQ(labels.size(), points.size());
+  std::set<std::size_t> distinct;
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    ASSERT_EQ(labels[i], labels[i % 4]);
+    distinct.insert(labels[i]);
+  }
+  ASSERT_EQ(distinct.size(), 4);
+  for (std::size_t c = 0; c < 4; ++c) {
+    auto const &centroid = model.centroids()[labels[c]];
+    for (std::size_t d = 0; d < 8; ++d) {
+      ASSERT_NEAR(centroid[d], centers[c][d], 0.5);
+    }
+  }
+  ASSERT_GT(model.iterations(), 0);
+  ASSERT_GT(model.inertia(), 0.0);
+}
+
+TEST(kmeans, fit__pruning_and_threads_do_not_change_result) {
+  // Points spread evenly through a cube have no clear clusters, so Lloyd needs many passes.
+  auto const points = firefly_tests::sample_vectors<double, 8>(2000);
+
+  firefly::kmeans<double, 8> plain(6, 7);
+  plain.fit(points, 100, 1, false);
+  firefly::kmeans<double, 8> pruned(6, 7);
+  pruned.fit(points, 100, 1, true);
+  firefly::kmeans<double, 8> threaded(6, 7);
+  threaded.fit(points, 100, 4, true);
+
+  ASSERT_TRUE(std::equal(plain.labels().begin(), plain.labels().end(), pruned.labels().begin()));
+  ASSERT_TRUE(std::equal(plain.labels().begin(), plain.labels().end(), threaded.labels().begin()));
+  ASSERT_EQ(plain.iterations(), pruned.iterations());
+  for (std::size_t c = 0; c < 6; ++c) {
+    for (std::size_t d = 0; d < 8; ++d) {
+      ASSERT_NEAR(plain.centroids()[c][d], pruned.centroids()[c][d], 1e-9);
+      ASSERT_NEAR(plain.centroids()[c][d], threaded.centroids()[c][d], 1e-9);
+    }
+  }
+  ASSERT_NEAR(plain.inertia(), threaded.inertia(), 1e-6 * plain.inertia());
+
+  std::vector<std::size_t> predicted(points.size());
+  pruned.predict(points, predicted, 2);
+  ASSERT_TRUE(std::equal(predicted.begin(), predicted.end(), pruned.labels().begin()));
+}
+
+TEST(kmeans, partial_fit__mini_batches_approach_blob_centers) {
+  // Four well separated blobs of 250 points each; point i belongs to blob i % 4.
+  auto centers = firefly_tests::sample_vectors<double, 8>(4);
+  for (auto &center : centers) {
+    center *= 20.0;
+  }
+  std::vector<point> points(1000);
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    points[i] = centers[i % 4] + 1.5 * firefly_tests::sample_vector<double, 8>(i, 78.233);
+  }
+  firefly::kmeans<double, 8> model(4, 3);
+  for (std::size_t first = 0; first < points.size(); first += 100) {
+    model.partial_fit(std::vector<point>(points.begin() + first, points.begin() + first + 100), 2);
+  }
+
+  std::vector<std::size_t> labels(4);
+  model.predict(centers, labels);
+  ASSERT_EQ(std::set<std::size_t>(labels.begin(), labels.end()).size(), 4);
+  for (std::size_t c = 0; c < 4; ++c) {
+    for (std::size_t d = 0; d < 8; ++d) {
+      ASSERT_NEAR(model.centroids()[labels[c]][d], centers[c][d], 1.0);
+    }
+  }
+}
+
+TEST(kmeans, fit__seeding_uses_engine_bits) {
+  // The first centroid is the output of std::mt19937_64 reduced modulo the number of points, which the standard
+  // fixes, so the seeding is the same with every standard library.
+  std::vector<firefly::vector<double, 2>> points(1000);
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    points[i] = firefly::vector<double, 2>{double(i), 0};
+  }
+  for (std::uint64_t const seed : {0u, 7u, 123u}) {
+    firefly::kmeans<double, 2> model(3, seed);
+    model.fit(points, 0);
+    std::mt19937_64 engine(seed);
+    ASSERT_EQ(model.centroids()[0], points[engine() % points.size()]);
+  }
+}
+
+TEST(kmeans, invalid_use__throws) {
+  ASSERT_THROW((firefly::kmeans<float, 2>(0)), std::invalid_argument);
+
+  firefly::kmeans<float, 2> model(3);
+  std::vector<firefly::vector<float, 2>> points{{0, 0}, {1, 1}};
+  std::vector<std::size_t> labels(2);
+  ASSERT_THROW(model.predict(points, labels), std::logic_error);
+  ASSERT_THROW(model.fit(points), std::invalid_argument);
+  ASSERT_THROW(model.partial_fit(points), std::invalid_argument);
+}
@@ -0,0 +1,99 @@
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "firefly/linalg.hpp"
+#include "firefly/vector.hpp"
+#include "gtest/gtest.h"
+#include "helpers.hpp"
+
+namespace {
+
+template <typename T, std::size_t Length>
+void expect_qr(std::vector<firefly::vector<T, Length>> const &a, std::vector<firefly::vector<T, Length>> const &q,
+               std::vector<T> const &r, double tolerance) {
+  std::size_t const k = a.size();
+  for (std::size_t i = 0; i < k; ++i) {
+    for (std::size_t j = 0; j < k; ++j) {
+      ASSERT_NEAR(q[i].dot(q[j]), i == j ? 1.0 : 0.0, tolerance);
+      if (i > j) {
+        ASSERT_EQ(r[i * k + j], T(0));
+      }
+    }
+    ASSERT_GT(r[i * k + i], T(0));
+  }
+  for (std::size_t j = 0; j < k; ++j) {
+    for (std::size_t d = 0; d < Length; ++d) {
+      double sum = 0;
+      for (std::size_t i = 0; i <= j; ++i) {
+        sum += double(q[i][d]) * double(r[i * k + j]);
+      }
+      ASSERT_NEAR(sum, a[j][d], tolerance * 10);
+    }
+  }
+}
+
+} // namespace
+
+TEST(linalg, qr__small_basis) {
+  std::vector<firefly::vector<double, 3>> a{{3, 0, 4}, {1, 2, 0}};
+  auto const [q, r] = firefly::qr(a);
+
+  ASSERT_DOUBLE_EQ(q[0][0], 0.6);
+  ASSERT_EQ(q[0][1], 0.0);
+  ASSERT_DOUBLE_EQ(q[0][2], 0.8);
+  ASSERT_DOUBLE_EQ(r[0], 5.0);
+  ASSERT_DOUBLE_EQ(r[1], 0.6);
+  ASSERT_EQ(r[2], 0.0);
+  expect_qr(a, q, r, 1e-14);
+}
+
+TEST(linalg, qr__variants_reconstruct_input) {
+  auto const a = firefly_tests::sample_vectors<double, 64>(40);
+  for (auto const method : {firefly::gram_schmidt::modified, firefly::gram_schmidt::blocked}) {
+    for (bool const reorthogonalize : {false, true}) {
+      auto const [q, r] = firefly::qr(a, method, reorthogonalize, 3);
+      expect_qr(a, q, r, 1e-12);
+    }
+  }
+}
+
+TEST(linalg, orthonormalize__threads_match_single_thread) {
+  auto single = firefly_tests::sample_vectors<float, 48>(35);
+  auto threaded = single;
+  auto const r_single = firefly::orthonormalize(single);
+  auto const r_threaded = firefly::orthonormalize(threaded, firefly::gram_schmidt::blocked, true, 4);
+
+  ASSERT_EQ(single, threaded);
+  ASSERT_EQ(r_single, r_threaded);
+  expect_qr(firefly_tests::sample_vectors<float, 48>(35), single, r_single, 1e-5);
+}
+
+TEST(linalg, orthonormalize__reorthogonalization_on_ill_conditioned_input) {
+  // Nearly parallel vectors make classical projections lose orthogonality.
+  std::vector<firefly::vector<double, 20>> a(20);
+  for (std::size_t j = 0; j < a.size(); ++j) {
+    for (std::size_t d = 0; d < 20; ++d) {
+      a[j][d] = 1.0 + (d == j ? 1e-6 : 0.0) + 1e-9 * std::sin(double(j * 20 + d));
+    }
+  }
+  auto q = a;
+  (void)firefly::orthonormalize(q, firefly::gram_schmidt::blocked, true);
+  for (std::size_t i = 0; i < q.size(); ++i) {
+    for (std::size_t j = 0; j < i; ++j) {
+      ASSERT_NEAR(q[i].dot(q[j]), 0.0, 1e-12);
+    }
+  }
+}
+
+TEST(linalg, orthonormalize__invalid_input_throws) {
+  std::vector<firefly::vector<double, 3>> dependent{{1, 2, 3}, {2, 4, 6}};
+  ASSERT_THROW((void)firefly::orthonormalize(dependent), std::logic_error);
+
+  std::vector<firefly::vector<double, 3>> zero{{0, 0, 0}};
+  ASSERT_THROW((void)firefly::orthonormalize(zero, firefly::gram_schmidt::modified), std::logic_error);
+
+  std::vector<firefly::vector<double, 2>> too_many{{1, 0}, {0, 1}, {1, 1}};
+  ASSERT_THROW((void)firefly::orthonormalize(too_many), std::invalid_argument);
+}
@@ -0,0 +1,148 @@
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <stdexcept>
+#include <vector>
+
+#include "firefly/math.hpp"
+#include "gtest/gtest.h"
+
+TEST(math, sqrt__constant_evaluation) {
+  constexpr auto root = firefly::math::sqrt(2.0);
+  constexpr auto root_int = firefly::math::sqrt(16);
+
+  ASSERT_TRUE((std::is_same_v<decltype(root_int), double const>));
+
+  ASSERT_DOUBLE_EQ(root, std::sqrt(2.0));
+  ASSERT_DOUBLE_EQ(root_int, 4);
+  ASSERT_DOUBLE_EQ(firefly::math::sqrt(1e-300), std::sqrt(1e-300));
+  ASSERT_DOUBLE_EQ(firefly::math::sqrt(1e300), std::sqrt(1e300));
+}
+
+TEST(math, sqrt__negative_is_nan) {
+  constexpr auto root = firefly::math::sqrt(-1.0);
+
+  ASSERT_TRUE(std::isnan(root));
+}
+
+TEST(math, sin_cos__match_runtime_path) {
+  static constexpr double angles[] = {0.0, 0.1, -0.5, 1.0, 2.5, -3.0, 10.0, 100.0};
+  constexpr auto sin_values = [] {
+    std::array<double, std::size(angles)> result{};
+    for (std::size_t i = 0; i < result.size(); ++i) {
+      result[i] = firefly::math::sin(angles[i]);
+    }
+    return result;
+  }();
+  constexpr auto cos_values = [] {
+    std::array<double, std::size(angles)> result{};
+    for (std::size_t i = 0; i < result.size(); ++i) {
+      result[i] = firefly::math::cos(angles[i]);
+    }
+    return result;
+  }();
+
+  for (std::size_t i = 0; i < std::size(angles); ++i) {
+    ASSERT_NEAR(sin_values[i], std::sin(angles[i]), 1e-15);
+    ASSERT_NEAR(cos_values[i], std::cos(angles[i]), 1e-15);
+  }
+}
+
+TEST(math, sin_cos__huge_arguments_are_constant_expressions) {
+  // The quadrant of these arguments does not fit in an int64, which must not make constant evaluation fail.
+  constexpr double huge_sin = firefly::math::sin(1e30);
+  constexpr double huge_cos = firefly::math::cos(-1e300);
+  ASSERT_LE(std::abs(huge_sin), 1.0);
+  ASSERT_LE(std::abs(huge_cos), 1.0);
+}
+
+TEST(math, inverse_trigonometry__match_runtime_path) {
+  static constexpr double values[] = {-1.0, -0.9, -0.5, 0.0, 0.2679, 0.5, 0.99, 1.0};
+  constexpr auto acos_values = [] {
+    std::array<double, std::size(values)> result{};
+    for (std::size_t i = 0; i < result.size(); ++i) {
+      result[i] = firefly::math::acos(values[i]);
+    }
+    return result;
+  }();
+  constexpr auto asin_values = [] {
+    std::array<double, std::size(values)> result{};
+    for (std::size_t i = 0; i < result.size(); ++i) {
+      result[i] = firefly::math::asin(values[i]);
+    }
+    return result;
+  }();
+
+  for (std::size_t i = 0; i < std::size(values); ++i) {
+    ASSERT_NEAR(acos_values[i], std::acos(values[i]), 1e-15);
+    ASSERT_NEAR(asin_values[i], std::asin(values[i]), 1e-15);
+  }
+  ASSERT_NEAR(firefly::math::atan(5.0), std::atan(5.0), 1e-15);
+  ASSERT_TRUE(std::isnan(firefly::math::acos(1.5)));
+}
+
+TEST(math, runtime_path_forwards_to_cmath) {
+  volatile double x = 0.75;
+
+  ASSERT_EQ(firefly::math::sqrt(x), std::sqrt(x));
+  ASSERT_EQ(firefly::math::sin(x), std::sin(x));
+  ASSERT_EQ(firefly::math::acos(x), std::acos(x));
+}
+
+TEST(math, sincos__matches_runtime_path) {
+  constexpr auto pair = firefly::math::sincos(1.0);
+  static_assert(pair.first > 0.84 && pair.first < 0.85);
+
+  for (double x = -200.0; x <= 200.0; x += 0.37) {
+    auto const [s, c] = firefly::math::sincos(x);
+    ASSERT_NEAR(s, std::sin(x), 4e-16 * (1 + std::abs(x)));
+    ASSERT_NEAR(c, std::cos(x), 4e-16 * (1 + std::abs(x)));
+
+    auto const [sf, cf] = firefly::math::sincos(float(x));
+    ASSERT_NEAR(sf, std::sin(float(x)), 2e-7f * (1 + std::abs(float(x))));
+    ASSERT_NEAR(cf, std::cos(float(x)), 2e-7f * (1 + std::abs(float(x))));
+  }
+  ASSERT_TRUE(std::isnan(firefly::math::sincos(std::numeric_limits<double>::infinity()).first));
+  ASSERT_TRUE(std::isnan(firefly::math::sincos(std::numeric_limits<float>::quiet_NaN()).second));
+}
+
+TEST(math, sincos__batch) {
+  std::vector<float> angles(1000);
+  for (std::size_t i = 0; i < angles.size(); ++i) {
+    angles[i] = float(i) * 0.01f - 5.0f;
+  }
+  std::vector<float> sines(angles.size());
+  std::vector<float> cosines(angles.size());
+
+  firefly::math::sincos(angles, sines, cosines);
+  for (std::size_t i = 0; i < angles.size(); ++i) {
+    ASSERT_NEAR(sines[i], std::sin(angles[i]), 1e-6f);
+    ASSERT_NEAR(cosines[i], std::cos(angles[i]), 1e-6f);
+  }
+
+  std::vector<float> small(1);
+  ASSERT_THROW(firefly::math::sincos(angles, small, cosines), std::invalid_argument);
+}
+
+TEST(math, acos__batch) {
+  std::vector<double> values;
+  for (double x = -1.0; x <= 1.0; x += 0.001) {
+    values.push_back(x);
+  }
+  values.push_back(1.0);
+  std::vector<double> angles(values.size());
+
+  firefly::math::acos(values, angles);
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    ASSERT_NEAR(angles[i], std::acos(values[i]), 1e-15);
+  }
+
+  std::vector<float> floats(values.begin(), values.end());
+  firefly::math::acos(floats, floats);
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    ASSERT_NEAR(floats[i], std::acos(float(values[i])), 1e-6f);
+  }
+
+  std::vector<double> small(1);
+  ASSERT_THROW(firefly::math::acos(values, small), std::invalid_argument);
+}
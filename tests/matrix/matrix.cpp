@@ -0,0 +1,116 @@
+#include <complex>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "firefly/matrix.hpp"
+#include "firefly/vector.hpp"
+#include "gtest/gtest.h"
+
+TEST(matrix, constructor__row_by_row) {
+  firefly::matrix<int, 2, 3> m1{{1, 2, 3}, {4, 5}};
+  firefly::matrix<int, 2, 3, firefly::layout::column_major> m2{{1, 2, 3}, {4, 5}};
+
+  ASSERT_EQ(m1(1, 1), 5);
+  ASSERT_EQ(m1(1, 2), 0);
+  ASSERT_EQ(m1.data()[1], 2);
+  ASSERT_EQ(m2.data()[1], 4);
+  ASSERT_EQ(m1, m2);
+  ASSERT_EQ(m1.view(), "[[1, 2, 3], [4, 5, 0]]");
+  ASSERT_EQ(m1.row(0), (firefly::vector<int, 3>{1, 2, 3}));
+  ASSERT_EQ(m2.col(1), (firefly::vector<int, 2>{2, 5}));
+  ASSERT_THROW((firefly::matrix<int, 1, 2>{{1, 2, 3}}), std::out_of_range);
+  ASSERT_THROW((firefly::matrix<int, 1, 2>{{1}, {2}}), std::out_of_range);
+  ASSERT_THROW(({ (void)m1.at(2, 0); }), std::out_of_range);
+}
+
+TEST(matrix, identity__and_transpose) {
+  constexpr auto m1 = firefly::matrix<int, 3, 3>::identity();
+  static_assert(m1(1, 1) == 1 && m1(0, 1) == 0);
+
+  firefly::matrix<int, 2, 3> m2{{1, 2, 3}, {4, 5, 6}};
+  ASSERT_EQ(m2.transpose(), (firefly::matrix<int, 3, 2>{{1, 4}, {2, 5}, {3, 6}}));
+  ASSERT_EQ(m2.transpose().transpose(), m2);
+}
+
+TEST(matrix, arithmetic__promotes) {
+  firefly::matrix<int, 2, 2> m1{{1, 2}, {3, 4}};
+  firefly::matrix<double, 2, 2> m2{{0.5, 0.5}, {0.5, 0.5}};
+
+  auto m3 = m1 + m2;
+  static_assert(std::is_same_v<decltype(m3)::value_type, double>);
+  ASSERT_EQ(m3, (firefly::matrix<double, 2, 2>{{1.5, 2.5}, {3.5, 4.5}}));
+  ASSERT_EQ(m1 - m1, (firefly::matrix<int, 2, 2>{}));
+  ASSERT_EQ(2 * m1, (firefly::matrix<int, 2, 2>{{2, 4}, {6, 8}}));
+}
+
+TEST(matrix, vector_product__both_layouts) {
+  firefly::matrix<int, 2, 3> m1{{1, 2, 3}, {4, 5, 6}};
+  auto m2 = m1.as_layout<firefly::layout::column_major>();
+  firefly::vector<float, 3> v1{1, 0.5f, -1};
+
+  auto v2 = m1 * v1;
+  static_assert(std::is_same_v<decltype(v2), firefly::vector<float, 2>>);
+  ASSERT_EQ(v2, (firefly::vector<float, 2>{-1, 0.5f}));
+  ASSERT_EQ(m2 * v1, v2);
+
+  constexpr firefly::matrix<int, 2, 2> m3{{0, -1}, {1, 0}};
+  static_assert(m3 * firefly::vector<int, 2>{1, 0} == firefly::vector<int, 2>{0, 1});
+}
+
+TEST(matrix, matrix_product__small) {
+  firefly::matrix<int, 2, 3> m1{{1, 2, 3}, {4, 5, 6}};
+  firefly::matrix<int, 3, 2, firefly::layout::column_major> m2{{7, 8}, {9, 10}, {11, 12}};
+
+  ASSERT_EQ(m1 * m2, (firefly::matrix<int, 2, 2>{{58, 64}, {139, 154}}));
+  ASSERT_EQ((m1 * firefly::matrix<int, 3, 3>::identity()), m1);
+
+  firefly::matrix<std::complex<double>, 1, 1> m3{{{0, 1}}};
+  ASSERT_EQ((m3 * m3)(0, 0), std::complex<double>(-1, 0));
+}
+
+TEST(matrix, matrix_product__blocked_matches_naive) {
+  using lhs = firefly::matrix<double, 70, 65>;
+  using rhs = firefly::matrix<double, 65, 67, firefly::layout::column_major>;
+  lhs a;
+  for (std::size_t r = 0; r < lhs::rows; ++r) {
+    for (std::size_t c = 0; c < lhs::cols; ++c) {
+      a(r, c) = double(int((r * 7 + c * 3 + 1) % 11) - 5);
+    }
+  }
+  rhs b;
+  for (std::size_t r = 0; r < rhs::rows; ++r) {
+    for (std::size_t c = 0; c < rhs::cols; ++c) {
+      b(r, c) = double(int((r * 7 + c * 3 + 4) % 11) - 5);
+    }
+  }
+
+  // Small integer entries keep every product exact, so the blocked and naive sums must agree exactly.
+  auto const c = a * b;
+  for (std::size_t i = 0; i < lhs::rows; ++i) {
+    for (std::size_t j = 0; j < rhs::cols; ++j) {
+      double expected = 0;
+      for (std::size_t k = 0; k < lhs::cols; ++k) {
+        expected += a(i, k) * b(k, j);
+      }
+      ASSERT_EQ(c(i, j), expected);
+    }
+  }
+}
+
+TEST(matrix, transform__applies_to_batch) {
+  firefly::matrix<float, 2, 3> m1{{1, 0, 1}, {0, 2, 0}};
+  std::vector<firefly::vector<float, 3>> in(1000);
+  for (std::size_t i = 0; i < in.size(); ++i) {
+    in[i] = firefly::vector<float, 3>{float(i), 1.0f, -float(i)};
+  }
+  std::vector<firefly::vector<float, 2>> out(in.size());
+
+  firefly::transform(m1, in, out, 4);
+  for (std::size_t i = 0; i < in.size(); ++i) {
+    ASSERT_EQ(out[i], m1 * in[i]);
+  }
+
+  std::vector<firefly::vector<float, 2>> small(1);
+  ASSERT_THROW(firefly::transform(m1, in, small), std::invalid_argument);
+}
@@ -0,0 +1,129 @@
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "firefly/mesh.hpp"
+#include "firefly/utilities.hpp"
+#include "firefly/vector.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+// A unit cube with outward-facing faces, two triangles per side.
+std::vector<firefly::vector<double, 3>> const cube_vertices{{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0},
+                                                            {0, 0, 1}, {1, 0, 1}, {1, 1, 1}, {0, 1, 1}};
+std::vector<std::uint32_t> const cube_indices{0, 2, 1, 0, 3, 2, 4, 5, 6, 4, 6, 7, 0, 1, 5, 0, 5, 4,
+                                              3, 7, 6, 3, 6, 2, 0, 4, 7, 0, 7, 3, 1, 2, 6, 1, 6, 5};
+
+// A wavy grid of (n + 1) × (n + 1) vertices, large enough to span several chunks and threads.
+void make_grid(std::size_t n, std::vector<firefly::vector<float, 3>> &vertices, std::vector<std::uint32_t> &indices) {
+  for (std::size_t y = 0; y <= n; ++y) {
+    for (std::size_t x = 0; x <= n; ++x) {
+      vertices.push_back({float(x), float(y), std::sin(float(x) * 0.3f) * std::cos(float(y) * 0.2f)});
+    }
+  }
+  for (std::uint32_t y = 0; y < n; ++y) {
+    for (std::uint32_t x = 0; x < n; ++x) {
+      std::uint32_t const v = y * std::uint32_t(n + 1) + x;
+      indices.insert(indices.end(), {v, v + 1, v + std::uint32_t(n) + 2, v, v + std::uint32_t(n) + 2,
+                                     v + std::uint32_t(n) + 1});
+    }
+  }
+}
+
+} // namespace
+
+TEST(mesh, face_normals__cube_faces_point_outwards) {
+  std::vector<firefly::vector<double, 3>> normals(12);
+  std::vector<double> areas(12);
+  firefly::face_normals(cube_vertices, cube_indices, normals, areas);
+
+  ASSERT_EQ(normals[0], (firefly::vector<double, 3>{0, 0, -1}));
+  ASSERT_EQ(normals[2], (firefly::vector<double, 3>{0, 0, 1}));
+  ASSERT_EQ(normals[4], (firefly::vector<double, 3>{0, -1, 0}));
+  ASSERT_EQ(normals[7], (firefly::vector<double, 3>{0, 1, 0}));
+  ASSERT_EQ(normals[8], (firefly::vector<double, 3>{-1, 0, 0}));
+  ASSERT_EQ(normals[11], (firefly::vector<double, 3>{1, 0, 0}));
+  for (double const area : areas) {
+    ASSERT_DOUBLE_EQ(area, 0.5);
+  }
+  ASSERT_DOUBLE_EQ(firefly::surface_area(cube_vertices, cube_indices), 6.0);
+}
+
+TEST(mesh, face_normals__degenerate_face_is_zero) {
+  std::vector<firefly::vector<double, 3>> vertices{{0, 0, 0}, {1, 1, 1}, {2, 2, 2}};
+  std::vector<std::uint16_t> indices{0, 1, 2};
+  std::vector<firefly::vector<double, 3>> normals(1);
+  firefly::face_normals(vertices, indices, normals);
+
+  ASSERT_EQ(normals[0], (firefly::vector<double, 3>{0, 0, 0}));
+}
+
+TEST(mesh, face_areas__match_area_triangle) {
+  std::vector<firefly::vector<float, 3>> vertices;
+  std::vector<std::uint32_t> indices;
+  make_grid(40, vertices, indices);
+  std::size_t const faces = indices.size() / 3;
+
+  std::vector<float> areas(faces);
+  firefly::face_areas(vertices, indices, areas, 4);
+  float expected_total = 0;
+  for (std::size_t f = 0; f < faces; ++f) {
+    auto const &a = vertices[indices[3 * f]];
+    auto const expected = firefly::utilities::vector::area_triangle(vertices[indices[3 * f + 1]] - a,
+                                                                    vertices[indices[3 * f + 2]] - a);
+    ASSERT_NEAR(areas[f], expected, 1e-5f);
+    expected_total += areas[f];
+  }
+  ASSERT_NEAR(firefly::surface_area(vertices, indices, 3), expected_total, 1e-2f);
+}
+
+TEST(mesh, vertex_normals__area_weighted) {
+  std::vector<firefly::vector<double, 3>> normals(cube_vertices.size());
+  firefly::vertex_normals(cube_vertices, cube_indices, normals);
+
+  // Corner 5 touches both faces of the -y side and one face of each of the +x and +z sides, all of area 0.5.
+  double const s = 1 / std::sqrt(6.0);
+  ASSERT_NEAR(normals[5][0], s, 1e-12);
+  ASSERT_NEAR(normals[5][1], -2 * s, 1e-12);
+  ASSERT_NEAR(normals[5][2], s, 1e-12);
+  ASSERT_NEAR(normals[6][0], 1 / std::sqrt(3.0), 1e-12);
+
+  std::vector<firefly::vector<float, 3>> vertices;
+  std::vector<std::uint32_t> indices;
+  make_grid(40, vertices, indices);
+  std::vector<firefly::vector<float, 3>> single(vertices.size());
+  std::vector<firefly::vector<float, 3>> threaded(vertices.size());
+  firefly::vertex_normals(vertices, indices, single);
+  firefly::vertex_normals(vertices, indices, threaded, 4);
+  ASSERT_EQ(single, threaded);
+  for (auto const &n : single) {
+    ASSERT_NEAR(n.norm(), 1.0, 1e-5);
+    ASSERT_GT(n[2], 0.0f);
+  }
+}
+
+TEST(mesh, face_centroids__mean_of_corners) {
+  std::vector<firefly::vector<double, 3>> centroids(12);
+  firefly::face_centroids(cube_vertices, cube_indices, centroids, 2);
+
+  ASSERT_NEAR(centroids[0][0], 2.0 / 3, 1e-12);
+  ASSERT_NEAR(centroids[0][1], 1.0 / 3, 1e-12);
+  ASSERT_NEAR(centroids[0][2], 0.0, 1e-12);
+}
+
+TEST(mesh, invalid_buffers_throw) {
+  std::vector<firefly::vector<double, 3>> normals(12);
+  std::vector<std::uint32_t> partial{0, 1};
+  std::vector<std::uint32_t> out_of_range{0, 1, 8};
+
+  ASSERT_THROW(firefly::face_normals(cube_vertices, partial, normals), std::invalid_argument);
+  ASSERT_THROW(firefly::face_normals(cube_vertices, out_of_range, normals), std::out_of_range);
+  ASSERT_THROW((void)firefly::surface_area(cube_vertices, out_of_range), std::out_of_range);
+  ASSERT_THROW(firefly::face_centroids(cube_vertices, out_of_range, normals), std::out_of_range);
+
+  std::vector<firefly::vector<double, 3>> small(1);
+  ASSERT_THROW(firefly::face_normals(cube_vertices, cube_indices, small), std::invalid_argument);
+  ASSERT_THROW(firefly::vertex_normals(cube_vertices, cube_indices, small), std::invalid_argument);
+}
@@ -0,0 +1,96 @@
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "firefly/quantized_vector.hpp"
+#include "firefly/vector.hpp"
+#include "gtest/gtest.h"
+#include "helpers.hpp"
+
+TEST(quantized_vector, encode__roundtrip_error_bounded) {
+  auto v1 = firefly_tests::sample_vector<float, 768>(1);
+  auto q1 = firefly::quantized_vector<768>::encode(v1);
+  auto v2 = q1.decode();
+
+  ASSERT_EQ(sizeof(q1.codes()), 768);
+  for (std::size_t i = 0; i < v1.size(); ++i) {
+    ASSERT_LE(std::abs(v1[i] - v2[i]), q1.scale() * 0.5f + 1e-5f);
+  }
+}
+
+TEST(quantized_vector, encode__constant_vector) {
+  firefly::vector<float, 4> v1(2.5f);
+  auto q1 = firefly::quantized_vector<4>::encode(v1);
+
+  ASSERT_EQ(q1.decode(), v1);
+  ASSERT_FLOAT_EQ(q1.squared_norm(), 25.0f);
+}
+
+TEST(quantized_vector, dot__matches_decoded) {
+  auto v1 = firefly_tests::sample_vector<float, 768>(1);
+  auto v2 = firefly_tests::sample_vector<float, 768>(2);
+  auto q1 = firefly::quantized_vector<768>::encode(v1);
+  auto q2 = firefly::quantized_vector<768>::encode(v2);
+
+  ASSERT_NEAR(q1.dot(q2), q1.decode().dot(q2.decode()), 1e-2);
+  ASSERT_NEAR(q1.dot(q2), v1.dot(v2), 2.0);
+  ASSERT_NEAR(q1.dot(v2), q1.decode().dot(v2), 1e-2);
+}
+
+TEST(quantized_vector, distance__and_cosine_match_decoded) {
+  auto v1 = firefly_tests::sample_vector<float, 768>(3);
+  auto v2 = firefly_tests::sample_vector<float, 768>(4);
+  auto q1 = firefly::quantized_vector<768>::encode(v1);
+  auto q2 = firefly::quantized_vector<768>::encode(v2);
+  auto d1 = q1.decode();
+  auto d2 = q2.decode();
+
+  ASSERT_NEAR(q1.squared_distance(q2), d1.subtract(d2).squared_norm(), 1e-2);
+  ASSERT_NEAR(q1.distance(q2), v1.subtract(v2).norm(), 0.2);
+  ASSERT_NEAR(q1.cosine(q2), d1.dot(d2) / (d1.norm() * d2.norm()), 1e-4);
+  ASSERT_FLOAT_EQ(q1.distance(q1), 0.0f);
+  ASSERT_THROW(({ (void)q1.cosine(firefly::quantized_vector<768>()); }), std::logic_error);
+}
+
+TEST(quantizer, fit__per_dimension_ranges) {
+  std::vector<firefly::vector<float, 3>> training{{0, -100, 1}, {1, 100, 1}, {0.5f, 0, 1}};
+  auto q = firefly::quantizer<3>::fit(training);
+
+  for (auto const &v : training) {
+    auto decoded = q.decode(q.encode(v));
+    ASSERT_NEAR(decoded[0], v[0], 1.0 / 255);
+    ASSERT_NEAR(decoded[1], v[1], 200.0 / 255);
+    ASSERT_FLOAT_EQ(decoded[2], v[2]);
+  }
+  std::vector<firefly::vector<float, 3>> const empty;
+  ASSERT_THROW((void)firefly::quantizer<3>::fit(empty), std::invalid_argument);
+}
+
+TEST(quantizer, prepared_query__matches_decoded) {
+  std::vector<firefly::vector<float, 64>> training;
+  for (unsigned i = 0; i < 16; ++i) {
+    training.push_back(firefly_tests::sample_vector<float, 64>(i));
+  }
+  auto q = firefly::quantizer<64>::fit(training);
+  auto query = firefly_tests::sample_vector<float, 64>(99);
+  auto prepared = q.prepare(query);
+
+  for (auto const &v : training) {
+    auto codes = q.encode(v);
+    auto decoded = q.decode(codes);
+    ASSERT_NEAR(q.dot(prepared, codes), query.dot(decoded), 1e-3);
+    ASSERT_NEAR(q.squared_distance(prepared, codes), query.subtract(decoded).squared_norm(), 1e-3);
+  }
+}
+
+TEST(quantized_vector, rerank__restores_exact_order) {
+  std::vector<firefly::vector<float, 2>> originals{{0, 0}, {1, 0}, {0.5f, 0}, {3, 3}};
+  std::vector<std::size_t> candidates{0, 1, 2, 3};
+  firefly::vector<float, 2> query{0.9f, 0};
+
+  auto result = firefly::rerank(query, originals, candidates, 2);
+  ASSERT_EQ(result, (std::vector<std::size_t>{1, 2}));
+
+  std::vector<std::size_t> invalid{7};
+  ASSERT_THROW(({ (void)firefly::rerank(query, originals, invalid, 1); }), std::out_of_range);
+}
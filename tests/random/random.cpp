@@ -0,0 +1,166 @@
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "firefly/batch.hpp"
+#include "firefly/random.hpp"
+#include "firefly/vector.hpp"
+#include "gtest/gtest.h"
+
+TEST(philox, operator_call__known_answer_and_positions) {
+  // Philox4x32-10 with a zero counter and a zero key, from the Random123 known-answer tests.
+  firefly::philox generator;
+  ASSERT_EQ(generator(), 0x6627e8d5u);
+  ASSERT_EQ(generator(), 0xe169c58du);
+  ASSERT_EQ(generator(), 0xbc57ac4cu);
+  ASSERT_EQ(generator(), 0x9b00dbd8u);
+  ASSERT_EQ(generator.position(), 4u);
+
+  firefly::philox other(7, 3);
+  std::vector<std::uint32_t> words(300);
+  other.words(5, words.size(), words.data());
+  other.discard(5);
+  for (auto const word : words) {
+    ASSERT_EQ(other(), word);
+  }
+
+  std::uniform_int_distribution<int> die(1, 6);
+  for (int i = 0; i < 100; ++i) {
+    int const roll = die(other);
+    ASSERT_TRUE(roll >= 1 && roll <= 6);
+  }
+}
+
+TEST(philox, split__independent_streams) {
+  firefly::philox base(42);
+  auto first = base.split(1);
+  auto second = base.split(2);
+  ASSERT_EQ(first.seed(), 42u);
+  ASSERT_EQ(second.stream(), 2u);
+  std::size_t equal = 0;
+  for (int i = 0; i < 1000; ++i) {
+    equal += first() == second() ? 1 : 0;
+  }
+  ASSERT_LT(equal, 3u);
+
+  auto again = base.split(1);
+  auto copy = base.split(1);
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_EQ(again(), copy());
+  }
+}
+
+TEST(random, to_uniform__open_interval_excludes_both_ends) {
+  std::uint32_t const ones[2] = {0xffffffffu, 0xffffffffu};
+  std::uint32_t const zeros[2] = {0, 0};
+  ASSERT_LT((firefly::detail::to_uniform<float, true>(ones)), 1.0f);
+  ASSERT_LT((firefly::detail::to_uniform<double, true>(ones)), 1.0);
+  ASSERT_LT((firefly::detail::to_uniform<float, false>(ones)), 1.0f);
+  ASSERT_LT((firefly::detail::to_uniform<double, false>(ones)), 1.0);
+  ASSERT_GT((firefly::detail::to_uniform<float, true>(zeros)), 0.0f);
+  ASSERT_GT((firefly::detail::to_uniform<double, true>(zeros)), 0.0);
+  ASSERT_EQ((firefly::detail::to_uniform<float, false>(zeros)), 0.0f);
+  ASSERT_EQ((firefly::detail::to_uniform<double, false>(zeros)), 0.0);
+}
+
+TEST(random, fill_uniform__independent_of_threads_and_layout) {
+  std::vector<firefly::vector<double, 5>> serial(1000);
+  std::vector<firefly::vector<double, 5>> threaded(1000);
+  firefly::vector_batch<double, 5> batch(1000);
+  firefly::philox a(9);
+  firefly::philox b(9);
+  firefly::philox c(9);
+  firefly::fill_uniform(a, serial, -2.0, 3.0);
+  firefly::fill_uniform(b, threaded, -2.0, 3.0, 4);
+  firefly::fill_uniform(c, batch, -2.0, 3.0, 3);
+  ASSERT_EQ(a.position(), 1000u * 5 * 2);
+  ASSERT_EQ(a(), b());
+
+  double sum = 0;
+  for (std::size_t i = 0; i < serial.size(); ++i) {
+    ASSERT_EQ(serial[i], threaded[i]);
+    ASSERT_EQ(serial[i], batch.get(i));
+    for (std::size_t d = 0; d < 5; ++d) {
+      ASSERT_GE(serial[i][d], -2.0);
+      ASSERT_LT(serial[i][d], 3.0);
+      sum += serial[i][d];
+    }
+  }
+  ASSERT_NEAR(sum / 5000, 0.5, 0.05);
+
+  // Later fills continue the stream instead of repeating it.
+  std::vector<firefly::vector<double, 5>> next(1000);
+  firefly::fill_uniform(a, next, -2.0, 3.0);
+  ASSERT_NE(next[0], serial[0]);
+}
+
+TEST(random, fill_normal__moments) {
+  std::vector<firefly::vector<float, 3>> samples(20000);
+  firefly::philox generator(1);
+  firefly::fill_normal(generator, samples, 2.0f, 0.5f, 2);
+  for (std::size_t d = 0; d < 3; ++d) {
+    double sum = 0;
+    double squares = 0;
+    for (auto const &x : samples) {
+      sum += x[d];
+      squares += double(x[d]) * x[d];
+    }
+    double const mean = sum / double(samples.size());
+    ASSERT_NEAR(mean, 2.0, 0.02);
+    ASSERT_NEAR(squares / double(samples.size()) - mean * mean, 0.25, 0.01);
+  }
+}
+
+TEST(random, fill_unit_sphere__unit_norm_and_centred) {
+  firefly::philox generator(5);
+  std::vector<firefly::vector<double, 3>> three(20000);
+  firefly::fill_unit_sphere(generator, three, 4);
+  firefly::vector_batch<float, 6> six(20000);
+  firefly::fill_unit_sphere(generator, six);
+  std::vector<firefly::vector<double, 2>> two(20000);
+  firefly::fill_unit_sphere(generator, two);
+
+  firefly::vector<double, 3> mean;
+  std::size_t upper = 0;
+  for (auto const &x : three) {
+    ASSERT_NEAR(x.norm(), 1.0, 1e-12);
+    mean += x;
+    upper += x[2] > 0.5 ? 1 : 0;
+  }
+  mean /= double(three.size());
+  ASSERT_LT(mean.norm(), 0.03);
+  // The cap above z = 0.5 covers a quarter of the sphere.
+  ASSERT_NEAR(double(upper) / double(three.size()), 0.25, 0.02);
+
+  for (std::size_t i = 0; i < six.size(); ++i) {
+    ASSERT_NEAR(six.get(i).norm(), 1.0f, 1e-5f);
+  }
+  for (auto const &x : two) {
+    ASSERT_NEAR(x.norm(), 1.0, 1e-12);
+  }
+}
+
+TEST(random, fill_unit_ball__radial_distribution) {
+  firefly::philox generator(11);
+  std::vector<firefly::vector<double, 3>> three(20000);
+  firefly::fill_unit_ball(generator, three, 3);
+  firefly::vector_batch<double, 4> four(20000);
+  firefly::fill_unit_ball(generator, four);
+
+  std::size_t inner = 0;
+  for (auto const &x : three) {
+    ASSERT_LE(x.norm(), 1.0);
+    inner += x.norm() < 0.5 ? 1 : 0;
+  }
+  ASSERT_NEAR(double(inner) / double(three.size()), 0.125, 0.01);
+
+  inner = 0;
+  for (std::size_t i = 0; i < four.size(); ++i) {
+    double const r = four.get(i).norm();
+    ASSERT_LE(r, 1.0 + 1e-12);
+    inner += r < 0.5 ? 1 : 0;
+  }
+  ASSERT_NEAR(double(inner) / double(four.size()), 0.0625, 0.01);
+}
@@ -0,0 +1,107 @@
+#include <array>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "firefly/mask.hpp"
+#include "firefly/scan.hpp"
+#include "firefly/vector.hpp"
+#include "gtest/gtest.h"
+
+TEST(scan, inclusive_scan__vector) {
+  firefly::vector<int, 11> v1{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+  auto v2 = firefly::inclusive_scan(v1);
+
+  int expected = 0;
+  for (std::size_t i = 0; i < v1.size(); ++i) {
+    expected += v1[i];
+    ASSERT_EQ(v2[i], expected);
+  }
+}
+
+TEST(scan, exclusive_scan__vector_with_init) {
+  firefly::vector<int, 10> v1{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+  auto v2 = firefly::exclusive_scan(v1, 100);
+
+  int expected = 100;
+  for (std::size_t i = 0; i < v1.size(); ++i) {
+    ASSERT_EQ(v2[i], expected);
+    expected += v1[i];
+  }
+}
+
+TEST(scan, segmented_inclusive_scan__vector) {
+  firefly::vector<int, 6> v1{1, 2, 3, 4, 5, 6};
+  firefly::mask<6> starts{false, false, true, false, true, false};
+  auto v2 = firefly::segmented_inclusive_scan(v1, starts);
+
+  ASSERT_EQ(v2, (firefly::vector<int, 6>{1, 3, 3, 7, 5, 11}));
+}
+
+TEST(scan, inclusive_scan__constexpr) {
+  constexpr auto v1 = firefly::inclusive_scan(firefly::vector<int, 4>{1, 2, 3, 4});
+
+  static_assert(v1[3] == 10);
+  ASSERT_EQ(v1[2], 6);
+}
+
+TEST(scan, inclusive_scan__parallel_matches_sequential) {
+  std::vector<std::int64_t> in(100003);
+  for (std::size_t i = 0; i < in.size(); ++i) {
+    in[i] = static_cast<std::int64_t>(i % 97) - 48;
+  }
+  std::vector<std::int64_t> expected(in.size());
+  std::inclusive_scan(in.begin(), in.end(), expected.begin());
+
+  for (std::size_t threads : {1, 3, 8}) {
+    std::vector<std::int64_t> out(in.size());
+    firefly::inclusive_scan(in, out, threads);
+    ASSERT_EQ(out, expected);
+  }
+}
+
+TEST(scan, exclusive_scan__parallel_in_place) {
+  std::vector<int> data(1000, 1);
+  firefly::exclusive_scan(data, data, 5, 4);
+
+  for (std::size_t i = 0; i < data.size(); ++i) {
+    ASSERT_EQ(data[i], 5 + int(i));
+  }
+}
+
+TEST(scan, segmented_inclusive_scan__parallel_across_blocks) {
+  std::vector<int> in(1000, 1);
+  std::array<bool, 1000> starts{};
+  for (std::size_t i = 0; i < in.size(); i += 300) {
+    starts[i] = true;
+  }
+
+  std::vector<int> out(in.size());
+  firefly::segmented_inclusive_scan(in, starts, out, 7);
+
+  for (std::size_t i = 0; i < in.size(); ++i) {
+    ASSERT_EQ(out[i], int(i % 300) + 1);
+  }
+}
+
+TEST(scan, inclusive_scan__float_deterministic_for_thread_count) {
+  std::vector<float> in(50000);
+  for (std::size_t i = 0; i < in.size(); ++i) {
+    in[i] = 1.0f / float(i + 1);
+  }
+  std::vector<float> a(in.size());
+  std::vector<float> b(in.size());
+  firefly::inclusive_scan(in, a, 4);
+  firefly::inclusive_scan(in, b, 4);
+
+  ASSERT_EQ(a, b);
+  ASSERT_NEAR(a.back(), 11.397, 1e-2);
+}
+
+TEST(scan, inclusive_scan__short_output_throws) {
+  std::vector<int> in(4, 1);
+  std::vector<int> out(3);
+
+  ASSERT_THROW(firefly::inclusive_scan(in, out), std::invalid_argument);
+}
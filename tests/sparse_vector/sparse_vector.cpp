@@ -0,0 +1,111 @@
+#include <complex>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "firefly/sparse_vector.hpp"
+#include "firefly/vector.hpp"
+#include "gtest/gtest.h"
+
+TEST(sparse_vector, constructor__from_arrays) {
+  firefly::sparse_vector<float> v1(1000000, {3, 70, 999999}, {1.5f, -2.0f, 4.0f});
+
+  ASSERT_EQ(v1.dimension(), 1000000);
+  ASSERT_EQ(v1.nnz(), 3);
+  ASSERT_FLOAT_EQ(v1.at(70), -2.0f);
+  ASSERT_FLOAT_EQ(v1.at(71), 0.0f);
+  ASSERT_THROW(({ (void)v1.at(1000000); }), std::out_of_range);
+}
+
+TEST(sparse_vector, constructor__invalid_arrays_throw) {
+  ASSERT_THROW(firefly::sparse_vector<int>(10, {1, 2}, {1}), std::invalid_argument);
+  ASSERT_THROW(firefly::sparse_vector<int>(10, {2, 2}, {1, 1}), std::invalid_argument);
+  ASSERT_THROW(firefly::sparse_vector<int>(10, {5, 1}, {1, 1}), std::invalid_argument);
+  ASSERT_THROW(firefly::sparse_vector<int>(10, {1, 10}, {1, 1}), std::out_of_range);
+}
+
+TEST(sparse_vector, constructor__from_dense) {
+  firefly::vector<int, 6> dense{0, 4, 0, 0, -1, 0};
+  firefly::sparse_vector<int> v1(dense);
+
+  ASSERT_EQ(v1, (firefly::sparse_vector<int>(6, {1, 4}, {4, -1})));
+  ASSERT_EQ(v1.view(), "{6; 1: 4, 4: -1}");
+}
+
+TEST(sparse_vector, add__merges_positions) {
+  firefly::sparse_vector<int> v1(10, {1, 4, 7}, {1, 2, 3});
+  firefly::sparse_vector<double> v2(10, {0, 4, 9}, {0.5, 0.5, 0.5});
+  auto v3 = v1.add(v2);
+
+  ASSERT_TRUE((std::is_same_v<decltype(v3), firefly::sparse_vector<double>>));
+  ASSERT_EQ(v3, (firefly::sparse_vector<double>(10, {0, 1, 4, 7, 9}, {0.5, 1, 2.5, 3, 0.5})));
+  ASSERT_THROW(({ (void)v1.add(firefly::sparse_vector<int>(11)); }), std::invalid_argument);
+}
+
+TEST(sparse_vector, scale__keeps_positions) {
+  firefly::sparse_vector<int> v1(10, {2, 5}, {3, -4});
+  auto v2 = v1.scale(0.5);
+
+  ASSERT_EQ(v2, (firefly::sparse_vector<double>(10, {2, 5}, {1.5, -2.0})));
+  ASSERT_DOUBLE_EQ(v1.norm(), 5.0);
+  ASSERT_EQ(v1.squared_norm(), 25);
+}
+
+TEST(sparse_vector, dot__sparse_merge_and_gallop) {
+  std::vector<std::uint32_t> dense_indices;
+  std::vector<double> dense_values;
+  for (std::uint32_t i = 0; i < 5000; i += 2) {
+    dense_indices.push_back(i);
+    dense_values.push_back(1.0);
+  }
+  firefly::sparse_vector<double> v1(5000, dense_indices, dense_values);
+  firefly::sparse_vector<int> v2(5000, {0, 3, 100, 4998, 4999}, {1, 5, 2, 3, 7});
+  firefly::sparse_vector<int> v3(5000, {0, 1, 2, 3}, {1, 1, 1, 1});
+
+  ASSERT_DOUBLE_EQ(v1.dot(v2), 6.0);
+  ASSERT_DOUBLE_EQ(v2.dot(v1), 6.0);
+  ASSERT_EQ(v2.dot(v3), 6);
+  ASSERT_THROW(({ (void)v2.dot(firefly::sparse_vector<int>(4)); }), std::invalid_argument);
+}
+
+TEST(sparse_vector, dot__dense_vector_and_buffer) {
+  firefly::sparse_vector<float> v1(4, {0, 3}, {2.0f, 3.0f});
+  firefly::vector<int, 4> v2{1, 2, 3, 4};
+  std::vector<double> v3{0.5, 0, 0, 0.5};
+
+  ASSERT_FLOAT_EQ(v1.dot(v2), 14.0f);
+  ASSERT_DOUBLE_EQ(v1.dot(v3), 2.5);
+  ASSERT_THROW(({ (void)v1.dot(std::vector<double>(5)); }), std::invalid_argument);
+}
+
+TEST(sparse_vector, dot__complex) {
+  firefly::sparse_vector<std::complex<double>> v1(3, {1}, {{1, 2}});
+  firefly::vector<std::complex<double>, 3> v2{{0, 0}, {3, -1}, {9, 9}};
+
+  ASSERT_EQ(v1.dot(v2), std::complex<double>(5, 5));
+}
+
+TEST(sparse_batch, dot__scores_every_row) {
+  firefly::sparse_batch<float> batch(1000);
+  std::vector<float> query(1000);
+  for (std::size_t i = 0; i < query.size(); ++i) {
+    query[i] = float(i);
+  }
+  for (std::uint32_t row = 0; row < 50; ++row) {
+    batch.push_back(firefly::sparse_vector<float>(1000, {row, row + 500}, {1.0f, 2.0f}));
+  }
+  batch.push_back(firefly::sparse_vector<float>(1000));
+
+  ASSERT_EQ(batch.size(), 51);
+  ASSERT_EQ(batch.nnz(), 100);
+  ASSERT_EQ(batch.row(3), (firefly::sparse_vector<float>(1000, {3, 503}, {1.0f, 2.0f})));
+
+  auto scores = batch.dot(query, 4);
+  ASSERT_EQ(scores.size(), 51);
+  for (std::size_t row = 0; row < 50; ++row) {
+    ASSERT_FLOAT_EQ(scores[row], batch.row(row).dot(query));
+    ASSERT_FLOAT_EQ(scores[row], float(row) + 2.0f * float(row + 500));
+  }
+  ASSERT_FLOAT_EQ(scores[50], 0.0f);
+  ASSERT_THROW(batch.push_back(firefly::sparse_vector<float>(10)), std::invalid_argument);
+}
@@ -0,0 +1,259 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "firefly/batch.hpp"
+#include "firefly/statistics.hpp"
+#include "firefly/vector.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+// Samples of a correlated 4D distribution around a large offset.
+std::vector<firefly::vector<double, 4>> make_samples(std::size_t n) {
+  std::vector<firefly::vector<double, 4>> samples(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    double const a = std::sin(double(i) * 0.37);
+    double const b = std::cos(double(i) * 1.91);
+    double const c = std::sin(double(i) * 2.73 + 0.5);
+    samples[i] = {1e6 + 3 * a, -2e6 + 3 * a + b, 5 + 0.5 * c, 7 + 0.1 * b};
+  }
+  return samples;
+}
+
+} // namespace
+
+TEST(covariance_accumulator, add__matches_direct_covariance) {
+  auto const samples = make_samples(1000);
+  firefly::vector<double, 4> mean;
+  for (auto const &x : samples) {
+    mean += x;
+  }
+  mean /= double(samples.size());
+  std::vector<double> expected(16, 0.0);
+  for (auto const &x : samples) {
+    for (std::size_t i = 0; i < 4; ++i) {
+      for (std::size_t j = 0; j < 4; ++j) {
+        expected[i * 4 + j] += (x[i] - mean[i]) * (x[j] - mean[j]) / double(samples.size() - 1);
+      }
+    }
+  }
+
+  firefly::covariance_accumulator<double, 4> one_by_one;
+  for (auto const &x : samples) {
+    one_by_one.add(x);
+  }
+  firefly::covariance_accumulator<double, 4> blocked;
+  blocked.add(samples);
+  firefly::covariance_accumulator<double, 4> threaded;
+  threaded.add(samples, 4);
+
+  for (auto const *accumulator : {&one_by_one, &blocked, &threaded}) {
+    ASSERT_EQ(accumulator->count(), samples.size());
+    ASSERT_NEAR(accumulator->mean()[0], 1e6, 1.0);
+    auto const covariance = accumulator->covariance();
+    for (std::size_t i = 0; i < 16; ++i) {
+      ASSERT_NEAR(covariance[i], expected[i], 1e-9);
+    }
+  }
+}
+
+TEST(covariance_accumulator, merge__equals_single_stream) {
+  auto const samples = make_samples(500);
+  firefly::covariance_accumulator<double, 4> all;
+  all.add(samples);
+
+  firefly::covariance_accumulator<double, 4> left;
+  firefly::covariance_accumulator<double, 4> right;
+  left.add(std::vector(samples.begin(), samples.begin() + 123));
+  right.add(std::vector(samples.begin() + 123, samples.end()));
+  left.merge(right);
+  left.merge(firefly::covariance_accumulator<double, 4>());
+
+  ASSERT_EQ(left.count(), all.count());
+  for (std::size_t d = 0; d < 4; ++d) {
+    ASSERT_NEAR(left.mean()[d], all.mean()[d], 1e-6);
+  }
+  auto const a = left.covariance(false);
+  auto const b = all.covariance(false);
+  for (std::size_t i = 0; i < 16; ++i) {
+    ASSERT_NEAR(a[i], b[i], 1e-9);
+  }
+}
+
+TEST(covariance_accumulator, empty__throws) {
+  firefly::covariance_accumulator<float, 2> accumulator;
+  ASSERT_THROW((void)accumulator.mean(), std::logic_error);
+  ASSERT_THROW((void)accumulator.covariance(false), std::logic_error);
+  accumulator.add({1.0f, 2.0f});
+  ASSERT_NO_THROW((void)accumulator.covariance(false));
+  ASSERT_THROW((void)accumulator.covariance(), std::logic_error);
+}
+
+TEST(running_statistics, add__matches_direct_moments) {
+  auto const samples = make_samples(1000);
+  firefly::vector<double, 4> mean;
+  firefly::vector<double, 4> variance;
+  firefly::vector<double, 4> min = samples[0];
+  firefly::vector<double, 4> max = samples[0];
+  for (std::size_t d = 0; d < 4; ++d) {
+    for (auto const &x : samples) {
+      mean[d] += x[d];
+      min[d] = std::min(min[d], x[d]);
+      max[d] = std::max(max[d], x[d]);
+    }
+    mean[d] /= double(samples.size());
+    for (auto const &x : samples) {
+      variance[d] += (x[d] - mean[d]) * (x[d] - mean[d]);
+    }
+    variance[d] /= double(samples.size() - 1);
+  }
+
+  firefly::running_statistics<double, 4> one_by_one;
+  for (auto const &x : samples) {
+    one_by_one.add(x);
+  }
+  firefly::running_statistics<double, 4> blocked;
+  blocked.add(samples);
+  firefly::running_statistics<double, 4> threaded;
+  threaded.add(samples, 3);
+  firefly::running_statistics<double, 4> batched;
+  batched.add(firefly::vector_batch<double, 4>(samples), 2);
+
+  for (auto const *statistics : {&one_by_one, &blocked, &threaded, &batched}) {
+    ASSERT_EQ(statistics->count(), samples.size());
+    for (std::size_t d = 0; d < 4; ++d) {
+      ASSERT_NEAR(statistics->mean()[d], mean[d], 1e-14 * std::abs(mean[d]));
+      ASSERT_NEAR(statistics->variance()[d], variance[d], 1e-9);
+      ASSERT_DOUBLE_EQ(statistics->min()[d], min[d]);
+      ASSERT_DOUBLE_EQ(statistics->max()[d], max[d]);
+    }
+  }
+  // Blocks are merged in order, so neither the thread count nor the layout changes the result.
+  ASSERT_EQ(threaded.mean(), blocked.mean());
+  ASSERT_EQ(threaded.variance(), blocked.variance());
+  ASSERT_EQ(batched.mean(), blocked.mean());
+  ASSERT_EQ(batched.variance(), blocked.variance());
+}
+
+TEST(running_statistics, merge__equals_single_stream) {
+  auto const samples = make_samples(700);
+  firefly::running_statistics<double, 4> all;
+  all.add(samples);
+
+  firefly::running_statistics<double, 4> left;
+  firefly::running_statistics<double, 4> right;
+  left.add(std::vector(samples.begin(), samples.begin() + 301));
+  right.add(std::vector(samples.begin() + 301, samples.end()));
+  left.merge(right);
+  left.merge(firefly::running_statistics<double, 4>());
+
+  ASSERT_EQ(left.count(), all.count());
+  for (std::size_t d = 0; d < 4; ++d) {
+    ASSERT_NEAR(left.mean()[d], all.mean()[d], 1e-6);
+    ASSERT_NEAR(left.variance(false)[d], all.variance(false)[d], 1e-9);
+    ASSERT_EQ(left.min()[d], all.min()[d]);
+    ASSERT_EQ(left.max()[d], all.max()[d]);
+  }
+}
+
+TEST(running_statistics, remove__sliding_window) {
+  auto const samples = make_samples(400);
+  std::size_t const window = 50;
+
+  firefly::running_statistics<double, 4> sliding;
+  for (std::size_t i = 0; i < samples.size(); ++i) {
+    sliding.add(samples[i]);
+    if (i >= window) {
+      sliding.remove(samples[i - window]);
+    }
+  }
+  firefly::running_statistics<double, 4> last;
+  last.add(std::vector(samples.end() - window, samples.end()));
+
+  ASSERT_EQ(sliding.count(), window);
+  for (std::size_t d = 0; d < 4; ++d) {
+    ASSERT_NEAR(sliding.mean()[d], last.mean()[d], 1e-6);
+    ASSERT_NEAR(sliding.variance()[d], last.variance()[d], 1e-6);
+  }
+
+  for (auto it = samples.end() - window; it != samples.end(); ++it) {
+    sliding.remove(*it);
+  }
+  ASSERT_EQ(sliding.count(), 0u);
+  ASSERT_THROW(sliding.remove(samples[0]), std::logic_error);
+
+  // The extrema keep covering removed samples, also after the window has emptied.
+  firefly::running_statistics<double, 1> extrema;
+  extrema.add(firefly::vector<double, 1>{-5.0});
+  extrema.remove(firefly::vector<double, 1>{-5.0});
+  extrema.add(firefly::vector<double, 1>{2.0});
+  ASSERT_EQ(extrema.min()[0], -5.0);
+  ASSERT_EQ(extrema.max()[0], 2.0);
+  ASSERT_EQ(extrema.mean()[0], 2.0);
+}
+
+TEST(running_statistics, empty__throws) {
+  firefly::running_statistics<float, 2> statistics;
+  ASSERT_THROW((void)statistics.mean(), std::logic_error);
+  ASSERT_THROW((void)statistics.min(), std::logic_error);
+  ASSERT_THROW((void)statistics.max(), std::logic_error);
+  ASSERT_THROW((void)statistics.variance(false), std::logic_error);
+  statistics.add({1.0f, 2.0f});
+  ASSERT_NO_THROW((void)statistics.variance(false));
+  ASSERT_THROW((void)statistics.variance(), std::logic_error);
+}
+
+TEST(statistics, top_eigenvectors__diagonal_and_rotated) {
+  std::vector<double> diagonal{1, 0, 0, 0, 5, 0, 0, 0, 3};
+  auto const [values, vectors] = firefly::top_eigenvectors<3>(diagonal, 2);
+  ASSERT_NEAR(values[0], 5.0, 1e-12);
+  ASSERT_NEAR(values[1], 3.0, 1e-12);
+  ASSERT_NEAR(std::abs(vectors[0][1]), 1.0, 1e-7);
+  ASSERT_NEAR(std::abs(vectors[1][2]), 1.0, 1e-7);
+
+  // [[2, 1], [1, 2]] has eigenvalues 3 and 1 along (1, 1) and (1, -1).
+  std::vector<double> rotated{2, 1, 1, 2};
+  auto const [values2, vectors2] = firefly::top_eigenvectors<2>(rotated, 2, 2);
+  ASSERT_NEAR(values2[0], 3.0, 1e-12);
+  ASSERT_NEAR(values2[1], 1.0, 1e-12);
+  ASSERT_NEAR(std::abs(vectors2[0][0]), std::sqrt(0.5), 1e-7);
+  ASSERT_NEAR(vectors2[0][0] * vectors2[0][1], 0.5, 1e-7);
+
+  ASSERT_THROW((void)firefly::top_eigenvectors<3>(rotated, 1), std::invalid_argument);
+  ASSERT_THROW((void)firefly::top_eigenvectors<2>(rotated, 3), std::invalid_argument);
+}
+
+TEST(statistics, top_eigenvectors__close_eigenvalues) {
+  // The vectors turn by less than the float rounding error per iteration long before they reach (1, 0, 0, 0).
+  std::vector<float> diagonal{1, 0, 0, 0, 0, 0.99f, 0, 0, 0, 0, 0.5f, 0, 0, 0, 0, 0.25f};
+  auto const [values, vectors] = firefly::top_eigenvectors<4>(diagonal, 1);
+  ASSERT_NEAR(values[0], 1.0f, 1e-5f);
+  ASSERT_NEAR(std::abs(vectors[0][0]), 1.0f, 1e-6f);
+  ASSERT_LT(std::abs(vectors[0][1]), 1e-3f);
+}
+
+TEST(statistics, principal_components__project_onto_components) {
+  auto const samples = make_samples(2000);
+  firefly::covariance_accumulator<double, 4> accumulator;
+  accumulator.add(samples, 2);
+  auto const [variances, components] = firefly::principal_components(accumulator, 2);
+  ASSERT_GT(variances[0], variances[1]);
+
+  std::vector<firefly::vector<double, 2>> projected(samples.size());
+  firefly::project(components, accumulator.mean(), samples, projected, 3);
+
+  // The projections are centred, uncorrelated and have the component variances.
+  firefly::covariance_accumulator<double, 2> reduced;
+  reduced.add(projected);
+  auto const covariance = reduced.covariance();
+  ASSERT_NEAR(reduced.mean()[0], 0.0, 1e-6);
+  ASSERT_NEAR(covariance[0], variances[0], 1e-6 * variances[0]);
+  ASSERT_NEAR(covariance[3], variances[1], 1e-6 * variances[0]);
+  ASSERT_NEAR(covariance[1], 0.0, 1e-6 * variances[0]);
+
+  std::vector<firefly::vector<double, 3>> wrong(samples.size());
+  ASSERT_THROW(firefly::project(components, accumulator.mean(), samples, wrong), std::invalid_argument);
+}
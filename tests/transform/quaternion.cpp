@@ -0,0 +1,70 @@
+#include <cmath>
+#include <numbers>
+#include <stdexcept>
+
+#include "firefly/quaternion.hpp"
+#include "firefly/vector.hpp"
+#include "gtest/gtest.h"
+#include "helpers.hpp"
+
+TEST(quaternion, constructor__identity) {
+  constexpr firefly::quaternion<double> q1;
+  static_assert(q1.w() == 1 && q1.x() == 0 && q1.y() == 0 && q1.z() == 0);
+
+  ASSERT_EQ(q1.view(), "(1, 0, 0, 0)");
+  ASSERT_EQ(q1.rotate(firefly::vector<double, 3>{1, 2, 3}), (firefly::vector<double, 3>{1, 2, 3}));
+}
+
+TEST(quaternion, from_axis_angle__rotates) {
+  auto const q1 = firefly::quaternion<double>::from_axis_angle(firefly::vector<int, 3>{0, 0, 5}, std::numbers::pi / 2);
+
+  ASSERT_NEAR(q1.norm(), 1.0, 1e-15);
+  firefly_tests::expect_near(q1.rotate(firefly::vector<double, 3>{1, 0, 0}), firefly::vector<double, 3>{0, 1, 0});
+  firefly_tests::expect_near(q1.to_matrix() * firefly::vector<double, 3>{1, 0, 0}, firefly::vector<double, 3>{0, 1, 0});
+  ASSERT_THROW(({ (void)firefly::quaternion<double>::from_axis_angle(firefly::vector<int, 3>{}, 1.0); }),
+               std::logic_error);
+}
+
+TEST(quaternion, to_axis_angle__round_trips) {
+  firefly::vector<double, 3> const axis = firefly::vector<double, 3>{1, -2, 2} * (1.0 / 3.0);
+  auto const q1 = firefly::quaternion<double>::from_axis_angle(axis, 2.5);
+
+  auto const [axis1, angle1] = q1.to_axis_angle();
+  firefly_tests::expect_near(axis1, axis);
+  ASSERT_NEAR(angle1, 2.5, 1e-12);
+
+  auto const [axis2, angle2] = (-q1).to_axis_angle();
+  firefly_tests::expect_near(axis2, axis);
+  ASSERT_NEAR(angle2, 2.5, 1e-12);
+
+  auto const [axis3, angle3] = firefly::quaternion<double>().to_axis_angle();
+  ASSERT_EQ(axis3, (firefly::vector<double, 3>{1, 0, 0}));
+  ASSERT_EQ(angle3, 0.0);
+}
+
+TEST(quaternion, product__composes_rotations) {
+  auto const qx =
+      firefly::quaternion<double>::from_axis_angle(firefly::vector<double, 3>{1, 0, 0}, std::numbers::pi / 2);
+  auto const qz =
+      firefly::quaternion<double>::from_axis_angle(firefly::vector<double, 3>{0, 0, 1}, std::numbers::pi / 2);
+  firefly::vector<double, 3> const v{0, 1, 0};
+
+  firefly_tests::expect_near((qz * qx).rotate(v), qz.rotate(qx.rotate(v)));
+  firefly_tests::expect_near((qz * qz.inverse()).rotate(v), v);
+  firefly_tests::expect_near(qz.conjugate().rotate(qz.rotate(v)), v);
+  ASSERT_THROW(({ (void)firefly::quaternion<double>(0, 0, 0, 0).inverse(); }), std::logic_error);
+}
+
+TEST(quaternion, slerp__constant_velocity) {
+  firefly::vector<double, 3> const axis{0, 1, 0};
+  auto const a = firefly::quaternion<double>::from_axis_angle(axis, 0.2);
+  auto const b = firefly::quaternion<double>::from_axis_angle(axis, 1.4);
+
+  for (double t : {0.0, 0.25, 0.5, 1.0}) {
+    auto const [_, angle] = firefly::slerp(a, b, t).to_axis_angle();
+    ASSERT_NEAR(angle, 0.2 + 1.2 * t, 1e-12);
+  }
+  auto const [_, angle] = firefly::slerp(a, -b, 0.5).to_axis_angle();
+  ASSERT_NEAR(angle, 0.8, 1e-12);
+  ASSERT_NEAR(firefly::slerp(a, a, 0.3).norm(), 1.0, 1e-15);
+}
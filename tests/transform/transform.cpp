@@ -0,0 +1,180 @@
+#include <cmath>
+#include <numbers>
+#include <stdexcept>
+#include <vector>
+
+#include "firefly/batch.hpp"
+#include "firefly/quaternion.hpp"
+#include "firefly/transform.hpp"
+#include "firefly/utilities.hpp"
+#include "firefly/vector.hpp"
+#include "gtest/gtest.h"
+#include "helpers.hpp"
+
+TEST(affine, constructor__homogeneous_round_trip) {
+  firefly::matrix<double, 4, 4> m1{{1, 2, 3, 4}, {5, 6, 7, 8}, {9, 10, 11, 12}, {0, 0, 0, 1}};
+  firefly::affine<double, 3> a1(m1);
+
+  ASSERT_EQ(a1.translation(), (firefly::vector<double, 3>{4, 8, 12}));
+  ASSERT_EQ(a1.to_matrix(), m1);
+  ASSERT_EQ((a1.to_matrix<firefly::layout::column_major>()), m1);
+  ASSERT_THROW((firefly::affine<double, 3>(firefly::matrix<double, 4, 4>{})), std::invalid_argument);
+  ASSERT_EQ((firefly::affine<double, 2>().to_matrix()), (firefly::matrix<double, 3, 3>::identity()));
+}
+
+TEST(affine, composition__applies_right_first) {
+  auto const scale = firefly::affine<double, 2>::scaling(firefly::vector<double, 2>{2, 3});
+  auto const shift = firefly::affine<double, 2>::translation(firefly::vector<double, 2>{1, -1});
+  auto const turn = firefly::affine<double, 2>::rotation(std::numbers::pi / 2);
+  firefly::vector<double, 2> const p{1, 1};
+
+  ASSERT_EQ((shift * scale)(p), (firefly::vector<double, 2>{3, 2}));
+  ASSERT_EQ((scale * shift)(p), (firefly::vector<double, 2>{4, 0}));
+  firefly_tests::expect_near(turn(p), firefly::vector<double, 2>{-1, 1}, 1e-15);
+  ASSERT_EQ(shift.apply_direction(p), p);
+}
+
+TEST(affine, inverse__undoes_transform) {
+  auto const q1 = firefly::quaternion<double>::from_axis_angle(firefly::vector<double, 3>{1, 1, 0}, 0.7);
+  auto const a1 = firefly::affine<double, 3>::translation(firefly::vector<double, 3>{1, 2, 3}) *
+                  firefly::affine<double, 3>::rotation(q1) *
+                  firefly::affine<double, 3>::scaling(firefly::vector<double, 3>{2, 0.5, 4});
+  firefly::vector<double, 3> const p{-3, 0.25, 7};
+
+  firefly_tests::expect_near(a1.inverse()(a1(p)), p, 1e-12);
+  ASSERT_THROW(({ (void)firefly::affine<double, 3>::scaling(firefly::vector<double, 3>{1, 0, 1}).inverse(); }),
+               std::logic_error);
+}
+
+TEST(affine, transform_points__array_and_soa) {
+  auto const a1 = firefly::affine<float, 3>::translation(firefly::vector<float, 3>{1, 0, -1}) *
+                  firefly::affine<float, 3>::rotation(
+                      firefly::quaternion<float>::from_axis_angle(firefly::vector<float, 3>{0, 0, 1}, 0.3f));
+  std::vector<firefly::vector<float, 3>> points(1001);
+  std::vector<float> xs(points.size()), ys(points.size()), zs(points.size());
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    points[i] = firefly::vector<float, 3>{float(i), float(i % 7), -float(i % 3)};
+    xs[i] = points[i][0];
+    ys[i] = points[i][1];
+    zs[i] = points[i][2];
+  }
+  std::vector<firefly::vector<float, 3>> out(points.size());
+
+  firefly::transform_points(a1, points, out, 3);
+  firefly::transform_points(a1, xs, ys, zs, 3);
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    firefly_tests::expect_near(out[i], a1(points[i]), 1e-4f);
+    firefly_tests::expect_near(firefly::vector<float, 3>{xs[i], ys[i], zs[i]}, a1(points[i]), 1e-4f);
+  }
+
+  std::vector<float> short_ys(3);
+  ASSERT_THROW(firefly::transform_points(a1, xs, short_ys, zs), std::invalid_argument);
+}
+
+TEST(rotate, batch__matches_single_rotation) {
+  auto const q1 = firefly::quaternion<double>::from_axis_angle(firefly::vector<double, 3>{1, 2, 3}, 1.1);
+  std::vector<firefly::vector<double, 3>> points(257);
+  std::vector<double> xs(points.size()), ys(points.size()), zs(points.size());
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    points[i] = firefly::vector<double, 3>{std::sin(double(i)), std::cos(double(i)), double(i) / 100};
+    xs[i] = points[i][0];
+    ys[i] = points[i][1];
+    zs[i] = points[i][2];
+  }
+  auto rotated = points;
+
+  firefly::rotate(q1, rotated, rotated, 2);
+  firefly::rotate(q1, xs, ys, zs);
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    firefly_tests::expect_near(rotated[i], q1.rotate(points[i]), 1e-12);
+    firefly_tests::expect_near(firefly::vector<double, 3>{xs[i], ys[i], zs[i]}, q1.rotate(points[i]), 1e-12);
+  }
+}
+
+TEST(rotation_2d, apply__matches_rotate_2d) {
+  constexpr firefly::rotation_2d<double> r1(std::numbers::pi / 2);
+  static_assert(r1.sin() > 0.999);
+
+  firefly_tests::expect_near(r1(firefly::vector<double, 2>{1, 0}), firefly::vector<double, 2>{0, 1}, 1e-15);
+  firefly_tests::expect_near((r1 * r1)(firefly::vector<double, 2>{1, 2}), firefly::vector<double, 2>{-1, -2}, 1e-15);
+  firefly_tests::expect_near(r1.inverse()(r1(firefly::vector<double, 2>{3, 4})), firefly::vector<double, 2>{3, 4},
+                             1e-15);
+  ASSERT_EQ((r1.to_matrix() * firefly::vector<double, 2>{1, 0}), r1(firefly::vector<double, 2>{1, 0}));
+}
+
+TEST(rotate, batch_2d__shared_angle) {
+  firefly::rotation_2d<float> const r1(0.4f);
+  std::vector<firefly::vector<float, 2>> points(333);
+  std::vector<float> xs(points.size()), ys(points.size());
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    points[i] = firefly::vector<float, 2>{float(i), 1.0f - float(i % 5)};
+    xs[i] = points[i][0];
+    ys[i] = points[i][1];
+  }
+  std::vector<firefly::vector<float, 2>> out(points.size());
+
+  firefly::rotate(r1, points, out, 2);
+  firefly::rotate(r1, xs, ys, 2);
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    // The batch takes sine and cosine from the vectorised kernel, so it may differ from std::sin by a few ulp.
+    double const tolerance = 1e-6 * (1.0 + double(points[i].norm()));
+    firefly_tests::expect_near(out[i], r1(points[i]), tolerance);
+    firefly_tests::expect_near(firefly::vector<float, 2>{xs[i], ys[i]}, r1(points[i]), tolerance);
+  }
+}
+
+TEST(rotate, batch_2d__per_element_angles) {
+  std::vector<firefly::vector<double, 2>> points(1000);
+  std::vector<double> angles(points.size());
+  std::vector<double> xs(points.size()), ys(points.size());
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    points[i] = firefly::vector<double, 2>{1.0 + double(i % 3), -double(i % 7)};
+    angles[i] = double(i) * 0.05 - 20.0;
+    xs[i] = points[i][0];
+    ys[i] = points[i][1];
+  }
+  auto rotated = points;
+
+  firefly::rotate(rotated, angles, rotated, 3);
+  firefly::rotate(xs, ys, angles, 3);
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    auto const expected = firefly::utilities::vector::rotate_2d(points[i], angles[i]);
+    firefly_tests::expect_near(rotated[i], expected, 1e-13);
+    firefly_tests::expect_near(firefly::vector<double, 2>{xs[i], ys[i]}, expected, 1e-13);
+  }
+
+  std::vector<double> short_angles(3);
+  ASSERT_THROW(firefly::rotate(xs, ys, short_angles), std::invalid_argument);
+}
+
+TEST(rotate, vector_batch__matches_single_transforms) {
+  auto const points3 = firefly_tests::sample_vectors<double, 3>(301);
+  auto const points2 = firefly_tests::sample_vectors<double, 2>(301);
+  auto const q1 = firefly::quaternion<double>::from_axis_angle(firefly::vector<double, 3>{0, 1, 1}, 0.7);
+  auto const a1 = firefly::affine<double, 3>::translation(firefly::vector<double, 3>{1, -2, 3}) *
+                  firefly::affine<double, 3>::rotation(q1);
+  auto const a2 = firefly::affine<double, 2>::translation(firefly::vector<double, 2>{0.5, 4});
+  firefly::rotation_2d<double> const r1(-1.3);
+  std::vector<double> angles(points2.size());
+  for (std::size_t i = 0; i < angles.size(); ++i) {
+    angles[i] = double(i) * 0.1 - 15.0;
+  }
+
+  firefly::vector_batch<double, 3> rotated3(points3), transformed3(points3);
+  firefly::vector_batch<double, 2> rotated2(points2), turned2(points2), transformed2(points2);
+  firefly::rotate(q1, rotated3, 2);
+  firefly::transform_points(a1, transformed3, 3);
+  firefly::rotate(r1, rotated2);
+  firefly::rotate(turned2, angles, 2);
+  firefly::transform_points(a2, transformed2);
+  for (std::size_t i = 0; i < points3.size(); ++i) {
+    firefly_tests::expect_near(rotated3.get(i), q1.rotate(points3[i]), 1e-12);
+    firefly_tests::expect_near(transformed3.get(i), a1(points3[i]), 1e-12);
+    firefly_tests::expect_near(rotated2.get(i), r1(points2[i]), 1e-12);
+    firefly_tests::expect_near(turned2.get(i), firefly::utilities::vector::rotate_2d(points2[i], angles[i]), 1e-13);
+    firefly_tests::expect_near(transformed2.get(i), a2(points2[i]), 1e-12);
+  }
+
+  std::vector<double> short_angles(3);
+  ASSERT_THROW(firefly::rotate(turned2, short_angles), std::invalid_argument);
+}
@@ -1,3 +1,11 @@
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <numbers>
+#include <utility>
+#include <vector>
+
+#include "firefly/batch.hpp"
 #include "firefly/utilities.hpp"
 #include "firefly/vector.hpp"
 #include "gtest/gtest.h"
@@ -408,4 +416,164 @@ TEST(utilities, lerp__complex_normal_vectors) {
   ASSERT_DOUBLE_EQ(lerp_v1_v2[0].imag(), 4);
   ASSERT_DOUBLE_EQ(lerp_v1_v2[1].real(), 5);
   ASSERT_DOUBLE_EQ(lerp_v1_v2[1].imag(), 6);
-}
\ No newline at end of file
+}
+
+TEST(utilities, rotate_2d__lookup_table_is_constant_expression) {
+  constexpr auto table = [] {
+    std::array<firefly::vector<double, 2>, 8> result{};
+    for (std::size_t i = 0; i < result.size(); ++i) {
+      result[i] = firefly::utilities::vector::rotate_2d(firefly::vector<double, 2>{1, 0}, i * std::numbers::pi / 4);
+    }
+    return result;
+  }();
+
+  for (std::size_t i = 0; i < table.size(); ++i) {
+    ASSERT_NEAR(table[i][0], std::cos(i * M_PI / 4), 1e-15);
+    ASSERT_NEAR(table[i][1], std::sin(i * M_PI / 4), 1e-15);
+  }
+}
+
+TEST(utilities, angle_between__constant_expression) {
+  constexpr auto angle =
+      firefly::utilities::vector::angle_between(firefly::vector<int, 2>{1, 2}, firefly::vector<int, 2>{3, 4});
+
+  ASSERT_NEAR(angle, 0.17985349979247847, 1e-12);
+}
+
+TEST(utilities, squared_distance__normal_vectors) {
+  firefly::vector<int, 2> v1{1, 2};
+  firefly::vector<double, 2> v2{3, 5};
+
+  ASSERT_TRUE((std::is_same_v<decltype(firefly::utilities::vector::squared_distance(v1, v2)), double>));
+  ASSERT_DOUBLE_EQ(firefly::utilities::vector::squared_distance(v1, v2), 13);
+  ASSERT_DOUBLE_EQ(firefly::utilities::vector::squared_distance(firefly::vector<std::complex<double>, 1>{{1, 2}},
+                                                                firefly::vector<std::complex<double>, 1>{{4, 6}}),
+                   25);
+}
+
+TEST(utilities, squared_distance__bounded_abandons_early) {
+  firefly::vector<float, 100> v1(0.0f);
+  firefly::vector<float, 100> v2(1.0f);
+
+  ASSERT_FLOAT_EQ(firefly::utilities::vector::squared_distance(v1, v2, 1000.0f), 100.0f);
+  auto abandoned = firefly::utilities::vector::squared_distance(v1, v2, 10.0f);
+  ASSERT_GT(abandoned, 10.0f);
+  ASSERT_LT(abandoned, 100.0f);
+}
+
+TEST(utilities, manhattan_distance__normal_vectors) {
+  firefly::vector<int, 3> v1{1, -2, 3};
+  firefly::vector<int, 3> v2{4, 2, 3};
+
+  ASSERT_EQ(firefly::utilities::vector::manhattan_distance(v1, v2), 7);
+  ASSERT_EQ(firefly::utilities::vector::manhattan_distance(v1, v2, 100), 7);
+  ASSERT_EQ(firefly::utilities::vector::manhattan_distance(firefly::vector<unsigned, 2>{1, 5},
+                                                           firefly::vector<unsigned, 2>{3, 2}),
+            5u);
+}
+
+TEST(utilities, chebyshev_distance__normal_vectors) {
+  firefly::vector<double, 3> v1{1, -2, 3};
+  firefly::vector<double, 3> v2{4, 2, 3};
+
+  ASSERT_DOUBLE_EQ(firefly::utilities::vector::chebyshev_distance(v1, v2), 4);
+  ASSERT_DOUBLE_EQ(firefly::utilities::vector::chebyshev_distance(v1, v2, 10.0), 4);
+}
+
+TEST(utilities, k_nearest__matches_full_scan) {
+  std::vector<firefly::vector<float, 64>> candidates;
+  for (std::size_t c = 0; c < 300; ++c) {
+    firefly::vector<float, 64> v;
+    for (std::size_t i = 0; i < 64; ++i) {
+      v[i] = std::sin(float(c * 64 + i) * 0.7f) * float(1 + c % 7);
+    }
+    candidates.push_back(v);
+  }
+  firefly::vector<float, 64> query = candidates[123] * 1.01f;
+
+  auto nearest = firefly::utilities::vector::k_nearest(query, candidates, 5);
+  ASSERT_EQ(nearest.size(), 5);
+  ASSERT_EQ(nearest[0].first, 123);
+
+  std::vector<std::pair<float, std::size_t>> expected;
+  for (std::size_t c = 0; c < candidates.size(); ++c) {
+    expected.emplace_back(firefly::utilities::vector::squared_distance(query, candidates[c]), c);
+  }
+  std::sort(expected.begin(), expected.end());
+  for (std::size_t i = 0; i < nearest.size(); ++i) {
+    ASSERT_EQ(nearest[i].first, expected[i].second);
+    ASSERT_FLOAT_EQ(nearest[i].second, expected[i].first);
+  }
+  ASSERT_TRUE(firefly::utilities::vector::k_nearest(query, candidates, 0).empty());
+}
+
+TEST(utilities, angles_between__matches_angle_between) {
+  std::vector<firefly::vector<double, 3>> as;
+  std::vector<firefly::vector<double, 3>> bs;
+  for (std::size_t i = 0; i < 1000; ++i) {
+    double const x = double(i);
+    as.push_back({std::sin(x), std::cos(0.3 * x), 0.5});
+    bs.push_back({std::cos(0.7 * x), 1.0 - std::sin(x), -0.25 * std::sin(0.1 * x)});
+  }
+  as.push_back({1, 2, 3});
+  bs.push_back({2, 4, 6});
+  as.push_back({0, 0, 0});
+  bs.push_back({1, 0, 0});
+  std::vector<double> angles(as.size());
+
+  firefly::utilities::vector::angles_between(as, bs, angles, 1e-6, 3);
+  for (std::size_t i = 0; i < as.size(); ++i) {
+    ASSERT_NEAR(angles[i], firefly::utilities::vector::angle_between(as[i], bs[i]), 1e-7);
+  }
+  ASSERT_EQ(angles[as.size() - 2], 0.0);
+  ASSERT_DOUBLE_EQ(angles.back(), M_PI_2);
+
+  std::vector<double> batched(as.size());
+  firefly::utilities::vector::angles_between(firefly::vector_batch<double, 3>(as), firefly::vector_batch<double, 3>(bs),
+                                             batched);
+  for (std::size_t i = 0; i < as.size(); ++i) {
+    ASSERT_NEAR(batched[i], angles[i], 1e-12);
+  }
+
+  std::vector<double> small(1);
+  ASSERT_THROW(firefly::utilities::vector::angles_between(as, bs, small), std::invalid_argument);
+}
+
+TEST(utilities, classify_pairs__orthogonal_and_parallel) {
+  using firefly::utilities::vector::pair_relation;
+  std::vector<firefly::vector<float, 2>> as{{1, 2}, {1, 2}, {1, 2}, {1, 2}, {0, 0}, {1, 0}};
+  std::vector<firefly::vector<float, 2>> bs{{-8, 4}, {2, 4}, {-3, -6}, {3, 4}, {1, 1}, {1, 1e-2f}};
+  std::vector<pair_relation> relations(as.size());
+
+  firefly::utilities::vector::classify_pairs(as, bs, relations);
+  ASSERT_EQ(relations[0], pair_relation::orthogonal);
+  ASSERT_EQ(relations[1], pair_relation::parallel);
+  ASSERT_EQ(relations[2], pair_relation::parallel | pair_relation::anti_parallel);
+  ASSERT_EQ(relations[3], pair_relation::none);
+  ASSERT_EQ(relations[4], pair_relation::orthogonal);
+  ASSERT_EQ(relations[5], pair_relation::none);
+
+  firefly::utilities::vector::classify_pairs(as, bs, relations, 2e-2);
+  ASSERT_EQ(relations[5] & pair_relation::parallel, pair_relation::parallel);
+
+  std::vector<pair_relation> batched(as.size());
+  firefly::utilities::vector::classify_pairs(firefly::vector_batch<float, 2>(as), firefly::vector_batch<float, 2>(bs),
+                                             batched, 2e-2, 2);
+  ASSERT_EQ(batched, relations);
+}
+
+TEST(utilities, angles_between__large_and_small_scales) {
+  using firefly::utilities::vector::pair_relation;
+  // |a|²|b|² overflows float for the first pair and underflows for the second, while a·b and the norms do not.
+  std::vector<firefly::vector<float, 3>> as{{1e10f, 0, 0}, {1e-12f, 0, 0}};
+  std::vector<firefly::vector<float, 3>> bs{{1e10f, 1e10f, 0}, {1e-12f, 1e-12f, 0}};
+  std::vector<float> angles(as.size());
+  std::vector<pair_relation> relations(as.size());
+
+  firefly::utilities::vector::angles_between(as, bs, angles);
+  firefly::utilities::vector::classify_pairs(as, bs, relations);
+  for (std::size_t i = 0; i < as.size(); ++i) {
+    ASSERT_NEAR(angles[i], std::numbers::pi_v<float> / 4, 1e-6f);
+    ASSERT_EQ(relations[i], pair_relation::none);
+  }
+}
@@ -0,0 +1,106 @@
+#include <cmath>
+#include <limits>
+
+#include "firefly/mask.hpp"
+#include "firefly/vector.hpp"
+#include "gtest/gtest.h"
+
+TEST(vector, compare__element_wise_with_vector) {
+  firefly::vector<int, 4> v1{1, 5, 3, 7};
+  firefly::vector<double, 4> v2{2, 5, 2.5, 8};
+
+  ASSERT_TRUE((std::is_same_v<decltype(v1.lt(v2)), firefly::mask<4>>));
+
+  ASSERT_TRUE((v1.lt(v2) == firefly::mask<4>{true, false, false, true}));
+  ASSERT_TRUE((v1.le(v2) == firefly::mask<4>{true, true, false, true}));
+  ASSERT_TRUE((v1.gt(v2) == firefly::mask<4>{false, false, true, false}));
+  ASSERT_TRUE((v1.ge(v2) == firefly::mask<4>{false, true, true, false}));
+  ASSERT_TRUE((v1.eq(v2) == firefly::mask<4>{false, true, false, false}));
+  ASSERT_TRUE((v1.ne(v2) == ~v1.eq(v2)));
+}
+
+TEST(vector, compare__element_wise_with_scalar) {
+  firefly::vector<float, 5> v1{-2, 0.5f, 3, 10, 0};
+  auto m = v1.gt(1);
+
+  ASSERT_TRUE((m == firefly::mask<5>{false, false, true, true, false}));
+  ASSERT_EQ(m.count(), 2);
+  ASSERT_TRUE(m.any());
+  ASSERT_FALSE(m.all());
+  ASSERT_TRUE(v1.lt(100).all());
+  ASSERT_TRUE(v1.gt(100).none());
+}
+
+TEST(vector, compare__approx_eq_absolute_tolerance) {
+  firefly::vector<double, 3> v1{1.0, 2.0, 3.0};
+  firefly::vector<double, 3> v2{1.0005, 2.1, std::numeric_limits<double>::quiet_NaN()};
+
+  ASSERT_TRUE((v1.approx_eq(v2, 1e-3) == firefly::mask<3>{true, false, false}));
+
+  firefly::vector<unsigned, 2> v3{3, 5};
+  firefly::vector<unsigned long, 2> v4{5, 3};
+  ASSERT_TRUE(v3.approx_eq(firefly::vector<unsigned, 2>{5, 3}, 10.0).all());
+  ASSERT_TRUE((v3.approx_eq(v4, 1.0) == firefly::mask<2>{false, false}));
+  ASSERT_TRUE((v4.approx_eq(firefly::vector<unsigned long, 2>{4, 4}, 1.0).all()));
+}
+
+TEST(vector, compare__approx_eq_ulp) {
+  double const one_up = std::nextafter(1.0, 2.0);
+  double const one_up_3 = std::nextafter(std::nextafter(one_up, 2.0), 2.0);
+  firefly::vector<double, 4> v1{1.0, 1.0, -0.0, -1.0};
+  firefly::vector<double, 4> v2{one_up, one_up_3, 0.0, 1.0};
+
+  ASSERT_TRUE((v1.approx_eq_ulp(v2, 1) == firefly::mask<4>{true, false, true, false}));
+  ASSERT_TRUE((v1.approx_eq_ulp(v2, 3) == firefly::mask<4>{true, true, true, false}));
+}
+
+TEST(vector, select__blends_two_vectors) {
+  firefly::vector<int, 4> v1{1, 2, 3, 4};
+  firefly::vector<double, 4> v2{-1, -2, -3, -4};
+  auto v3 = firefly::select(v1.gt(2), v1, v2);
+  auto v4 = firefly::select(v1.le(2), v1, 0);
+
+  ASSERT_TRUE((std::is_same_v<decltype(v3), firefly::vector<double, 4>>));
+
+  ASSERT_DOUBLE_EQ(v3[0], -1);
+  ASSERT_DOUBLE_EQ(v3[1], -2);
+  ASSERT_DOUBLE_EQ(v3[2], 3);
+  ASSERT_DOUBLE_EQ(v3[3], 4);
+  ASSERT_TRUE((v4 == firefly::vector<int, 4>{1, 2, 0, 0}));
+}
+
+TEST(vector, where__masked_arithmetic_clips_outliers) {
+  firefly::vector<double, 5> v1{-10, 0.5, 3, 12, -0.5};
+
+  firefly::where(v1.gt(1.0), v1) = 1.0;
+  firefly::where(v1.lt(-1.0), v1) = -1.0;
+  firefly::where(v1.lt(0.0), v1) *= 2;
+
+  ASSERT_TRUE((v1 == firefly::vector<double, 5>{-2, 0.5, 1, 1, -1}));
+}
+
+TEST(vector, where__integer_divide_skips_zero_divisors) {
+  firefly::vector<int, 4> v1{12, 7, -9, 5};
+  firefly::vector<int, 4> divisors{3, 0, 2, 0};
+  firefly::where(divisors.ne(0), v1) /= divisors;
+  ASSERT_TRUE((v1 == firefly::vector<int, 4>{4, 7, -4, 5}));
+
+  constexpr auto divided = [] {
+    firefly::vector<int, 3> v{8, 1, 6};
+    firefly::vector<int, 3> d{2, 0, 3};
+    auto w = firefly::where(d.ne(0), v);
+    w /= d;
+    return v;
+  }();
+  ASSERT_TRUE((divided == firefly::vector<int, 3>{4, 1, 2}));
+}
+
+TEST(vector, mask__logical_operators) {
+  firefly::mask<3> m1{true, true, false};
+  firefly::mask<3> m2{true, false, false};
+
+  ASSERT_TRUE(((m1 & m2) == firefly::mask<3>{true, false, false}));
+  ASSERT_TRUE(((m1 | m2) == firefly::mask<3>{true, true, false}));
+  ASSERT_TRUE(((m1 ^ m2) == firefly::mask<3>{false, true, false}));
+  ASSERT_EQ(m1.view(), "[1, 1, 0]");
+}
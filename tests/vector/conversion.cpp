@@ -0,0 +1,75 @@
+#include <complex>
+#include <cstdint>
+
+#include "firefly/vector.hpp"
+#include "gtest/gtest.h"
+
+TEST(vector, as_type__int16_to_float) {
+  firefly::vector<std::int16_t, 5> v1{-32768, -1, 0, 1, 32767};
+  auto v2 = v1.as_type<float>();
+
+  ASSERT_TRUE((std::is_same_v<decltype(v2), firefly::vector<float, 5>>));
+
+  ASSERT_FLOAT_EQ(v2[0], -32768.0f);
+  ASSERT_FLOAT_EQ(v2[1], -1.0f);
+  ASSERT_FLOAT_EQ(v2[2], 0.0f);
+  ASSERT_FLOAT_EQ(v2[3], 1.0f);
+  ASSERT_FLOAT_EQ(v2[4], 32767.0f);
+}
+
+TEST(vector, as_type__float_to_double_and_back) {
+  firefly::vector<float, 3> v1{0.5f, -1.25f, 3.0f};
+  auto v2 = v1.as_type<double>();
+  auto v3 = v2.as_type<float>();
+
+  ASSERT_TRUE((std::is_same_v<decltype(v2), firefly::vector<double, 3>>));
+
+  ASSERT_DOUBLE_EQ(v2[0], 0.5);
+  ASSERT_DOUBLE_EQ(v2[1], -1.25);
+  ASSERT_DOUBLE_EQ(v2[2], 3.0);
+  ASSERT_TRUE(v1 == v3);
+}
+
+TEST(vector, as_type__complex_to_magnitude_squared) {
+  firefly::vector<std::complex<float>, 3> v1{{1, 2}, {3, 4}, {-5, 0}};
+  auto v2 = v1.as_type<double>();
+
+  ASSERT_TRUE((std::is_same_v<decltype(v2), firefly::vector<double, 3>>));
+
+  ASSERT_DOUBLE_EQ(v2[0], 5);
+  ASSERT_DOUBLE_EQ(v2[1], 25);
+  ASSERT_DOUBLE_EQ(v2[2], 25);
+}
+
+TEST(vector, as_type__complex_to_complex_is_component_wise) {
+  firefly::vector<std::complex<int>, 2> v1{{1, 2}, {-3, 4}};
+  auto v2 = v1.as_type<std::complex<double>>();
+
+  ASSERT_TRUE((std::is_same_v<decltype(v2), firefly::vector<std::complex<double>, 2>>));
+
+  ASSERT_DOUBLE_EQ(v2[0].real(), 1);
+  ASSERT_DOUBLE_EQ(v2[0].imag(), 2);
+  ASSERT_DOUBLE_EQ(v2[1].real(), -3);
+  ASSERT_DOUBLE_EQ(v2[1].imag(), 4);
+}
+
+TEST(vector, as_type__constant_expression) {
+  constexpr firefly::vector<std::complex<int>, 2> v1{{1, 2}, {3, 4}};
+  constexpr auto v2 = v1.as_type<int>();
+
+  ASSERT_EQ(v2[0], 5);
+  ASSERT_EQ(v2[1], 25);
+}
+
+TEST(vector, add__mixed_int_and_float_converts_in_place) {
+  firefly::vector<std::int16_t, 4> v1{1, 2, 3, 4};
+  firefly::vector<float, 4> v2{0.5f, 0.25f, 0.125f, 0.0625f};
+  auto v3 = v1 + v2;
+
+  ASSERT_TRUE((std::is_same_v<decltype(v3), firefly::vector<float, 4>>));
+
+  ASSERT_FLOAT_EQ(v3[0], 1.5f);
+  ASSERT_FLOAT_EQ(v3[1], 2.25f);
+  ASSERT_FLOAT_EQ(v3[2], 3.125f);
+  ASSERT_FLOAT_EQ(v3[3], 4.0625f);
+}
@@ -0,0 +1,107 @@
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#include "firefly/detail/half.hpp"
+#include "firefly/vector.hpp"
+#include "gtest/gtest.h"
+
+TEST(vector, half__float16_bits_roundtrip) {
+  using firefly::detail::float16_bits_to_float;
+  using firefly::detail::float_to_float16_bits;
+
+  ASSERT_EQ(float_to_float16_bits(1.0f), 0x3C00);
+  ASSERT_EQ(float_to_float16_bits(-2.0f), 0xC000);
+  ASSERT_EQ(float_to_float16_bits(65504.0f), 0x7BFF);
+  ASSERT_EQ(float_to_float16_bits(65520.0f), 0x7C00);
+  ASSERT_EQ(float_to_float16_bits(std::ldexp(1.0f, -24)), 0x0001);
+  ASSERT_EQ(float_to_float16_bits(std::ldexp(1.0f, -25)), 0x0000);
+  ASSERT_EQ(float_to_float16_bits(std::ldexp(3.0f, -25)), 0x0002);
+  ASSERT_EQ(float_to_float16_bits(std::numeric_limits<float>::quiet_NaN()), 0x7E00);
+
+  ASSERT_FLOAT_EQ(float16_bits_to_float(0x3555), 0.333251953125f);
+  ASSERT_FLOAT_EQ(float16_bits_to_float(0x0001), std::ldexp(1.0f, -24));
+  ASSERT_TRUE(std::isinf(float16_bits_to_float(0xFC00)));
+  ASSERT_TRUE(std::isnan(float16_bits_to_float(0x7E00)));
+
+  for (std::uint32_t bits = 0; bits < 0x7C00; ++bits) {
+    ASSERT_EQ(float_to_float16_bits(float16_bits_to_float(std::uint16_t(bits))), bits);
+  }
+}
+
+TEST(vector, half__bfloat16_bits_rounding) {
+  using firefly::detail::bfloat16_bits_to_float;
+  using firefly::detail::float_to_bfloat16_bits;
+
+  static_assert(float_to_bfloat16_bits(1.0f) == 0x3F80);
+  ASSERT_EQ(float_to_bfloat16_bits(1.0f + std::ldexp(1.0f, -8)), 0x3F80);
+  ASSERT_EQ(float_to_bfloat16_bits(1.0f + std::ldexp(3.0f, -8)), 0x3F82);
+  ASSERT_FLOAT_EQ(bfloat16_bits_to_float(0xC040), -3.0f);
+  ASSERT_TRUE(std::isnan(bfloat16_bits_to_float(float_to_bfloat16_bits(std::numeric_limits<float>::quiet_NaN()))));
+}
+
+TEST(vector, half__software_path_accumulates_in_float) {
+  using firefly::detail::bfloat16_bits_to_float;
+  using firefly::detail::float16_bits_to_float;
+  using firefly::detail::float_to_bfloat16_bits;
+  using firefly::detail::float_to_float16_bits;
+
+  for (std::uint32_t bits = 0; bits < 0x10000; ++bits) {
+    if ((bits & 0x7F80) != 0x7F80) {
+      ASSERT_EQ(float_to_bfloat16_bits(bfloat16_bits_to_float(std::uint16_t(bits))), bits);
+    }
+  }
+
+  // The squared norm of {300, 400} as a half vector: widened elements are exact and their float sum is too, while
+  // rounding it back to binary16 would overflow.
+  float const x = float16_bits_to_float(float_to_float16_bits(300.0f));
+  float const y = float16_bits_to_float(float_to_float16_bits(400.0f));
+  float const squared = x * x + y * y;
+  ASSERT_EQ(squared, 250000.0f);
+  ASSERT_EQ(float_to_float16_bits(squared), 0x7C00);
+  ASSERT_EQ(float16_bits_to_float(float_to_float16_bits(std::sqrt(squared))), 500.0f);
+}
+
+#ifdef FIREFLY_HAS_FLOAT16
+TEST(vector, half__float16_reductions_return_float) {
+  firefly::vector<std::float16_t, 2> v1{300.0f16, 400.0f16};
+
+  ASSERT_TRUE((std::is_same_v<decltype(v1.squared_norm()), float>));
+  ASSERT_EQ(v1.squared_norm(), 250000.0f);
+  ASSERT_EQ(v1.norm(), 500.0f);
+  ASSERT_EQ(v1.dot(v1), 250000.0f);
+  ASSERT_EQ(v1.product(), 120000.0f);
+  ASSERT_EQ(v1.l1_norm(), 700.0f);
+
+  auto const v2 = v1.to_normalized();
+  ASSERT_TRUE((std::is_same_v<decltype(v2), firefly::vector<std::float16_t, 2> const>));
+  ASSERT_NEAR(float(v2[0]), 0.6f, 1e-3f);
+  ASSERT_NEAR(float(v2[1]), 0.8f, 1e-3f);
+}
+
+TEST(vector, half__float16_storage_computes_in_float) {
+  firefly::vector<std::float16_t, 4> v1{1.0f16, 2.0f16, 3.0f16, 4.0f16};
+  firefly::vector<float, 4> v2{0.5f, 0.5f, 0.5f, 0.5f};
+
+  auto v3 = v1 + v2;
+  ASSERT_TRUE((std::is_same_v<decltype(v3), firefly::vector<float, 4>>));
+  ASSERT_EQ(v3, (firefly::vector<float, 4>{1.5f, 2.5f, 3.5f, 4.5f}));
+
+  auto v4 = v1.scale(2.0f16);
+  ASSERT_TRUE((std::is_same_v<decltype(v4), firefly::vector<std::float16_t, 4>>));
+  ASSERT_EQ(float(v4[3]), 8.0f);
+  ASSERT_EQ(float(v1.sum()), 10.0f);
+  ASSERT_EQ(v1.as_type<float>(), (firefly::vector<float, 4>{1, 2, 3, 4}));
+}
+#endif
+
+#if defined(FIREFLY_HAS_FLOAT16) && defined(FIREFLY_HAS_BFLOAT16)
+TEST(vector, half__mixed_half_types_promote_to_float) {
+  firefly::vector<std::float16_t, 2> v1{1.0f16, 2.0f16};
+  firefly::vector<std::bfloat16_t, 2> v2{1.0bf16, 1.0bf16};
+
+  auto v3 = v1 + v2;
+  ASSERT_TRUE((std::is_same_v<decltype(v3), firefly::vector<float, 2>>));
+  ASSERT_EQ(v3, (firefly::vector<float, 2>{2.0f, 3.0f}));
+}
+#endif
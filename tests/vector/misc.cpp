@@ -101,4 +101,14 @@ TEST(firefly, misc__common_type_returns_appropriate_types) {
   ASSERT_TRUE(
       (std::is_same_v<firefly::common_type_t<std::complex<float>, std::complex<double>>, std::complex<double>>));
   ASSERT_TRUE((std::is_same_v<firefly::common_type_t<int, double>, double>));
-}
\ No newline at end of file
+}
+
+TEST(vector, misc__norm_and_to_normalized_are_constant_expressions) {
+  constexpr firefly::vector<int, 2> v1{3, 4};
+  constexpr auto norm = v1.norm();
+  constexpr auto v2 = v1.to_normalized();
+
+  ASSERT_DOUBLE_EQ(norm, 5);
+  ASSERT_DOUBLE_EQ(v2[0], 0.6);
+  ASSERT_DOUBLE_EQ(v2[1], 0.8);
+}
@@ -0,0 +1,74 @@
+#include <cmath>
+#include <complex>
+#include <limits>
+
+#include "firefly/vector.hpp"
+#include "gtest/gtest.h"
+
+TEST(vector, reduction__sum_and_product) {
+  firefly::vector<int, 7> v1{1, 2, 3, 4, 5, 6, 7};
+
+  ASSERT_TRUE((std::is_same_v<decltype(v1.sum()), int>));
+
+  ASSERT_EQ(v1.sum(), 28);
+  ASSERT_EQ(v1.product(), 5040);
+}
+
+TEST(vector, reduction__sum_of_complex) {
+  firefly::vector<std::complex<double>, 3> v1{{1, 2}, {3, 4}, {5, 6}};
+
+  ASSERT_DOUBLE_EQ(v1.sum().real(), 9);
+  ASSERT_DOUBLE_EQ(v1.sum().imag(), 12);
+}
+
+TEST(vector, reduction__min_max_and_arg) {
+  firefly::vector<double, 9> v1{3, -1, 4, 1, -5, 9, 2, 9, -5};
+
+  ASSERT_DOUBLE_EQ(v1.min(), -5);
+  ASSERT_DOUBLE_EQ(v1.max(), 9);
+  ASSERT_EQ(v1.argmin(), 4);
+  ASSERT_EQ(v1.argmax(), 5);
+}
+
+TEST(vector, reduction__nan_propagates) {
+  auto const nan = std::numeric_limits<double>::quiet_NaN();
+  firefly::vector<double, 6> v1{1, 2, 3, 4, nan, nan};
+  firefly::vector<double, 6> v2{nan, 2, 3, 4, 5, 6};
+
+  ASSERT_TRUE(std::isnan(v1.min()));
+  ASSERT_TRUE(std::isnan(v1.max()));
+  ASSERT_TRUE(std::isnan(v2.min()));
+  ASSERT_TRUE(std::isnan(v2.linf_norm()));
+  ASSERT_EQ(v1.argmin(), 4);
+  ASSERT_EQ(v1.argmax(), 4);
+  ASSERT_EQ(v2.argmax(), 0);
+}
+
+TEST(vector, reduction__norms) {
+  firefly::vector<int, 5> v1{3, -4, 0, 12, -1};
+
+  ASSERT_EQ(v1.squared_norm(), 170);
+  ASSERT_EQ(v1.l1_norm(), 20);
+  ASSERT_EQ(v1.linf_norm(), 12);
+  ASSERT_DOUBLE_EQ(v1.lp_norm<1>(), 20);
+  ASSERT_DOUBLE_EQ(v1.lp_norm<2>(), std::sqrt(170.0));
+  ASSERT_NEAR(v1.lp_norm<3>(), std::cbrt(27.0 + 64 + 1728 + 1), 1e-12);
+}
+
+TEST(vector, reduction__norms_of_complex) {
+  firefly::vector<std::complex<double>, 2> v1{{3, 4}, {0, -1}};
+
+  ASSERT_DOUBLE_EQ(v1.squared_norm(), 26);
+  ASSERT_DOUBLE_EQ(v1.l1_norm(), 6);
+  ASSERT_DOUBLE_EQ(v1.linf_norm(), 5);
+}
+
+TEST(vector, reduction__constant_expression) {
+  constexpr firefly::vector<int, 5> v1{5, -3, 8, 8, 1};
+
+  static_assert(v1.sum() == 19);
+  static_assert(v1.min() == -3);
+  static_assert(v1.argmax() == 2);
+  static_assert(v1.l1_norm() == 25);
+  ASSERT_EQ(v1.argmin(), 1);
+}
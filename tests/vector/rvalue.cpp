@@ -0,0 +1,68 @@
+#include <utility>
+
+#include "firefly/utilities.hpp"
+#include "firefly/vector.hpp"
+#include "gtest/gtest.h"
+
+TEST(vector, rvalue__add_with_expiring_operand) {
+  firefly::vector<double, 3> v1{1, 2, 3};
+  firefly::vector<double, 3> v2{4, 5, 6};
+  auto v3 = std::move(v1).add(v2);
+
+  ASSERT_TRUE((std::is_same_v<decltype(v3), firefly::vector<double, 3>>));
+
+  ASSERT_DOUBLE_EQ(v3[0], 5);
+  ASSERT_DOUBLE_EQ(v3[1], 7);
+  ASSERT_DOUBLE_EQ(v3[2], 9);
+}
+
+TEST(vector, rvalue__add_promotes_when_type_does_not_match) {
+  firefly::vector<int, 3> v1{1, 2, 3};
+  auto v2 = std::move(v1) + 0.5;
+
+  ASSERT_TRUE((std::is_same_v<decltype(v2), firefly::vector<double, 3>>));
+
+  ASSERT_DOUBLE_EQ(v2[0], 1.5);
+  ASSERT_DOUBLE_EQ(v2[1], 2.5);
+  ASSERT_DOUBLE_EQ(v2[2], 3.5);
+}
+
+TEST(vector, rvalue__chained_expression) {
+  firefly::vector<double, 3> a{1, 2, 3};
+  firefly::vector<double, 3> b{3, 2, 1};
+  firefly::vector<double, 3> c{1, 1, 1};
+  auto result = -((a + b) * 2.0 - c) / 2.0;
+
+  ASSERT_TRUE((std::is_same_v<decltype(result), firefly::vector<double, 3>>));
+
+  ASSERT_DOUBLE_EQ(result[0], -3.5);
+  ASSERT_DOUBLE_EQ(result[1], -3.5);
+  ASSERT_DOUBLE_EQ(result[2], -3.5);
+}
+
+TEST(vector, rvalue__scalar_on_left_with_expiring_vector) {
+  firefly::vector<std::complex<double>, 2> v1{{1, 2}, {3, 4}};
+  auto v2 = 2.0 * (v1 + v1);
+
+  ASSERT_TRUE((std::is_same_v<decltype(v2), firefly::vector<std::complex<double>, 2>>));
+
+  ASSERT_DOUBLE_EQ(v2[0].real(), 4);
+  ASSERT_DOUBLE_EQ(v2[0].imag(), 8);
+  ASSERT_DOUBLE_EQ(v2[1].real(), 12);
+  ASSERT_DOUBLE_EQ(v2[1].imag(), 16);
+}
+
+TEST(vector, rvalue__utilities_match_lvalue_results) {
+  firefly::vector<double, 2> v1{1, 2};
+  firefly::vector<double, 2> v2{3, 4};
+
+  auto rejected = firefly::utilities::vector::rejection(firefly::vector<double, 2>{1, 2}, v2);
+  auto projected = firefly::utilities::vector::projection(v1, firefly::vector<double, 2>{3, 4});
+  auto lerped = firefly::utilities::vector::lerp(firefly::vector<double, 2>{1, 2}, v2, 0.25);
+  auto distance = firefly::utilities::vector::distance(firefly::vector<double, 2>{1, 2}, v2);
+
+  ASSERT_TRUE(rejected == firefly::utilities::vector::rejection(v1, v2));
+  ASSERT_TRUE(projected == firefly::utilities::vector::projection(v1, v2));
+  ASSERT_TRUE(lerped == firefly::utilities::vector::lerp(v1, v2, 0.25));
+  ASSERT_DOUBLE_EQ(distance, firefly::utilities::vector::distance(v1, v2));
+}